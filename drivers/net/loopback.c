@@ -104,6 +104,112 @@ int loopback_get_num_dropped_packets(void)
 
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+#define DELAY_QUEUE_LEN CONFIG_NET_LOOPBACK_SIMULATE_DELAY_QUEUE
+
+/* The delay is the same for every packet, so they are due in the
+ * order they were sent and a simple ring is enough.
+ */
+static struct {
+	struct net_pkt *pkt;
+	int64_t due;
+} loopback_delay_queue[DELAY_QUEUE_LEN];
+
+static struct k_spinlock loopback_delay_lock;
+static unsigned int loopback_delay_head;
+static unsigned int loopback_delay_count;
+static int loopback_delay_ms;
+
+static void loopback_delay_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(loopback_delay_work, loopback_delay_work_handler);
+
+int loopback_set_delay(int delay_ms)
+{
+	if (delay_ms < 0) {
+		return -EINVAL;
+	}
+
+	loopback_delay_ms = delay_ms;
+	return 0;
+}
+
+static void loopback_delay_work_handler(struct k_work *work)
+{
+	struct net_pkt *pkt;
+	k_spinlock_key_t key;
+	int64_t now;
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		key = k_spin_lock(&loopback_delay_lock);
+
+		if (loopback_delay_count == 0) {
+			k_spin_unlock(&loopback_delay_lock, key);
+			break;
+		}
+
+		now = k_uptime_get();
+		if (loopback_delay_queue[loopback_delay_head].due > now) {
+			k_work_reschedule(&loopback_delay_work,
+					  K_MSEC(loopback_delay_queue[loopback_delay_head].due -
+						 now));
+			k_spin_unlock(&loopback_delay_lock, key);
+			break;
+		}
+
+		pkt = loopback_delay_queue[loopback_delay_head].pkt;
+		loopback_delay_head = (loopback_delay_head + 1) % DELAY_QUEUE_LEN;
+		loopback_delay_count--;
+
+		k_spin_unlock(&loopback_delay_lock, key);
+
+		if (net_recv_data(net_pkt_iface(pkt), pkt) < 0) {
+			LOG_ERR("Data receive failed.");
+			net_pkt_unref(pkt);
+		}
+	}
+}
+
+/* Packets still in the ring when the delay is lowered or disabled are
+ * received first, so that changing the delay does not reorder them.
+ */
+static int loopback_delay_pkt(struct net_pkt *pkt)
+{
+	k_spinlock_key_t key;
+	unsigned int tail;
+	int64_t due;
+
+	key = k_spin_lock(&loopback_delay_lock);
+
+	if (loopback_delay_count == 0) {
+		if (loopback_delay_ms == 0) {
+			k_spin_unlock(&loopback_delay_lock, key);
+			return -EAGAIN;
+		}
+
+		due = k_uptime_get() + loopback_delay_ms;
+		k_work_reschedule(&loopback_delay_work, K_MSEC(loopback_delay_ms));
+	} else if (loopback_delay_count == DELAY_QUEUE_LEN) {
+		k_spin_unlock(&loopback_delay_lock, key);
+		return -ENOBUFS;
+	} else {
+		tail = (loopback_delay_head + loopback_delay_count - 1) % DELAY_QUEUE_LEN;
+		due = MAX(k_uptime_get() + loopback_delay_ms,
+			  loopback_delay_queue[tail].due);
+	}
+
+	tail = (loopback_delay_head + loopback_delay_count) % DELAY_QUEUE_LEN;
+	loopback_delay_queue[tail].pkt = pkt;
+	loopback_delay_queue[tail].due = due;
+	loopback_delay_count++;
+
+	k_spin_unlock(&loopback_delay_lock, key);
+
+	return 0;
+}
+#endif
+
 static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct net_pkt *cloned;
@@ -160,6 +266,19 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 		}
 	}
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+	res = loopback_delay_pkt(cloned);
+	if (res != -EAGAIN) {
+		if (res < 0) {
+			/* Queue full, behave like a congested link */
+			net_pkt_unref(cloned);
+			res = 0;
+		}
+
+		goto out;
+	}
+#endif
+
 	res = net_recv_data(net_pkt_iface(cloned), cloned);
 	if (res < 0) {
 		LOG_ERR("Data receive failed.");
@@ -961,6 +961,46 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+/**
+ * @brief Reserve CPU time for a deadline scheduled thread
+ *
+ * This grants @a thread a budget of @a runtime_us microseconds of CPU
+ * time every @a period_us microseconds.  From then on the kernel
+ * manages the deadline of the thread itself: when the thread becomes
+ * runnable it is given a deadline one period ahead (unless its
+ * remaining budget can still be consumed by the current deadline),
+ * and each time it exhausts its budget the deadline is postponed by
+ * one period and the budget replenished.  A thread overrunning its
+ * budget therefore only delays itself, not the other reserved
+ * threads.  Budget exhaustions are counted in the @a overruns field
+ * of k_thread_runtime_stats_t.
+ *
+ * Admission control refuses the reservation if the sum of the
+ * runtime to period ratios of all reservations would exceed
+ * @kconfig{CONFIG_SCHED_DEADLINE_RESERVATION_MAX_UTILIZATION}.
+ *
+ * @note As with k_thread_deadline_set(), deadlines only order
+ * threads at the same static priority, so reserved threads should
+ * share a single preemptible priority.  The budget is accounted in
+ * ticks and enforced using the time slicing machinery.
+ *
+ * @note Calling k_thread_deadline_set() on a reserved thread only
+ * lasts until the kernel next updates its deadline.
+ *
+ * @param thread Thread to reserve CPU time for
+ * @param runtime_us Budget per period, in microseconds. Zero releases
+ *                   the reservation of the thread.
+ * @param period_us Period, in microseconds
+ *
+ * @retval 0 Reservation set or released
+ * @retval -EINVAL @a runtime_us is larger than @a period_us
+ * @retval -EBUSY Not enough CPU time left to admit the reservation
+ */
+__syscall int k_thread_reservation_set(k_tid_t thread, uint32_t runtime_us,
+				       uint32_t period_us);
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
+
 /**
  * @brief Invoke the scheduler
  *
@@ -2173,6 +2213,30 @@ int k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list);
  */
 __syscall void *k_queue_get(struct k_queue *queue, k_timeout_t timeout);
 
+/**
+ * @brief Get several elements from a queue.
+ *
+ * This routine removes up to @a max data items from the head of @a queue
+ * with a single acquisition of the queue lock. It waits for a data item to
+ * become available only if the queue is empty. The first word of each data
+ * item is reserved for the kernel's use.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue Address of the queue.
+ * @param data Array receiving the addresses of the data items.
+ * @param max Size of the @a data array.
+ * @param timeout Waiting period to obtain a data item, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of data items stored in @a data; 0 if returned without
+ * waiting, waiting period timed out or waiting was cancelled.
+ */
+__syscall int k_queue_get_many(struct k_queue *queue, void **data, uint32_t max,
+			       k_timeout_t timeout);
+
 /**
  * @brief Remove an element from a queue.
  *
@@ -2707,6 +2771,35 @@ struct k_fifo {
 	fg_ret; \
 	})
 
+/**
+ * @brief Get several elements from a FIFO queue.
+ *
+ * This routine removes up to @a max data items from @a fifo in a "first in,
+ * first out" manner, with a single acquisition of the FIFO lock. It waits
+ * for a data item to become available only if the FIFO is empty. The first
+ * word of each data item is reserved for the kernel's use.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param fifo Address of the FIFO queue.
+ * @param data Array receiving the addresses of the data items.
+ * @param max Size of the @a data array.
+ * @param timeout Waiting period to obtain a data item,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of data items stored in @a data; 0 if returned without
+ * waiting, or waiting period timed out.
+ */
+#define k_fifo_get_batch(fifo, data, max, timeout) \
+	({ \
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_fifo, get_batch, fifo, timeout); \
+	int fgb_ret = k_queue_get_many(&(fifo)->_queue, data, max, timeout); \
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_fifo, get_batch, fifo, timeout, fgb_ret); \
+	fgb_ret; \
+	})
+
 /**
  * @brief Query a FIFO queue to see if it has data available.
  *
@@ -3422,6 +3515,7 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 
 struct k_work_delayable;
 struct k_work_sync;
+struct k_work_pool;
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -3714,6 +3808,65 @@ int k_work_queue_unplug(struct k_work_q *queue);
  */
 int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout);
 
+/** @brief Start the work queues of a work pool.
+ *
+ * This starts one thread per work queue of the pool, defined with
+ * K_WORK_POOL_DEFINE().  When CONFIG_SCHED_CPU_MASK is enabled, the thread of
+ * the queue with index @em i is pinned to CPU @em i modulo the number of CPUs.
+ *
+ * Each queue of the pool is a regular work queue.  A thread of the pool that
+ * runs out of work takes work items still pending on the other queues of the
+ * pool before going to sleep, so that bursts of work submitted from one CPU
+ * are spread across all threads of the pool.
+ *
+ * The queues of a work pool must not be stopped.
+ *
+ * @param pool pointer to the work pool.
+ *
+ * @param prio initial priority of the threads of the pool.
+ *
+ * @param cfg optional additional configuration parameters applied to every
+ * queue of the pool.  Pass @c NULL if not required, to use the defaults
+ * documented in k_work_queue_config.
+ */
+void k_work_pool_start(struct k_work_pool *pool, int prio,
+		       const struct k_work_queue_config *cfg);
+
+/** @brief Submit a work item to a work pool.
+ *
+ * The work item is submitted to the queue of the pool associated with the
+ * current CPU, and an idle thread of the pool is woken up if that queue is
+ * busy.  The work item is otherwise handled as by k_work_submit_to_queue(),
+ * and it can be flushed and cancelled with the regular work item API.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the work pool.
+ *
+ * @param work pointer to the work item.
+ *
+ * @return as k_work_submit_to_queue().
+ */
+int k_work_pool_submit(struct k_work_pool *pool, struct k_work *work);
+
+/** @brief Schedule a delayable work item on a work pool.
+ *
+ * Equivalent to k_work_schedule_for_queue() on the queue of the pool
+ * associated with the current CPU.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the work pool.
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param delay the time to wait before submitting the work item.
+ *
+ * @return as k_work_schedule_for_queue().
+ */
+int k_work_pool_schedule(struct k_work_pool *pool,
+			 struct k_work_delayable *dwork, k_timeout_t delay);
+
 /** @brief Initialize a delayable work structure.
  *
  * This must be invoked before scheduling a delayable work structure for the
@@ -4025,6 +4178,8 @@ enum {
 	K_WORK_QUEUE_PLUGGED = BIT(K_WORK_QUEUE_PLUGGED_BIT),
 	K_WORK_QUEUE_STOP_BIT = 4,
 	K_WORK_QUEUE_STOP = BIT(K_WORK_QUEUE_STOP_BIT),
+	K_WORK_QUEUE_STEAL_BIT = 5,
+	K_WORK_QUEUE_STEAL = BIT(K_WORK_QUEUE_STEAL_BIT),
 
 	/* Static work queue flags */
 	K_WORK_QUEUE_NO_YIELD_BIT = 8,
@@ -4241,9 +4396,10 @@ struct k_work_q {
 	 */
 	k_tid_t thread_id;
 
-	/* All the following fields must be accessed only while the
-	 * work module spinlock is held.
+	/* Lock protecting the following fields, and the state of the
+	 * work items last submitted to this queue.
 	 */
+	struct k_spinlock lock;
 
 	/* List of k_work items to be worked. */
 	sys_slist_t pending;
@@ -4262,8 +4418,52 @@ struct k_work_q {
 	struct k_work *work;
 	k_timeout_t work_timeout;
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
+
+#if defined(CONFIG_WORKQUEUE_POOL)
+	/* Work pool this queue belongs to, if any. */
+	struct k_work_pool *pool;
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+};
+
+/** @brief A set of work queues sharing pending work between their threads. */
+struct k_work_pool {
+	/* The work queues of the pool. */
+	struct k_work_q *queues;
+
+	/* Stacks of the work queue threads, stack_stride bytes apart. */
+	k_thread_stack_t *stacks;
+	size_t stack_size;
+	size_t stack_stride;
+
+	/* Number of work queues in the pool. */
+	uint32_t num_queues;
+
+	/* Bitmask of the queues whose thread is idle. */
+	atomic_t idle;
 };
 
+/**
+ * @brief Statically define a work pool.
+ *
+ * The pool must then be started with k_work_pool_start().
+ *
+ * @param name Symbol name for the work pool object.
+ * @param n Number of work queues and threads in the pool, at most 32.
+ * @param stack_size Size of the stack of each thread of the pool.
+ */
+#define K_WORK_POOL_DEFINE(name, n, stack_size)				\
+	BUILD_ASSERT(((n) > 0) && ((n) <= ATOMIC_BITS));		\
+	static K_THREAD_STACK_ARRAY_DEFINE(_k_work_pool_stacks_##name,	\
+					   n, stack_size);		\
+	static struct k_work_q _k_work_pool_queues_##name[n];		\
+	struct k_work_pool name = {					\
+		.queues = _k_work_pool_queues_##name,			\
+		.stacks = (k_thread_stack_t *)_k_work_pool_stacks_##name, \
+		.stack_size = K_THREAD_STACK_SIZEOF(_k_work_pool_stacks_##name[0]), \
+		.stack_stride = sizeof(_k_work_pool_stacks_##name[0]),	\
+		.num_queues = (n),					\
+	}
+
 /* Provide the implementation for inline functions declared above */
 
 static inline bool k_work_is_pending(const struct k_work *work)
@@ -4662,6 +4862,20 @@ struct k_msgq {
 	/** Message queue */
 	uint8_t flags;
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	/** Lock-free ring state, only used by lock-free message queues */
+	struct {
+		/** Position of the next message to get */
+		atomic_t head;
+		/** Position of the next message to put */
+		atomic_t tail;
+		/** Number of threads blocked on the queue */
+		atomic_t waiters;
+		/** Per-slot sequence numbers */
+		atomic_t *seq;
+	} ring;
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_msgq)
 
 #ifdef CONFIG_OBJ_CORE_MSGQ
@@ -4688,6 +4902,24 @@ struct k_msgq {
 	.flags = 0, \
 	}
 
+#define Z_MSGQ_LOCKFREE_INITIALIZER(obj, q_buffer, q_seq, q_msg_size, q_max_msgs, q_flags) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.lock = {}, \
+	.msg_size = q_msg_size, \
+	.max_msgs = q_max_msgs, \
+	.buffer_start = q_buffer, \
+	.buffer_end = q_buffer + (q_max_msgs * q_msg_size), \
+	.read_ptr = q_buffer, \
+	.write_ptr = q_buffer, \
+	.used_msgs = 0, \
+	Z_POLL_EVENT_OBJ_INIT(obj) \
+	.flags = q_flags, \
+	.ring = { \
+		.seq = q_seq, \
+	}, \
+	}
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -4695,6 +4927,16 @@ struct k_msgq {
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
 
+/** Lock-free message queue with a single producer and a single consumer */
+#define K_MSGQ_FLAG_SPSC	BIT(1)
+
+/** Lock-free message queue with multiple producers and consumers */
+#define K_MSGQ_FLAG_MPMC	BIT(2)
+
+/** @cond INTERNAL_HIDDEN */
+#define K_MSGQ_FLAG_LOCKFREE	(K_MSGQ_FLAG_SPSC | K_MSGQ_FLAG_MPMC)
+/** @endcond */
+
 /**
  * @brief Message Queue Attributes
  */
@@ -4733,6 +4975,52 @@ struct k_msgq_attrs {
 	       Z_MSGQ_INITIALIZER(q_name, _k_fifo_buf_##q_name,	\
 				  (q_msg_size), (q_max_msgs))
 
+/**
+ * @brief Statically define and initialize a lock-free message queue.
+ *
+ * This is the same as K_MSGQ_DEFINE(), except that messages are put in
+ * and got from the ring buffer using atomic operations rather than the
+ * message queue lock. The wait queue is only involved when a thread
+ * has to block because the queue is full or empty, or when such a
+ * thread has to be woken up.
+ *
+ * With @ref K_MSGQ_FLAG_SPSC, at most one thread or ISR may put messages
+ * at any time, and at most one may get messages. @ref K_MSGQ_FLAG_MPMC
+ * lifts that restriction at the cost of a compare-and-swap per
+ * operation.
+ *
+ * Lock-free message queues have a few restrictions:
+ *
+ * - @a q_max_msgs must be a power of two;
+ * - k_msgq_put_front(), k_msgq_peek() and k_msgq_peek_at() are not
+ *   supported and return -ENOTSUP;
+ * - they can't be used with k_poll();
+ * - k_msgq_purge() discards the queued messages, but threads blocked
+ *   putting messages are woken up to retry rather than failing.
+ *
+ * @note You should enable @kconfig{CONFIG_MSGQ_LOCKFREE} in your project
+ * configuration.
+ *
+ * @param q_name Name of the message queue.
+ * @param q_msg_size Message size (in bytes).
+ * @param q_max_msgs Maximum number of messages that can be queued.
+ * @param q_align Alignment of the message queue's ring buffer (power of 2).
+ * @param q_flags @ref K_MSGQ_FLAG_SPSC or @ref K_MSGQ_FLAG_MPMC.
+ */
+#define K_MSGQ_DEFINE_LOCKFREE(q_name, q_msg_size, q_max_msgs, q_align, q_flags) \
+	BUILD_ASSERT(IS_POWER_OF_TWO(q_max_msgs),			\
+		     "lock-free message queue length must be a power of two"); \
+	BUILD_ASSERT(((q_flags) == K_MSGQ_FLAG_SPSC) ||			\
+		     ((q_flags) == K_MSGQ_FLAG_MPMC),			\
+		     "invalid lock-free message queue flags");		\
+	static char __noinit __aligned(q_align)				\
+		_k_fifo_buf_##q_name[(q_max_msgs) * (q_msg_size)];	\
+	static atomic_t _k_msgq_seq_##q_name[(q_max_msgs)];		\
+	STRUCT_SECTION_ITERABLE(k_msgq, q_name) =			\
+	       Z_MSGQ_LOCKFREE_INITIALIZER(q_name, _k_fifo_buf_##q_name, \
+					   _k_msgq_seq_##q_name,	\
+					   (q_msg_size), (q_max_msgs), (q_flags))
+
 /**
  * @brief Initialize a message queue.
  *
@@ -4830,6 +5118,7 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -ENOTSUP Not supported by lock-free message queues.
  */
 __syscall int k_msgq_put_front(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 
@@ -4855,6 +5144,59 @@ __syscall int k_msgq_put_front(struct k_msgq *msgq, const void *data, k_timeout_
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to the end of a message queue.
+ *
+ * This routine sends up to @a num messages, stored contiguously at
+ * @a data, to message queue @a msgq with a single acquisition of the queue
+ * lock and at most one reschedule. Messages that fit are queued, or handed
+ * to waiting receivers, without waiting. Only when the queue is full does
+ * the routine wait for room for the first message.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num Number of messages at @a data.
+ * @param timeout Waiting period to add a message when the queue is full,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages sent, which may be less than @a num;
+ *         -ENOMSG if returned without waiting or queue purged;
+ *         -EAGAIN if waiting period timed out.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data, uint32_t num,
+			      k_timeout_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num messages from message queue @a msgq
+ * in a "first in, first out" manner, with a single acquisition of the
+ * queue lock and at most one reschedule. It waits for a message only when
+ * the queue is empty.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold the received messages, large enough
+ *             for @a num messages.
+ * @param num Maximum number of messages to receive.
+ * @param timeout Waiting period to receive a message when the queue is
+ *                empty, or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received, which may be less than @a num;
+ *         -ENOMSG if returned without waiting or queue purged;
+ *         -EAGAIN if waiting period timed out.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data, uint32_t num,
+			      k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4868,6 +5210,7 @@ __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
  *
  * @retval 0 Message read.
  * @retval -ENOMSG Returned when the queue has no message.
+ * @retval -ENOTSUP Not supported by lock-free message queues.
  */
 __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
 
@@ -4886,6 +5229,7 @@ __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
  *
  * @retval 0 Message read.
  * @retval -ENOMSG Returned when the queue has no message at index.
+ * @retval -ENOTSUP Not supported by lock-free message queues.
  */
 __syscall int k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx);
 
@@ -4924,9 +5268,33 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 				 struct k_msgq_attrs *attrs);
 
 
+/** @cond INTERNAL_HIDDEN */
+static inline uint32_t z_msgq_used_msgs(struct k_msgq *msgq)
+{
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if ((msgq->flags & K_MSGQ_FLAG_LOCKFREE) != 0U) {
+		/* Read head before tail (atomic_get() orders the loads), so
+		 * a get racing with us cannot move head past the tail we
+		 * use. A "negative" difference still means empty, not full.
+		 */
+		atomic_val_t head = atomic_get(&msgq->ring.head);
+		atomic_val_t tail = atomic_get(&msgq->ring.tail);
+		int32_t used = (int32_t)((uint32_t)tail - (uint32_t)head);
+
+		if (used < 0) {
+			return 0;
+		}
+
+		return MIN((uint32_t)used, msgq->max_msgs);
+	}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+	return msgq->used_msgs;
+}
+/** @endcond */
+
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	return msgq->max_msgs - z_msgq_used_msgs(msgq);
 }
 
 /**
@@ -4942,7 +5310,7 @@ __syscall uint32_t k_msgq_num_used_get(struct k_msgq *msgq);
 
 static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 {
-	return msgq->used_msgs;
+	return z_msgq_used_msgs(msgq);
 }
 
 /** @} */
@@ -5446,7 +5814,22 @@ struct k_mem_slab_info {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Allocations and frees served by, or missing, the per-CPU caches */
+	uint32_t cache_hits;
+	uint32_t cache_misses;
+#endif
+};
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+struct k_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+	uint32_t hits;
+	uint32_t misses;
 };
+#endif
 
 struct k_mem_slab {
 	_wait_q_t wait_q;
@@ -5455,6 +5838,13 @@ struct k_mem_slab {
 	char *free_list;
 	struct k_mem_slab_info info;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Free blocks cached per CPU, counted in info.num_used */
+	struct k_mem_slab_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+	/* Set while threads may wait for a block, frees then skip the caches */
+	bool cache_bypass;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
@@ -5650,6 +6040,24 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
 
+/** @cond INTERNAL_HIDDEN */
+static inline uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	uint32_t cached = 0U;
+
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		cached += slab->cpu_cache[i].count;
+	}
+
+	return cached;
+#else
+	ARG_UNUSED(slab);
+	return 0U;
+#endif
+}
+/** @endcond */
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -5662,7 +6070,7 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_used;
+	return slab->info.num_used - z_mem_slab_num_cached(slab);
 }
 
 /**
@@ -5697,7 +6105,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -54,6 +54,23 @@ struct _pipe_desc {
 	struct k_thread *thread;         /* Back pointer to pended thread */
 };
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+/* CPU time reservation of a deadline scheduled thread */
+struct z_thread_reservation {
+	/* Budget granted every period, zero if there is no reservation */
+	k_ticks_t runtime;
+	k_ticks_t period;
+	/* Budget left until the current deadline */
+	k_ticks_t budget;
+	/* Absolute deadline, in ticks */
+	k_ticks_t deadline;
+	/* runtime / period, in parts per million */
+	uint32_t util;
+	/* Number of budget exhaustions */
+	uint32_t overruns;
+};
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
+
 /* can be used for creating 'dummy' threads, e.g. for pending on objects */
 struct _thread_base {
 
@@ -144,6 +161,11 @@ struct _thread_base {
 	void *slice_data;
 #endif /* CONFIG_TIMESLICE_PER_THREAD */
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+	/* CPU time reservation, see k_thread_reservation_set() */
+	struct z_thread_reservation reservation;
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
+
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif /* CONFIG_SCHED_THREAD_USAGE */
@@ -240,8 +262,17 @@ typedef struct k_thread_runtime_stats {
 	uint64_t idle_cycles;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+	/*
+	 * Number of times the thread exhausted the budget of its CPU time
+	 * reservation. Always zero for CPUs.
+	 */
+	uint32_t overruns;
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
+
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
-	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL) && \
+	!defined(CONFIG_SCHED_DEADLINE_RESERVATION)
 	/* If none of the above Kconfig values are defined, this struct will have a size 0 in C
 	 * which is not allowed in C++ (it'll have a size 1). To prevent this, we add a 1 byte dummy
 	 * variable when the struct would otherwise be empty.
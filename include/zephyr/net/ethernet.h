@@ -202,6 +202,12 @@ enum ethernet_hw_caps {
 
 	/** TX-Injection supported */
 	ETHERNET_TXINJECTION_MODE	= BIT(20),
+
+	/** TCP segmentation offload supported. The driver splits TCP
+	 * packets with a non-zero net_pkt_gso_size() into segments of
+	 * that payload length and computes their checksums.
+	 */
+	ETHERNET_HW_TSO			= BIT(21),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -65,8 +65,16 @@ struct http_resource_desc {
 
 /** @cond INTERNAL_HIDDEN */
 
+struct http_route;
+
 struct http_service_runtime_data {
 	int num_clients;
+#if defined(CONFIG_HTTP_SERVER_ROUTE_TABLE)
+	/* Resources sorted by path, followed by the wildcard ones */
+	struct http_route *routes;
+	uint16_t num_exact;
+	uint16_t num_routes;
+#endif
 };
 
 struct http_service_desc;
@@ -33,6 +33,23 @@ int loopback_set_packet_drop_ratio(float ratio);
 int loopback_get_num_dropped_packets(void);
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+/**
+ * @brief Set the one-way delay of the loopback interface
+ *
+ * Packets sent after this call are received @p delay_ms milliseconds
+ * later, so the round trip time of a connection over the loopback
+ * interface is twice the delay. Packets are always received in the order
+ * they were sent, so after lowering or disabling the delay, new packets
+ * wait until the ones already delayed have been received.
+ *
+ * @param[in] delay_ms Delay in milliseconds, 0 to disable
+ *
+ * @return 0 on success, otherwise a negative integer.
+ */
+int loopback_set_delay(int delay_ms);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
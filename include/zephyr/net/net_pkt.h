@@ -240,6 +240,11 @@ struct net_pkt {
 #if defined(CONFIG_NET_IP_FRAGMENT)
 	uint8_t ip_reassembled : 1; /* Packet is a reassembled IP packet. */
 #endif
+#if defined(CONFIG_NET_GRO)
+	uint8_t gro_chksum_ok : 1; /* TCP checksum was verified by GRO, which
+				    * may have coalesced several segments.
+				    */
+#endif
 #if defined(CONFIG_NET_PKT_TIMESTAMP)
 	uint8_t tx_timestamping : 1; /** Timestamp transmitted packet */
 	uint8_t rx_timestamping : 1; /** Timestamp received packet */
@@ -360,6 +365,13 @@ struct net_pkt {
 	uint8_t ipv4_pmtu : 1;
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Payload length of the TCP segments this packet is split into
+	 * before being sent, zero if it is sent as is.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
 	/* @endcond */
 };
 
@@ -872,6 +884,31 @@ static inline void net_pkt_set_ipv4_pmtu(struct net_pkt *pkt, bool value)
 }
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_IPV4_FRAGMENT)
 static inline uint16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
 {
@@ -1047,6 +1084,31 @@ static inline void net_pkt_set_ip_reassembled(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_IP_FRAGMENT */
 
+#if defined(CONFIG_NET_GRO)
+static inline bool net_pkt_is_gro_chksum_ok(struct net_pkt *pkt)
+{
+	return !!(pkt->gro_chksum_ok);
+}
+
+static inline void net_pkt_set_gro_chksum_ok(struct net_pkt *pkt, bool ok)
+{
+	pkt->gro_chksum_ok = ok;
+}
+#else /* CONFIG_NET_GRO */
+static inline bool net_pkt_is_gro_chksum_ok(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+
+static inline void net_pkt_set_gro_chksum_ok(struct net_pkt *pkt, bool ok)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ok);
+}
+#endif /* CONFIG_NET_GRO */
+
 static inline uint8_t net_pkt_priority(struct net_pkt *pkt)
 {
 	return pkt->priority;
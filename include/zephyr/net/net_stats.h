@@ -371,6 +371,18 @@ struct net_stats_pm {
 	uint32_t start_time;
 };
 
+/**
+ * @brief Generic receive offload statistics
+ */
+struct net_stats_gro {
+	/** TCP segments held to be coalesced */
+	net_stats_t held;
+	/** TCP segments merged into a held segment */
+	net_stats_t merged;
+	/** Held packets passed on to the IP layer */
+	net_stats_t flushed;
+};
+
 /**
  * @brief Network packet filter statistics
  */
@@ -503,6 +515,11 @@ struct net_stats {
 	/** Power management statistics */
 	struct net_stats_pm pm;
 #endif
+
+#if defined(CONFIG_NET_STATISTICS_GRO)
+	/** Generic receive offload statistics */
+	struct net_stats_gro gro;
+#endif
 };
 
 /**
@@ -758,6 +775,7 @@ enum net_request_stats_cmd {
 	NET_REQUEST_STATS_CMD_GET_WIFI,
 	NET_REQUEST_STATS_CMD_RESET_WIFI,
 	NET_REQUEST_STATS_CMD_GET_VPN,
+	NET_REQUEST_STATS_CMD_GET_GRO,
 };
 
 /** @endcond */
@@ -905,6 +923,16 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_VPN);
 /** @endcond */
 #endif /* CONFIG_NET_STATISTICS_VPN */
 
+#if defined(CONFIG_NET_STATISTICS_GRO)
+/** Request generic receive offload statistics */
+#define NET_REQUEST_STATS_GET_GRO				\
+	(NET_STATS_BASE | NET_REQUEST_STATS_CMD_GET_GRO)
+
+/** @cond INTERNAL_HIDDEN */
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_GRO);
+/** @endcond */
+#endif /* CONFIG_NET_STATISTICS_GRO */
+
 #endif /* CONFIG_NET_STATISTICS_USER_API */
 
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
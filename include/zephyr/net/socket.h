@@ -77,6 +77,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: only block until the first message has been received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -537,6 +539,135 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Message header used by zsock_sendmmsg() and zsock_recvmmsg()
+ */
+struct zsock_mmsghdr {
+	struct msghdr msg_hdr;  /**< Message header */
+	unsigned int msg_len;   /**< Number of bytes transferred for this message */
+};
+
+/**
+ * @brief Send several messages in one call
+ *
+ * @details
+ * Sends up to @p vlen messages, each of them as zsock_sendmsg() would,
+ * with a single socket lookup and lock for the whole vector. msg_len of
+ * each sent message is set to the number of bytes sent. Sending stops at
+ * the first message that could not be sent.
+ *
+ * @param sock Socket to send to.
+ * @param msgvec Array of messages to send.
+ * @param vlen Number of entries in @p msgvec.
+ * @param flags Send flags, applied to every message.
+ *
+ * @return Number of messages sent, or -1 with errno set if no message
+ *         could be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive several messages in one call
+ *
+ * @details
+ * Receives up to @p vlen messages, each of them as zsock_recvmsg() would,
+ * with a single socket lookup and lock for the whole vector. msg_len of
+ * each received message is set to the number of bytes received. With
+ * ZSOCK_MSG_WAITFORONE, only the first message may block, the following
+ * ones are received as with ZSOCK_MSG_DONTWAIT. Unlike the Linux
+ * function, there is no timeout argument, SO_RCVTIMEO applies instead.
+ *
+ * @param sock Socket to receive from.
+ * @param msgvec Array of messages to receive into.
+ * @param vlen Number of entries in @p msgvec.
+ * @param flags Receive flags, applied to every message.
+ *
+ * @return Number of messages received, or -1 with errno set if no message
+ *         could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Received datagram loaned to the application
+ *
+ * @details
+ * Filled by zsock_recvmsg_loan(), to be given back with
+ * zsock_rx_loan_release() once the data is not used anymore.
+ */
+struct zsock_rx_loan {
+	/** @cond INTERNAL_HIDDEN */
+	void *pkt;
+	/** @endcond */
+};
+
+/**
+ * @brief Receive a datagram without copying its data
+ *
+ * @details
+ * Works like zsock_recvmsg() for datagram and raw sockets, except that
+ * the data is not copied to the buffers described by @p msg. Instead,
+ * the entries of msg_iov are set to point to the data in the network
+ * buffers of the received packet, one entry per buffer, and msg_iovlen
+ * is set to the number of entries used. If the datagram is spread over
+ * more buffers than there are entries, the rest of the datagram is not
+ * returned and ZSOCK_MSG_TRUNC is set in msg_flags.
+ *
+ * The returned data stays valid until zsock_rx_loan_release() is called
+ * for @p loan. This function is only available from supervisor mode
+ * and if @kconfig{CONFIG_NET_SOCKETS_RX_LOAN} is enabled.
+ *
+ * @param sock Socket to receive from.
+ * @param msg Message header, msg_iov entries are output values.
+ * @param flags Receive flags, see zsock_recvmsg().
+ * @param loan Loan to release once the data has been processed.
+ *
+ * @return Number of bytes described by msg_iov, or -1 with errno set.
+ */
+ssize_t zsock_recvmsg_loan(int sock, struct msghdr *msg, int flags,
+			   struct zsock_rx_loan *loan);
+
+/**
+ * @brief Give back the buffers of a received datagram
+ *
+ * @param loan Loan filled by zsock_recvmsg_loan().
+ */
+void zsock_rx_loan_release(struct zsock_rx_loan *loan);
+
+struct fs_file_t;
+
+/**
+ * @brief Send data read from a file
+ *
+ * @details
+ * Sends up to @p count bytes read from @p file. On native TCP sockets,
+ * the file data is read straight into the network buffers of the
+ * connection, instead of going through an intermediate buffer and then
+ * being copied again by zsock_send(). Other sockets fall back to reading
+ * the file into a small stack buffer and sending it.
+ *
+ * If @p offset is not NULL, the file is read from that offset, which is
+ * then advanced by the number of bytes sent, and the file position is left
+ * unchanged. Otherwise, the file is read from, and its position advanced
+ * from, the current file position.
+ *
+ * Like zsock_send(), fewer bytes than requested may be sent. Less data is
+ * also sent when the end of the file is reached. This function is only
+ * available from supervisor mode and if
+ * @kconfig{CONFIG_NET_SOCKETS_SENDFILE} is enabled.
+ *
+ * @param sock Socket to send to.
+ * @param file File to read from, opened with fs_open().
+ * @param offset Offset to read from, or NULL to use the file position.
+ * @param count Maximum number of bytes to send.
+ *
+ * @return Number of bytes sent, 0 at the end of the file, or -1 with errno
+ *         set.
+ */
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t *offset,
+		       size_t count);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -959,6 +1090,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm, a string such as "reno", "cubic" or "bbr" */
+#define TCP_CONGESTION 5
 
 /** @} */
 
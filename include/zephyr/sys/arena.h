@@ -0,0 +1,235 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_ARENA_H_
+#define ZEPHYR_INCLUDE_SYS_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup arena_allocator Arena Allocator
+ * @ingroup heaps
+ * @{
+ */
+
+/**
+ * @brief Arena (region) allocator
+ *
+ * A sys_arena hands out memory by bumping a pointer through one or
+ * more blocks of backing memory.  Individual allocations are never
+ * freed; instead all memory allocated since a checkpoint (see
+ * sys_arena_mark() and sys_arena_restore()) or since initialization
+ * (see sys_arena_reset()) is released at once, in constant time.
+ * This suits code that builds up many short-lived objects while
+ * handling one request and drops them all when done.
+ *
+ * The backing memory is either a single caller-provided buffer, or
+ * blocks obtained on demand from a k_heap or a k_mem_slab.  Blocks
+ * are kept by the arena when it is reset or restored and reused for
+ * later allocations; sys_arena_trim() and sys_arena_release() give
+ * them back.  With CONFIG_HEAP_LISTENER, every block obtained or
+ * given back is reported to heap listeners registered for
+ * HEAP_ID_FROM_POINTER(arena).
+ *
+ * Like sys_heap, a sys_arena is not synchronized: concurrent use must
+ * be serialized by the caller.
+ */
+struct sys_arena;
+
+/** @cond INTERNAL_HIDDEN */
+
+struct k_heap;
+struct k_mem_slab;
+
+struct sys_arena_block {
+	struct sys_arena_block *next;
+	size_t size;
+};
+
+enum sys_arena_source {
+	SYS_ARENA_BUFFER,
+	SYS_ARENA_HEAP,
+	SYS_ARENA_SLAB,
+};
+
+struct sys_arena {
+	struct sys_arena_block *first;
+	struct sys_arena_block *cur;
+	uintptr_t pos;
+	uintptr_t end;
+	union {
+		struct k_heap *heap;
+		struct k_mem_slab *slab;
+	};
+	size_t block_size;
+	enum sys_arena_source source;
+};
+
+/** @endcond */
+
+/**
+ * @brief Arena checkpoint
+ *
+ * Opaque snapshot of the allocation state of an arena, see
+ * sys_arena_mark().
+ */
+struct sys_arena_mark {
+	/** @cond INTERNAL_HIDDEN */
+	struct sys_arena_block *block;
+	uintptr_t pos;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize an arena over a static buffer
+ *
+ * The arena never grows beyond @p bytes (minus a small header).
+ *
+ * @param arena Arena to initialize
+ * @param mem Buffer to allocate from
+ * @param bytes Size of the buffer
+ */
+void sys_arena_init(struct sys_arena *arena, void *mem, size_t bytes);
+
+/**
+ * @brief Initialize an arena backed by a k_heap
+ *
+ * No memory is taken from the heap until the first allocation.  The
+ * arena then grows by blocks of at least @p block_size bytes, larger
+ * if a single allocation requires it.  Blocks are obtained with
+ * K_NO_WAIT.
+ *
+ * @param arena Arena to initialize
+ * @param heap Heap to obtain blocks from
+ * @param block_size Minimum size of each block
+ */
+void sys_arena_init_heap(struct sys_arena *arena, struct k_heap *heap,
+			 size_t block_size);
+
+/**
+ * @brief Initialize an arena backed by a k_mem_slab
+ *
+ * No memory is taken from the slab until the first allocation.  The
+ * arena then grows one slab block at a time, so a single allocation
+ * can never be larger than the slab block size (minus a small
+ * header).  Blocks are obtained with K_NO_WAIT.
+ *
+ * @param arena Arena to initialize
+ * @param slab Memory slab to obtain blocks from
+ */
+void sys_arena_init_slab(struct sys_arena *arena, struct k_mem_slab *slab);
+
+/**
+ * @brief Allocate aligned memory from an arena
+ *
+ * @param arena Arena to allocate from
+ * @param align Required alignment, a power of two (or zero)
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory, or NULL if the arena is exhausted or
+ *         @p bytes is zero
+ */
+void *sys_arena_aligned_alloc(struct sys_arena *arena, size_t align,
+			      size_t bytes);
+
+/**
+ * @brief Allocate memory from an arena
+ *
+ * The memory is aligned to the size of a pointer or of a 64-bit
+ * integer, whichever is larger.
+ *
+ * @param arena Arena to allocate from
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory, or NULL if the arena is exhausted or
+ *         @p bytes is zero
+ */
+static inline void *sys_arena_alloc(struct sys_arena *arena, size_t bytes)
+{
+	return sys_arena_aligned_alloc(arena, MAX(sizeof(void *), sizeof(uint64_t)),
+				       bytes);
+}
+
+/**
+ * @brief Take a checkpoint of an arena
+ *
+ * Checkpoints nest: restoring one also discards every checkpoint
+ * taken after it.
+ *
+ * @param arena Arena to take a checkpoint of
+ * @return Checkpoint to pass to sys_arena_restore()
+ */
+static inline struct sys_arena_mark sys_arena_mark(struct sys_arena *arena)
+{
+	return (struct sys_arena_mark){ .block = arena->cur, .pos = arena->pos };
+}
+
+/**
+ * @brief Free everything allocated since a checkpoint
+ *
+ * Runs in constant time.  Blocks obtained since the checkpoint are
+ * kept for reuse, see sys_arena_trim().
+ *
+ * @param arena Arena to roll back
+ * @param mark Checkpoint previously returned by sys_arena_mark()
+ */
+void sys_arena_restore(struct sys_arena *arena, struct sys_arena_mark mark);
+
+/**
+ * @brief Free everything allocated from an arena
+ *
+ * Runs in constant time.  Blocks are kept for reuse, see
+ * sys_arena_trim().
+ *
+ * @param arena Arena to reset
+ */
+void sys_arena_reset(struct sys_arena *arena);
+
+/**
+ * @brief Give unused blocks back to the backing allocator
+ *
+ * Blocks past the one currently allocated from are returned to the
+ * backing k_heap or k_mem_slab.  Does nothing for arenas over a
+ * static buffer.
+ *
+ * @param arena Arena to trim
+ */
+void sys_arena_trim(struct sys_arena *arena);
+
+/**
+ * @brief Free everything and give all blocks back
+ *
+ * Equivalent to sys_arena_reset() followed by giving every block,
+ * including the first one, back to the backing allocator.  The arena
+ * can still be used afterwards and will grow again on demand.
+ *
+ * @param arena Arena to release
+ */
+void sys_arena_release(struct sys_arena *arena);
+
+/**
+ * @brief Number of bytes obtained from the backing memory
+ *
+ * @param arena Arena to query
+ * @return Total size of the blocks currently held by the arena,
+ *         including block headers
+ */
+size_t sys_arena_capacity(struct sys_arena *arena);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_ARENA_H_ */
@@ -280,6 +280,10 @@ enum {
 	ZFD_IOCTL_STAT,
 	ZFD_IOCTL_TRUNCATE,
 	ZFD_IOCTL_MMAP,
+	ZFD_IOCTL_RECV_LOAN,
+	ZFD_IOCTL_SENDMMSG,
+	ZFD_IOCTL_RECVMMSG,
+	ZFD_IOCTL_SENDFILE,
 
 	/* Codes above 0x5400 and below 0x5500 are reserved for termios, FIO, etc */
 	ZFD_IOCTL_FIONREAD = 0x541B,
@@ -67,6 +67,18 @@ struct z_heap_stress_result {
 	uint64_t accumulated_in_use_bytes;
 };
 
+/** Size class front end statistics of a sys_heap */
+struct sys_heap_size_class_stats {
+	/** Allocations served from a size class list */
+	uint32_t hits;
+	/** Eligible allocations that fell back to the heap */
+	uint32_t misses;
+	/** Number of chunks currently parked on the size class lists */
+	uint32_t cached_chunks;
+	/** Bytes currently parked on the size class lists */
+	size_t cached_bytes;
+};
+
 /**
  * @defgroup low_level_heap_allocator Low Level Heap Allocator
  * @ingroup heaps
@@ -76,6 +88,8 @@ struct z_heap_stress_result {
 /**
  * @brief Get the runtime statistics of a sys_heap
  *
+ * See also sys_heap_size_class_stats_get() for the size class front end.
+ *
  * @param heap Pointer to specified sys_heap
  * @param stats Pointer to struct to copy statistics into
  * @return -EINVAL if null pointers, otherwise 0
@@ -94,6 +108,26 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
  */
 int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
 
+/**
+ * @brief Get the size class front end statistics of a sys_heap
+ *
+ * Only available with CONFIG_SYS_HEAP_SIZE_CLASSES.  The hit and miss
+ * counters are only maintained when CONFIG_SYS_HEAP_RUNTIME_STATS is
+ * also enabled.  Bytes parked on the size class lists are reported as
+ * free by sys_heap_runtime_stats_get().
+ *
+ * These counters are not part of sys_heap_runtime_stats_get(), as the
+ * struct sys_memory_stats it fills is shared with the other allocators
+ * (k_heap, sys_mem_blocks, sys_multi_heap) and only describes memory
+ * usage.
+ *
+ * @param heap Pointer to specified sys_heap
+ * @param stats Pointer to struct to copy statistics into
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int sys_heap_size_class_stats_get(struct sys_heap *heap,
+				  struct sys_heap_size_class_stats *stats);
+
 /** @brief Initialize sys_heap
  *
  * Initializes a sys_heap struct to manage the specified memory.
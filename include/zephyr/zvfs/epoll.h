@@ -0,0 +1,95 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+#define ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+
+#include <stdint.h>
+
+#include <zephyr/sys/fdtable.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZVFS_EPOLLIN      ZVFS_POLLIN
+#define ZVFS_EPOLLPRI     ZVFS_POLLPRI
+#define ZVFS_EPOLLOUT     ZVFS_POLLOUT
+#define ZVFS_EPOLLERR     ZVFS_POLLERR
+#define ZVFS_EPOLLHUP     ZVFS_POLLHUP
+/** Reported when the file descriptor was closed while being monitored */
+#define ZVFS_EPOLLNVAL    ZVFS_POLLNVAL
+#define ZVFS_EPOLLONESHOT BIT(30)
+
+#define ZVFS_EPOLL_CTL_ADD 1
+#define ZVFS_EPOLL_CTL_DEL 2
+#define ZVFS_EPOLL_CTL_MOD 3
+
+typedef union zvfs_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} zvfs_epoll_data_t;
+
+struct zvfs_epoll_event {
+	uint32_t events;
+	zvfs_epoll_data_t data;
+};
+
+/**
+ * @brief Create a ZVFS epoll instance
+ *
+ * An epoll instance keeps a set of file descriptors, and the events of
+ * interest for each of them, registered with @ref zvfs_epoll_ctl. The
+ * descriptors that became ready are kept in a ready list as their state
+ * changes, so @ref zvfs_epoll_wait only looks at those.
+ *
+ * Readiness is level-triggered: a descriptor is reported by each call to
+ * @ref zvfs_epoll_wait for as long as it stays ready, unless it was
+ * registered with ZVFS_EPOLLONESHOT. Sockets and eventfds can be monitored,
+ * offloaded sockets cannot.
+ *
+ * The returned file descriptor can itself be polled for ZVFS_POLLIN.
+ *
+ * @param flags Must be 0
+ *
+ * @return New ZVFS epoll file descriptor on success, -1 on error
+ */
+int zvfs_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a file descriptor of a ZVFS epoll instance
+ *
+ * A file descriptor must be removed from the instance before it is closed.
+ *
+ * @param epfd Epoll file descriptor
+ * @param op ZVFS_EPOLL_CTL_ADD, ZVFS_EPOLL_CTL_MOD or ZVFS_EPOLL_CTL_DEL
+ * @param fd File descriptor to monitor
+ * @param event Events of interest and user data, ignored for
+ *        ZVFS_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, -1 on error
+ */
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event);
+
+/**
+ * @brief Wait for events on a ZVFS epoll instance
+ *
+ * @param epfd Epoll file descriptor
+ * @param events Array receiving the ready events and their user data
+ * @param maxevents Size of the @p events array
+ * @param timeout Timeout in milliseconds, negative value to wait forever
+ *
+ * @return Number of ready file descriptors, 0 on timeout, -1 on error
+ */
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_ */
@@ -74,6 +74,15 @@ void z_thread_abort(struct k_thread *thread);
 void move_thread_to_end_of_prio_q(struct k_thread *thread);
 bool thread_is_sliceable(struct k_thread *thread);
 
+#ifdef CONFIG_SCHED_DEADLINE
+void z_sched_deadline_update(struct k_thread *thread, uint32_t deadline);
+#endif /* CONFIG_SCHED_DEADLINE */
+
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+void z_sched_reservation_ready(struct k_thread *thread);
+void z_sched_reservation_release(struct k_thread *thread);
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
+
 static inline void z_reschedule_unlocked(void)
 {
 	(void) z_reschedule_irqlock(arch_irq_lock());
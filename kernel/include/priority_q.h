@@ -289,12 +289,44 @@ static ALWAYS_INLINE void z_priq_mq_init(struct _priq_mq *q)
 #endif
 }
 
+static ALWAYS_INLINE void z_priq_mq_level_add(sys_dlist_t *level,
+					      struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_DEADLINE
+	/* Threads of a priority level are kept sorted by deadline.  Walk
+	 * from the tail, as threads are usually readied with a deadline
+	 * later than those already queued, which makes this O(1) in the
+	 * common case.
+	 */
+	sys_dnode_t *n = sys_dlist_peek_tail(level);
+	struct k_thread *t;
+
+	while (n != NULL) {
+		t = CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+		if (z_sched_prio_cmp(thread, t) <= 0) {
+			break;
+		}
+		n = sys_dlist_peek_prev_no_check(level, n);
+	}
+
+	if (n == NULL) {
+		sys_dlist_prepend(level, &thread->base.qnode_dlist);
+	} else if (sys_dlist_is_tail(level, n)) {
+		sys_dlist_append(level, &thread->base.qnode_dlist);
+	} else {
+		sys_dlist_insert(n->next, &thread->base.qnode_dlist);
+	}
+#else
+	sys_dlist_append(level, &thread->base.qnode_dlist);
+#endif /* CONFIG_SCHED_DEADLINE */
+}
+
 static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 					struct k_thread *thread)
 {
 	struct prio_info pos = get_prio_info(thread->base.prio);
 
-	sys_dlist_append(&pq->queues[pos.offset_prio], &thread->base.qnode_dlist);
+	z_priq_mq_level_add(&pq->queues[pos.offset_prio], thread);
 	pq->bitmask[pos.idx] |= BIT(pos.bit);
 
 #ifndef CONFIG_SMP
@@ -324,8 +356,7 @@ static ALWAYS_INLINE void z_priq_mq_yield(struct _priq_mq *pq)
 	struct prio_info pos = get_prio_info(_current->base.prio);
 
 	sys_dlist_dequeue(&_current->base.qnode_dlist);
-	sys_dlist_append(&pq->queues[pos.offset_prio],
-			 &_current->base.qnode_dlist);
+	z_priq_mq_level_add(&pq->queues[pos.offset_prio], _current);
 #endif
 }
 
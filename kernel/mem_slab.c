@@ -18,6 +18,145 @@
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/*
+ * Each CPU caches a few free blocks in a LIFO list of its own, guarded
+ * by a lock of its own that is only contended when another CPU drains
+ * the cache.  Blocks move between the caches and the shared free list
+ * in batches, and are counted as used by the shared free list while
+ * cached.  Lock order is slab lock, then cache lock.
+ */
+#define CACHE_BATCH (CONFIG_MEM_SLAB_CPU_CACHE_SIZE / 2)
+
+static inline struct k_mem_slab_cpu_cache *cpu_cache_get(struct k_mem_slab *slab)
+{
+	/* Migrating right after reading the CPU id is harmless: the cache
+	 * lock makes using the cache of another CPU safe, just not local.
+	 */
+	return &slab->cpu_cache[_current_cpu->id];
+}
+
+/* Move up to @a n blocks from one free list to another */
+static uint32_t free_list_move(char **from, char **to, uint32_t n)
+{
+	uint32_t moved = 0U;
+	char *block;
+
+	while ((moved < n) && (*from != NULL)) {
+		block = *from;
+		*from = *(char **)block;
+		*(char **)block = *to;
+		*to = block;
+		moved++;
+	}
+
+	return moved;
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct k_mem_slab_cpu_cache *cache = cpu_cache_get(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	bool hit = cache->free_list != NULL;
+
+	if (hit) {
+		*mem = cache->free_list;
+		cache->free_list = *(char **)(cache->free_list);
+		cache->count--;
+		cache->hits++;
+	} else {
+		cache->misses++;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return hit;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	struct k_mem_slab_cpu_cache *cache = cpu_cache_get(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	bool hit = !slab->cache_bypass &&
+		   (cache->count < CONFIG_MEM_SLAB_CPU_CACHE_SIZE);
+
+	if (hit) {
+		*(char **)mem = cache->free_list;
+		cache->free_list = (char *)mem;
+		cache->count++;
+		cache->hits++;
+	} else {
+		cache->misses++;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return hit;
+}
+
+/* Refill the current CPU cache from the shared free list, or flush it
+ * to the shared free list.  Called with the slab lock held.
+ */
+static void cache_refill(struct k_mem_slab *slab)
+{
+	struct k_mem_slab_cpu_cache *cache = cpu_cache_get(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	uint32_t moved;
+
+	moved = free_list_move(&slab->free_list, &cache->free_list,
+			       MIN(CACHE_BATCH, CONFIG_MEM_SLAB_CPU_CACHE_SIZE - cache->count));
+	cache->count += moved;
+	slab->info.num_used += moved;
+
+	k_spin_unlock(&cache->lock, key);
+}
+
+static void cache_flush(struct k_mem_slab *slab)
+{
+	struct k_mem_slab_cpu_cache *cache = cpu_cache_get(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	uint32_t moved;
+
+	if (cache->count > CACHE_BATCH) {
+		moved = free_list_move(&cache->free_list, &slab->free_list,
+				       cache->count - CACHE_BATCH);
+		cache->count -= moved;
+		slab->info.num_used -= moved;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+}
+
+/* Return the blocks cached by all CPUs to the shared free list. Called
+ * with the slab lock held.
+ */
+static void cache_drain_all(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+		uint32_t moved;
+
+		moved = free_list_move(&cache->free_list, &slab->free_list, cache->count);
+		cache->count -= moved;
+		slab->info.num_used -= moved;
+
+		k_spin_unlock(&cache->lock, key);
+	}
+}
+
+static void cache_stats_get(struct k_mem_slab *slab, struct k_mem_slab_info *info)
+{
+	info->cache_hits = 0U;
+	info->cache_misses = 0U;
+
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		info->cache_hits += slab->cpu_cache[i].hits;
+		info->cache_misses += slab->cpu_cache[i].misses;
+	}
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 static struct k_obj_type obj_type_mem_slab;
 
@@ -33,6 +172,10 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	((struct k_mem_slab_info *)stats)->num_used -= z_mem_slab_num_cached(slab);
+	cache_stats_get(slab, stats);
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -48,9 +191,8 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
+	ptr->allocated_bytes = k_mem_slab_num_used_get(slab) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -75,6 +217,13 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	slab->info.max_used = slab->info.num_used;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		slab->cpu_cache[i].hits = 0U;
+		slab->cpu_cache[i].misses = 0U;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -184,6 +333,11 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	(void)memset(slab->cpu_cache, 0, sizeof(slab->cpu_cache));
+	slab->cache_bypass = false;
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -221,11 +375,34 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
+	key = k_spin_lock(&slab->lock);
+
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (slab->free_list == NULL) {
+		/* Free blocks may be sitting in the caches of other CPUs.
+		 * Keep frees away from the caches from now on if we may
+		 * end up waiting, so that they wake us up.
+		 */
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			slab->cache_bypass = true;
+		}
+		cache_drain_all(slab);
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -236,6 +413,12 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			 slab_ptr_is_good(slab, slab->free_list),
 			 "slab corruption detected");
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		if (!slab->cache_bypass) {
+			cache_refill(slab);
+		}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 		slab->info.max_used = MAX(slab->info.num_used,
 					  slab->info.max_used);
@@ -276,6 +459,14 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		return;
 	}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
@@ -295,6 +486,16 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 	slab->free_list = (char *) mem;
 	slab->info.num_used--;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (slab->cache_bypass) {
+		/* Nobody is waiting anymore once the wait queue is empty */
+		slab->cache_bypass = z_waitq_head(&slab->wait_q) != NULL;
+	} else {
+		/* The cache of this CPU is full */
+		cache_flush(slab);
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
 	k_spin_unlock(&slab->lock, key);
@@ -308,9 +509,8 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			    slab->info.block_size;
+	stats->allocated_bytes = k_mem_slab_num_used_get(slab) * slab->info.block_size;
+	stats->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
 				     slab->info.block_size;
@@ -40,6 +40,268 @@ static inline bool handle_poll_events(struct k_msgq *msgq)
 #endif /* CONFIG_POLL */
 }
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+/*
+ * Lock-free message queues use a bounded ring in the manner of
+ * Vyukov's MPMC queue: each slot has a sequence number telling whether
+ * it's free for the put at a given position or holds the message for
+ * the get at that position.  Positions only ever increase and are
+ * masked to index the ring, hence the power of two length.  So that
+ * statically defined queues need no runtime initialization, slots
+ * store their sequence number minus their index, which is zero for an
+ * empty queue.
+ *
+ * The wait queue and the spinlock are only used by threads that have
+ * to block.  A blocking thread registers itself in ring.waiters and
+ * retries under the lock before pending; a successful put or get that
+ * sees waiters wakes all of them up under the lock to retry, so no
+ * wakeup can be lost.
+ */
+
+static inline bool is_lockfree(struct k_msgq *msgq)
+{
+	return (msgq->flags & K_MSGQ_FLAG_LOCKFREE) != 0U;
+}
+
+/* Signed distance between two ring positions */
+static inline atomic_val_t ring_diff(atomic_val_t a, atomic_val_t b)
+{
+	return (atomic_val_t)((unsigned long)a - (unsigned long)b);
+}
+
+static inline atomic_val_t ring_seq(struct k_msgq *msgq, atomic_val_t idx)
+{
+	return ring_diff(atomic_get(&msgq->ring.seq[idx]), -idx);
+}
+
+static inline void ring_seq_set(struct k_msgq *msgq, atomic_val_t idx, atomic_val_t seq)
+{
+	(void)atomic_set(&msgq->ring.seq[idx], ring_diff(seq, idx));
+}
+
+/* Claim the position to put or get at, or return false if the ring is
+ * full or empty.
+ */
+static bool ring_claim(struct k_msgq *msgq, atomic_t *posp, atomic_val_t offset,
+		       atomic_val_t *posret)
+{
+	atomic_val_t mask = msgq->max_msgs - 1U;
+	atomic_val_t pos = atomic_get(posp);
+	atomic_val_t diff;
+
+	for (;;) {
+		diff = ring_diff(ring_seq(msgq, pos & mask), pos + offset);
+		if (diff == 0) {
+			if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+				(void)atomic_set(posp, pos + 1);
+				break;
+			}
+			if (atomic_cas(posp, pos, pos + 1)) {
+				break;
+			}
+		} else if (diff < 0) {
+			return false;
+		} else {
+			/* Lost a race against another producer or consumer */
+		}
+		pos = atomic_get(posp);
+	}
+
+	*posret = pos;
+
+	return true;
+}
+
+static bool ring_put(struct k_msgq *msgq, const void *data)
+{
+	atomic_val_t mask = msgq->max_msgs - 1U;
+	atomic_val_t pos;
+
+	if (!ring_claim(msgq, &msgq->ring.tail, 0, &pos)) {
+		return false;
+	}
+
+	(void)memcpy(msgq->buffer_start + (pos & mask) * msgq->msg_size, data,
+		     msgq->msg_size);
+	ring_seq_set(msgq, pos & mask, pos + 1);
+
+	return true;
+}
+
+static bool ring_get(struct k_msgq *msgq, void *data)
+{
+	atomic_val_t mask = msgq->max_msgs - 1U;
+	atomic_val_t pos;
+
+	if (!ring_claim(msgq, &msgq->ring.head, 1, &pos)) {
+		return false;
+	}
+
+	if (data != NULL) {
+		(void)memcpy(data, msgq->buffer_start + (pos & mask) * msgq->msg_size,
+			     msgq->msg_size);
+	}
+	ring_seq_set(msgq, pos & mask, pos + mask + 1);
+
+	return true;
+}
+
+static inline bool ring_xfer(struct k_msgq *msgq, void *data, bool put)
+{
+	return put ? ring_put(msgq, data) : ring_get(msgq, data);
+}
+
+static void ring_wake_all(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	struct k_thread *pending_thread;
+	bool resched = false;
+
+	for (pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	     pending_thread != NULL;
+	     pending_thread = z_unpend_first_thread(&msgq->wait_q)) {
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		resched = true;
+	}
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+}
+
+static int lockfree_xfer(struct k_msgq *msgq, void *data, k_timeout_t timeout, bool put)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	bool waited = false;
+	bool done = false;
+	int result;
+
+	while (!done && !ring_xfer(msgq, data, put)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			/* Woken up too late to retry is a timeout */
+			return waited ? -EAGAIN : -ENOMSG;
+		}
+
+		key = k_spin_lock(&msgq->lock);
+
+		/* Anyone making room or adding a message from now on
+		 * will wake us up, so retry once before pending.
+		 */
+		atomic_inc(&msgq->ring.waiters);
+		if (ring_xfer(msgq, data, put)) {
+			atomic_dec(&msgq->ring.waiters);
+			k_spin_unlock(&msgq->lock, key);
+			done = true;
+			continue;
+		}
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		atomic_dec(&msgq->ring.waiters);
+		if (result != 0) {
+			return result;
+		}
+
+		waited = true;
+		timeout = sys_timepoint_timeout(end);
+	}
+
+	if (atomic_get(&msgq->ring.waiters) != 0) {
+		ring_wake_all(msgq);
+	}
+
+	return 0;
+}
+
+static int lockfree_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
+{
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+	result = lockfree_xfer(msgq, (void *)data, timeout, true);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+	return result;
+}
+
+static int lockfree_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
+{
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+	result = lockfree_xfer(msgq, data, timeout, false);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+	return result;
+}
+
+static int lockfree_put_many(struct k_msgq *msgq, const void *data, uint32_t num,
+			     k_timeout_t timeout)
+{
+	const char *src = data;
+	uint32_t count = 0U;
+	int result;
+
+	while ((count < num) && ring_put(msgq, src + count * msgq->msg_size)) {
+		count++;
+	}
+
+	if (count == 0U) {
+		result = lockfree_put(msgq, data, timeout);
+		return (result == 0) ? 1 : result;
+	}
+
+	if (atomic_get(&msgq->ring.waiters) != 0) {
+		ring_wake_all(msgq);
+	}
+
+	return (int)count;
+}
+
+static int lockfree_get_many(struct k_msgq *msgq, void *data, uint32_t num,
+			     k_timeout_t timeout)
+{
+	char *dst = data;
+	uint32_t count = 0U;
+	int result;
+
+	while ((count < num) && ring_get(msgq, dst + count * msgq->msg_size)) {
+		count++;
+	}
+
+	if (count == 0U) {
+		result = lockfree_get(msgq, data, timeout);
+		return (result == 0) ? 1 : result;
+	}
+
+	if (atomic_get(&msgq->ring.waiters) != 0) {
+		ring_wake_all(msgq);
+	}
+
+	return (int)count;
+}
+
+static void lockfree_purge(struct k_msgq *msgq)
+{
+	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
+
+	while (ring_get(msgq, NULL)) {
+		/* discard */
+	}
+
+	if (atomic_get(&msgq->ring.waiters) != 0) {
+		ring_wake_all(msgq);
+	}
+}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -134,6 +396,12 @@ static inline int put_msg_in_queue(struct k_msgq *msgq, const void *data,
 	int result;
 	bool resched = false;
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if (is_lockfree(msgq)) {
+		return put_at_back ? lockfree_put(msgq, data, timeout) : -ENOTSUP;
+	}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (put_at_back) {
@@ -259,7 +527,7 @@ void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
 	attrs->max_msgs = msgq->max_msgs;
-	attrs->used_msgs = msgq->used_msgs;
+	attrs->used_msgs = z_msgq_used_msgs(msgq);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -282,6 +550,12 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	int result;
 	bool resched = false;
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if (is_lockfree(msgq)) {
+		return lockfree_get(msgq, data, timeout);
+	}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
@@ -354,11 +628,207 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <zephyr/syscalls/k_msgq_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Copy a message to the back of the ring, with the lock held */
+static inline void msgq_ring_write(struct k_msgq *msgq, const void *src)
+{
+	__ASSERT_NO_MSG(msgq->write_ptr >= msgq->buffer_start &&
+			msgq->write_ptr < msgq->buffer_end);
+	(void)memcpy(msgq->write_ptr, src, msgq->msg_size);
+	msgq->write_ptr += msgq->msg_size;
+	if (msgq->write_ptr == msgq->buffer_end) {
+		msgq->write_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs++;
+}
+
+/* Copy a message from the front of the ring, with the lock held */
+static inline void msgq_ring_read(struct k_msgq *msgq, void *dst)
+{
+	(void)memcpy(dst, msgq->read_ptr, msgq->msg_size);
+	msgq->read_ptr += msgq->msg_size;
+	if (msgq->read_ptr == msgq->buffer_end) {
+		msgq->read_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs--;
+}
+
+static int msgq_put_many(struct k_msgq *msgq, const void *data, uint32_t num,
+			 k_timeout_t timeout)
+{
+	const char *src = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t count = 0U;
+	bool queued = false;
+	bool resched = false;
+	int result;
+
+	if (num == 0U) {
+		return 0;
+	}
+
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if (is_lockfree(msgq)) {
+		return lockfree_put_many(msgq, data, num, timeout);
+	}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
+	key = k_spin_lock(&msgq->lock);
+
+	while ((count < num) && (msgq->used_msgs < msgq->max_msgs)) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (unlikely(pending_thread != NULL)) {
+			/* give message to waiting thread */
+			(void)memcpy(pending_thread->base.swap_data, src, msgq->msg_size);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			resched = true;
+		} else {
+			msgq_ring_write(msgq, src);
+			queued = true;
+		}
+		src += msgq->msg_size;
+		count++;
+	}
+
+	if (count == 0U) {
+		/* Queue full, wait for room like a single put does */
+		k_spin_unlock(&msgq->lock, key);
+		result = z_impl_k_msgq_put(msgq, data, timeout);
+		return (result == 0) ? 1 : result;
+	}
+
+	if (queued) {
+		resched = handle_poll_events(msgq) || resched;
+	}
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return (int)count;
+}
+
+static int msgq_get_many(struct k_msgq *msgq, void *data, uint32_t num,
+			 k_timeout_t timeout)
+{
+	char *dst = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t count = 0U;
+	bool resched = false;
+	int result;
+
+	if (num == 0U) {
+		return 0;
+	}
+
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if (is_lockfree(msgq)) {
+		return lockfree_get_many(msgq, data, num, timeout);
+	}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
+	key = k_spin_lock(&msgq->lock);
+
+	while ((count < num) && (msgq->used_msgs > 0U)) {
+		msgq_ring_read(msgq, dst);
+		dst += msgq->msg_size;
+		count++;
+
+		/* handle first thread waiting to write (if any) */
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (unlikely(pending_thread != NULL)) {
+			msgq_ring_write(msgq, pending_thread->base.swap_data);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			resched = true;
+		}
+	}
+
+	if (count == 0U) {
+		/* Queue empty, wait for a message like a single get does */
+		k_spin_unlock(&msgq->lock, key);
+		result = z_impl_k_msgq_get(msgq, data, timeout);
+		return (result == 0) ? 1 : result;
+	}
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return (int)count;
+}
+
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data, uint32_t num,
+			   k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_many, msgq, timeout);
+
+	result = msgq_put_many(msgq, data, num, timeout);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout, result);
+
+	return result;
+}
+
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data, uint32_t num,
+			   k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get_many, msgq, timeout);
+
+	result = msgq_get_many(msgq, data, num, timeout);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout, result);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+					 uint32_t num, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_READ(data, num, msgq->msg_size));
+
+	return z_impl_k_msgq_put_many(msgq, data, num, timeout);
+}
+#include <zephyr/syscalls/k_msgq_put_many_mrsh.c>
+
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *msgq, void *data,
+					 uint32_t num, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(data, num, msgq->msg_size));
+
+	return z_impl_k_msgq_get_many(msgq, data, num, timeout);
+}
+#include <zephyr/syscalls/k_msgq_get_many_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if (is_lockfree(msgq)) {
+		return -ENOTSUP;
+	}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > 0U) {
@@ -396,6 +866,12 @@ int z_impl_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
 	uint32_t byte_offset;
 	char *start_addr;
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if (is_lockfree(msgq)) {
+		return -ENOTSUP;
+	}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > idx) {
@@ -440,6 +916,13 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 	struct k_thread *pending_thread;
 	bool resched = false;
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	if (is_lockfree(msgq)) {
+		lockfree_purge(msgq);
+		return;
+	}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
@@ -155,6 +155,10 @@ static inline void register_event(struct k_poll_event *event,
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
 		__ASSERT(event->msgq != NULL, "invalid message queue\n");
+#ifdef CONFIG_MSGQ_LOCKFREE
+		__ASSERT((event->msgq->flags & K_MSGQ_FLAG_LOCKFREE) == 0U,
+			 "lock-free message queues can't be polled\n");
+#endif /* CONFIG_MSGQ_LOCKFREE */
 		add_event(&event->msgq->poll_events, event, poller);
 		break;
 	case K_POLL_TYPE_PIPE_DATA_AVAILABLE:
@@ -369,6 +369,68 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 	return (ret != 0) ? NULL : _current->base.swap_data;
 }
 
+/* Must be called with the queue lock held */
+static uint32_t queue_get_many_locked(struct k_queue *queue, void **data, uint32_t max)
+{
+	uint32_t count = 0U;
+	sys_sfnode_t *node;
+
+	while ((count < max) && !sys_sflist_is_empty(&queue->data_q)) {
+		node = sys_sflist_get_not_empty(&queue->data_q);
+		data[count++] = z_queue_node_peek(node, true);
+	}
+
+	return count;
+}
+
+int z_impl_k_queue_get_many(struct k_queue *queue, void **data, uint32_t max,
+			    k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	uint32_t count;
+	int ret;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, get_many, queue, timeout);
+
+	if (max == 0U) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get_many, queue, timeout, 0);
+
+		return 0;
+	}
+
+	key = k_spin_lock(&queue->lock);
+
+	count = queue_get_many_locked(queue, data, max);
+	if (likely(count > 0U) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&queue->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get_many, queue, timeout, (int)count);
+
+		return (int)count;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_queue, get_many, queue, timeout);
+
+	ret = z_pend_curr(&queue->lock, key, &queue->wait_q, timeout);
+	if ((ret != 0) || (_current->base.swap_data == NULL)) {
+		/* Timed out or k_queue_cancel_wait() */
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get_many, queue, timeout, 0);
+
+		return 0;
+	}
+
+	/* We were handed one item, pick up any that followed it */
+	data[0] = _current->base.swap_data;
+
+	key = k_spin_lock(&queue->lock);
+	count = 1U + queue_get_many_locked(queue, &data[1], max - 1U);
+	k_spin_unlock(&queue->lock, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get_many, queue, timeout, (int)count);
+
+	return (int)count;
+}
+
 bool k_queue_remove(struct k_queue *queue, void *data)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, remove, queue);
@@ -428,6 +490,15 @@ static inline void *z_vrfy_k_queue_get(struct k_queue *queue,
 }
 #include <zephyr/syscalls/k_queue_get_mrsh.c>
 
+static inline int z_vrfy_k_queue_get_many(struct k_queue *queue, void **data,
+					  uint32_t max, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(queue, K_OBJ_QUEUE));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(data, max, sizeof(void *)));
+	return z_impl_k_queue_get_many(queue, data, max, timeout);
+}
+#include <zephyr/syscalls/k_queue_get_many_mrsh.c>
+
 static inline int z_vrfy_k_queue_is_empty(struct k_queue *queue)
 {
 	K_OOPS(K_SYSCALL_OBJ(queue, K_OBJ_QUEUE));
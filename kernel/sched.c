@@ -347,6 +347,9 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+		z_sched_reservation_ready(thread);
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
 		queue_thread(thread);
 		update_cache(0);
 
@@ -999,6 +1002,24 @@ static inline void z_vrfy_k_thread_priority_set(k_tid_t thread, int prio)
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_SCHED_DEADLINE
+/* Must be called with _sched_spinlock held */
+void z_sched_deadline_update(struct k_thread *thread, uint32_t deadline)
+{
+	/* The prio_deadline field changes the sorting order, so can't
+	 * change it while the thread is in the run queue (dlists
+	 * actually are benign as long as we requeue it before we
+	 * release the lock, but an rbtree will blow up if we break
+	 * sorting!)
+	 */
+	if (z_is_thread_queued(thread)) {
+		dequeue_thread(thread);
+		thread->base.prio_deadline = deadline;
+		queue_thread(thread);
+	} else {
+		thread->base.prio_deadline = deadline;
+	}
+}
+
 void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 {
 
@@ -1007,20 +1028,8 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 	struct k_thread *thread = tid;
 	int32_t newdl = k_cycle_get_32() + deadline;
 
-	/* The prio_deadline field changes the sorting order, so can't
-	 * change it while the thread is in the run queue (dlists
-	 * actually are benign as long as we requeue it before we
-	 * release the lock, but an rbtree will blow up if we break
-	 * sorting!)
-	 */
 	K_SPINLOCK(&_sched_spinlock) {
-		if (z_is_thread_queued(thread)) {
-			dequeue_thread(thread);
-			thread->base.prio_deadline = newdl;
-			queue_thread(thread);
-		} else {
-			thread->base.prio_deadline = newdl;
-		}
+		z_sched_deadline_update(thread, newdl);
 	}
 }
 
@@ -1260,6 +1269,9 @@ static ALWAYS_INLINE void halt_thread(struct k_thread *thread, uint8_t new_state
 			}
 			z_abort_thread_timeout(thread);
 			unpend_all(&thread->join_queue);
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+			z_sched_reservation_release(thread);
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
 
 			/* Edge case: aborting _current from within an
 			 * ISR that preempted it requires clearing the
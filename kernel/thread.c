@@ -761,6 +761,10 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->slice_expired = NULL;
 #endif /* CONFIG_TIMESLICE_PER_THREAD */
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+	thread_base->reservation = (struct z_thread_reservation) {};
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
+
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
@@ -957,6 +961,10 @@ int k_thread_runtime_stats_get(k_tid_t thread,
 	*stats = (k_thread_runtime_stats_t) {};
 #endif /* CONFIG_SCHED_THREAD_USAGE */
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+	stats->overruns = thread->base.reservation.overruns;
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
+
 	return 0;
 }
 
@@ -5,7 +5,9 @@
  */
 
 #include <zephyr/kernel.h>
+#include <zephyr/init.h>
 #include <zephyr/spinlock.h>
+#include <zephyr/sys/math_extras.h>
 #include <ksched.h>
 #include <timeout_q.h>
 #include <zephyr/internal/syscall_handler.h>
@@ -14,7 +16,9 @@
 
 static uint64_t curr_tick;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SIMPLE
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif /* CONFIG_TIMEOUT_QUEUE_SIMPLE */
 
 /*
  * The timeout code shall take no locks other than its own (timeout_lock), nor
@@ -40,6 +44,592 @@ static inline unsigned int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+static int32_t elapsed(void)
+{
+	/* While sys_clock_announce() is executing, new relative timeouts will be
+	 * scheduled relatively to the currently firing timeout's original tick
+	 * value (=curr_tick) rather than relative to the current
+	 * sys_clock_elapsed().
+	 *
+	 * This means that timeouts being scheduled from within timeout callbacks
+	 * will be scheduled at well-defined offsets from the currently firing
+	 * timeout.
+	 *
+	 * As a side effect, the same will happen if an ISR with higher priority
+	 * preempts a timeout callback and schedules a timeout.
+	 *
+	 * The distinction is implemented by looking at announce_remaining which
+	 * will be non-zero while sys_clock_announce() is executing and zero
+	 * otherwise.
+	 */
+	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+
+/*
+ * Per-CPU timeout queues.
+ *
+ * Every CPU owns a queue of the timeouts armed on it, sorted by absolute
+ * expiry tick (stored in dticks) and protected by its own lock, and
+ * programs its own system timer comparator for the earliest of them.
+ * Timeouts never move between queues: they expire on the CPU that armed
+ * them. Only the tick accounting in curr_tick remains global, and
+ * timeout_lock is held just long enough to read or advance it.
+ */
+struct timeout_cpu {
+	struct k_spinlock lock;
+	sys_dlist_t list;
+	/* Expiry tick of the timeout being fired, 0 outside announce */
+	uint64_t firing_tick;
+};
+
+#define TIMEOUT_CPU_INIT(i, _) \
+	{ .list = SYS_DLIST_STATIC_INIT(&timeout_cpus[i].list) }
+
+static struct timeout_cpu timeout_cpus[CONFIG_MP_MAX_NUM_CPUS] = {
+	LISTIFY(CONFIG_MP_MAX_NUM_CPUS, TIMEOUT_CPU_INIT, (,))
+};
+
+static uint64_t now_tick(void)
+{
+	uint64_t now = 0U;
+
+	K_SPINLOCK(&timeout_lock) {
+		now = curr_tick + elapsed();
+	}
+
+	return now;
+}
+
+/* Locks the queue of the current CPU. The CPU is read again once the lock,
+ * which masks interrupts, is held, in case the caller migrated in between.
+ */
+static struct timeout_cpu *local_lock(k_spinlock_key_t *key)
+{
+	for (;;) {
+		uint8_t cpu = _current_cpu->id;
+		struct timeout_cpu *tc = &timeout_cpus[cpu];
+
+		*key = k_spin_lock(&tc->lock);
+		if (_current_cpu->id == cpu) {
+			return tc;
+		}
+		k_spin_unlock(&tc->lock, *key);
+	}
+}
+
+/* Locks the queue a timeout is armed on, NULL if it is not armed */
+static struct timeout_cpu *owner_lock(const struct _timeout *to, k_spinlock_key_t *key)
+{
+	for (;;) {
+		uint8_t cpu = to->cpu;
+		struct timeout_cpu *tc = &timeout_cpus[cpu];
+
+		*key = k_spin_lock(&tc->lock);
+		if (!sys_dnode_is_linked(&to->node)) {
+			k_spin_unlock(&tc->lock, *key);
+			return NULL;
+		}
+		if (to->cpu == cpu) {
+			return tc;
+		}
+		/* Expired and re-armed on another CPU meanwhile */
+		k_spin_unlock(&tc->lock, *key);
+	}
+}
+
+static struct _timeout *cpu_first(struct timeout_cpu *tc)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&tc->list);
+
+	return (t == NULL) ? NULL : CONTAINER_OF(t, struct _timeout, node);
+}
+
+/* must be locked */
+static int32_t cpu_next_timeout(struct timeout_cpu *tc)
+{
+	struct _timeout *to = cpu_first(tc);
+	int64_t ticks;
+
+	if (to == NULL) {
+		return MAX_WAIT;
+	}
+
+	ticks = to->dticks - (int64_t)now_tick();
+
+	return (ticks > (int64_t)INT_MAX) ? MAX_WAIT : (int32_t)MAX(0, ticks);
+}
+
+k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
+{
+	struct timeout_cpu *tc;
+	sys_dnode_t *n;
+	k_spinlock_key_t key;
+	uint64_t base;
+	uint64_t expiry;
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return 0;
+	}
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(to));
+#endif /* CONFIG_KERNEL_COHERENCE */
+
+	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	to->fn = fn;
+
+	tc = local_lock(&key);
+
+	/* Timeouts set from a timeout callback are relative to the tick
+	 * of the timeout being fired, as with the global queue.
+	 */
+	base = (tc->firing_tick != 0U) ? tc->firing_tick : now_tick();
+
+	if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
+		expiry = base + timeout.ticks + 1;
+	} else {
+		expiry = MAX(Z_TICK_ABS(timeout.ticks), (int64_t)(base + 1));
+	}
+
+	to->dticks = expiry;
+	to->cpu = _current_cpu->id;
+
+	/* Walk from the tail: most new timeouts expire after the pending
+	 * ones. Timeouts with the same expiry fire in the order they were
+	 * added.
+	 */
+	for (n = sys_dlist_peek_tail(&tc->list); n != NULL;
+	     n = sys_dlist_peek_prev(&tc->list, n)) {
+		if (CONTAINER_OF(n, struct _timeout, node)->dticks <= to->dticks) {
+			break;
+		}
+	}
+
+	if (n == NULL) {
+		sys_dlist_prepend(&tc->list, &to->node);
+	} else if (sys_dlist_peek_next(&tc->list, n) == NULL) {
+		sys_dlist_append(&tc->list, &to->node);
+	} else {
+		sys_dlist_insert(sys_dlist_peek_next(&tc->list, n), &to->node);
+	}
+
+	if ((to == cpu_first(tc)) && (tc->firing_tick == 0U)) {
+		sys_clock_set_timeout(cpu_next_timeout(tc), false);
+	}
+
+	k_spin_unlock(&tc->lock, key);
+
+	return (k_ticks_t)expiry;
+}
+
+int z_abort_timeout(struct _timeout *to)
+{
+	struct timeout_cpu *tc;
+	k_spinlock_key_t key;
+	bool is_first;
+
+	tc = owner_lock(to, &key);
+	if (tc == NULL) {
+		return -EINVAL;
+	}
+
+	is_first = (to == cpu_first(tc));
+	sys_dlist_remove(&to->node);
+	to->dticks = TIMEOUT_DTICKS_ABORTED;
+
+	/* A remote CPU will just see an early, empty expiry */
+	if (is_first && (tc->firing_tick == 0U) && (tc == &timeout_cpus[_current_cpu->id])) {
+		sys_clock_set_timeout(cpu_next_timeout(tc), false);
+	}
+
+	k_spin_unlock(&tc->lock, key);
+
+	return 0;
+}
+
+k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
+{
+	struct timeout_cpu *tc;
+	k_spinlock_key_t key;
+	k_ticks_t ticks;
+
+	tc = owner_lock(timeout, &key);
+	if (tc == NULL) {
+		return 0;
+	}
+
+	ticks = timeout->dticks - (int64_t)now_tick();
+	k_spin_unlock(&tc->lock, key);
+
+	return ticks;
+}
+
+k_ticks_t z_timeout_expires(const struct _timeout *timeout)
+{
+	struct timeout_cpu *tc;
+	k_spinlock_key_t key;
+	k_ticks_t ticks = 0;
+
+	tc = owner_lock(timeout, &key);
+	if (tc == NULL) {
+		K_SPINLOCK(&timeout_lock) {
+			ticks = curr_tick;
+		}
+		return ticks;
+	}
+
+	ticks = timeout->dticks;
+	k_spin_unlock(&tc->lock, key);
+
+	return ticks;
+}
+
+int32_t z_get_next_timeout_expiry(void)
+{
+	struct timeout_cpu *tc;
+	k_spinlock_key_t key;
+	int32_t ret;
+
+	tc = local_lock(&key);
+	ret = cpu_next_timeout(tc);
+	k_spin_unlock(&tc->lock, key);
+
+	return ret;
+}
+
+void sys_clock_announce(int32_t ticks)
+{
+	struct timeout_cpu *tc;
+	struct _timeout *t;
+	k_spinlock_key_t key;
+	uint64_t now = 0U;
+
+	K_SPINLOCK(&timeout_lock) {
+		curr_tick += ticks;
+	}
+
+	tc = local_lock(&key);
+
+	/* A nested announce from an interrupt preempting a callback on this
+	 * CPU only accounts the ticks, the running loop will catch up.
+	 */
+	if (tc->firing_tick != 0U) {
+		k_spin_unlock(&tc->lock, key);
+		return;
+	}
+
+	for (;;) {
+		K_SPINLOCK(&timeout_lock) {
+			now = curr_tick;
+		}
+
+		t = cpu_first(tc);
+		if ((t == NULL) || ((uint64_t)t->dticks > now)) {
+			break;
+		}
+
+		tc->firing_tick = t->dticks;
+		sys_dlist_remove(&t->node);
+		t->dticks = 0;
+
+		k_spin_unlock(&tc->lock, key);
+		t->fn(t);
+		key = k_spin_lock(&tc->lock);
+	}
+
+	tc->firing_tick = 0U;
+	sys_clock_set_timeout(cpu_next_timeout(tc), false);
+
+	k_spin_unlock(&tc->lock, key);
+
+#ifdef CONFIG_TIMESLICING
+	z_time_slice();
+#endif /* CONFIG_TIMESLICING */
+}
+
+#ifdef CONFIG_ZTEST
+/* Moves curr_tick to an arbitrary value, keeping every pending timeout at
+ * the same distance from the current tick.
+ */
+static void timeout_rebase(uint64_t tick)
+{
+	int64_t delta = 0;
+
+	K_SPINLOCK(&timeout_lock) {
+		delta = (int64_t)(tick - curr_tick);
+	}
+
+	for (unsigned int i = 0U; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct timeout_cpu *tc = &timeout_cpus[i];
+		struct _timeout *t;
+
+		K_SPINLOCK(&tc->lock) {
+			SYS_DLIST_FOR_EACH_CONTAINER(&tc->list, t, node) {
+				t->dticks += delta;
+			}
+		}
+	}
+
+	K_SPINLOCK(&timeout_lock) {
+		curr_tick = tick;
+	}
+}
+#endif /* CONFIG_ZTEST */
+
+#else /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/*
+ * Hierarchical timing wheel.
+ *
+ * Each pending timeout stores its absolute expiry tick in dticks and is
+ * hashed into the level selected by the most significant group of
+ * WHEEL_BITS bits in which its expiry differs from curr_tick. As a
+ * consequence every entry of level N shares all higher bit groups with
+ * curr_tick, and all entries of level N expire before any entry of level
+ * N + 1. When curr_tick enters the span of a level N slot, that slot is
+ * cascaded down into the finer levels, so a level 0 slot always holds
+ * timeouts expiring on exactly one tick.
+ *
+ * Slot occupancy bitmaps are maintained lazily: a removal only unlinks
+ * the node, and stale bits are cleared the next time a scan finds the
+ * slot empty.
+ */
+#define WHEEL_BITS   CONFIG_TIMEOUT_WHEEL_SLOT_BITS
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SLOTS  BIT(WHEEL_BITS)
+#define WHEEL_MASK   (WHEEL_SLOTS - 1U)
+
+struct wheel_level {
+	uint64_t bitmap;
+	sys_dlist_t slots[WHEEL_SLOTS];
+};
+
+static struct wheel_level wheel[WHEEL_LEVELS];
+
+/* Timeouts beyond the range covered by the wheel */
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+/* Cached earliest timeout, NULL when the queue is empty */
+static struct _timeout *wheel_first;
+static bool wheel_first_valid = true;
+
+static int wheel_init(void)
+{
+	for (unsigned int lvl = 0U; lvl < WHEEL_LEVELS; lvl++) {
+		for (unsigned int i = 0U; i < WHEEL_SLOTS; i++) {
+			sys_dlist_init(&wheel[lvl].slots[i]);
+		}
+	}
+
+	return 0;
+}
+
+SYS_INIT(wheel_init, PRE_KERNEL_1, 0);
+
+static inline uint64_t wheel_expiry(const struct _timeout *t)
+{
+#ifdef CONFIG_TIMEOUT_64BIT
+	return (uint64_t)t->dticks;
+#else
+	/* Only the low 32 bits of the expiry fit in dticks, rebuild the
+	 * full value relative to the current tick.
+	 */
+	return curr_tick + (int32_t)((uint32_t)t->dticks - (uint32_t)curr_tick);
+#endif /* CONFIG_TIMEOUT_64BIT */
+}
+
+static void wheel_place(struct _timeout *t)
+{
+	uint64_t expiry = wheel_expiry(t);
+	uint64_t diff = (expiry > curr_tick) ? (expiry ^ curr_tick) : 0U;
+	unsigned int lvl = 0U;
+	unsigned int slot;
+
+	if (diff != 0U) {
+		lvl = (63U - u64_count_leading_zeros(diff)) / WHEEL_BITS;
+	}
+
+	if (lvl >= WHEEL_LEVELS) {
+		sys_dlist_append(&wheel_overflow, &t->node);
+		return;
+	}
+
+	if (diff == 0U) {
+		/* Due (or overdue): fire on the current tick */
+		slot = curr_tick & WHEEL_MASK;
+	} else {
+		slot = (expiry >> (lvl * WHEEL_BITS)) & WHEEL_MASK;
+	}
+
+	sys_dlist_append(&wheel[lvl].slots[slot], &t->node);
+	wheel[lvl].bitmap |= BIT64(slot);
+}
+
+static struct _timeout *wheel_list_min(sys_dlist_t *list)
+{
+	struct _timeout *min = NULL;
+	struct _timeout *t;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+		if ((min == NULL) || (wheel_expiry(t) < wheel_expiry(min))) {
+			min = t;
+		}
+	}
+
+	return min;
+}
+
+static struct _timeout *wheel_find_first(void)
+{
+	for (unsigned int lvl = 0U; lvl < WHEEL_LEVELS; lvl++) {
+		unsigned int pos = (curr_tick >> (lvl * WHEEL_BITS)) & WHEEL_MASK;
+		uint64_t bits = wheel[lvl].bitmap & ~BIT64_MASK(pos);
+
+		while (bits != 0U) {
+			unsigned int slot = u64_count_trailing_zeros(bits);
+			sys_dlist_t *list = &wheel[lvl].slots[slot];
+
+			if (sys_dlist_is_empty(list)) {
+				wheel[lvl].bitmap &= ~BIT64(slot);
+				bits &= ~BIT64(slot);
+				continue;
+			}
+
+			/* Level 0 slots hold a single expiry tick */
+			if (lvl == 0U) {
+				return CONTAINER_OF(sys_dlist_peek_head(list),
+						    struct _timeout, node);
+			}
+
+			return wheel_list_min(list);
+		}
+	}
+
+	return wheel_list_min(&wheel_overflow);
+}
+
+static void wheel_cascade(sys_dlist_t *list)
+{
+	sys_dlist_t pending = SYS_DLIST_STATIC_INIT(&pending);
+	sys_dnode_t *node;
+
+	/* Entries of the overflow list may land back on it */
+	while ((node = sys_dlist_get(list)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		wheel_place(CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+static struct _timeout *first(void)
+{
+	if (!wheel_first_valid) {
+		wheel_first = wheel_find_first();
+		wheel_first_valid = true;
+	}
+
+	return wheel_first;
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	if (t == wheel_first) {
+		wheel_first = NULL;
+		wheel_first_valid = false;
+	}
+
+	sys_dlist_remove(&t->node);
+}
+
+/* Ticks from curr_tick until the timeout expires, must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	return (k_ticks_t)(wheel_expiry(timeout) - curr_tick);
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t dticks)
+{
+	to->dticks = curr_tick + dticks;
+	wheel_place(to);
+
+	if (wheel_first_valid &&
+	    ((wheel_first == NULL) || (timeout_rem(to) < timeout_rem(wheel_first)))) {
+		wheel_first = to;
+	}
+}
+
+/* Moves curr_tick forward. No pending timeout may expire before the new
+ * current tick.
+ */
+static void timeout_advance(k_ticks_t dt)
+{
+	uint64_t prev = curr_tick;
+
+	curr_tick += dt;
+
+	if ((prev >> (WHEEL_LEVELS * WHEEL_BITS)) != (curr_tick >> (WHEEL_LEVELS * WHEEL_BITS))) {
+		wheel_cascade(&wheel_overflow);
+	}
+
+	for (unsigned int lvl = WHEEL_LEVELS - 1U; lvl > 0U; lvl--) {
+		unsigned int shift = lvl * WHEEL_BITS;
+
+		if ((prev >> shift) != (curr_tick >> shift)) {
+			unsigned int slot = (curr_tick >> shift) & WHEEL_MASK;
+
+			wheel_cascade(&wheel[lvl].slots[slot]);
+			wheel[lvl].bitmap &= ~BIT64(slot);
+		}
+	}
+}
+
+#ifdef CONFIG_ZTEST
+/* Moves curr_tick to an arbitrary value, keeping every pending timeout at
+ * the same distance from the current tick, must be locked.
+ */
+static void timeout_rebase(uint64_t tick)
+{
+	sys_dlist_t pending = SYS_DLIST_STATIC_INIT(&pending);
+	sys_dnode_t *node;
+	struct _timeout *t;
+
+	for (unsigned int lvl = 0U; lvl < WHEEL_LEVELS; lvl++) {
+		for (unsigned int slot = 0U; slot < WHEEL_SLOTS; slot++) {
+			while ((node = sys_dlist_get(&wheel[lvl].slots[slot])) != NULL) {
+				t = CONTAINER_OF(node, struct _timeout, node);
+				t->dticks = timeout_rem(t);
+				sys_dlist_append(&pending, node);
+			}
+		}
+		wheel[lvl].bitmap = 0U;
+	}
+
+	while ((node = sys_dlist_get(&wheel_overflow)) != NULL) {
+		t = CONTAINER_OF(node, struct _timeout, node);
+		t->dticks = timeout_rem(t);
+		sys_dlist_append(&pending, node);
+	}
+
+	curr_tick = tick;
+	wheel_first = NULL;
+	wheel_first_valid = false;
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		t = CONTAINER_OF(node, struct _timeout, node);
+		t->dticks = curr_tick + MAX(0, t->dticks);
+		wheel_place(t);
+	}
+}
+#endif /* CONFIG_ZTEST */
+
+#else
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -63,37 +653,64 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
-static int32_t elapsed(void)
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
-	/* While sys_clock_announce() is executing, new relative timeouts will be
-	 * scheduled relatively to the currently firing timeout's original tick
-	 * value (=curr_tick) rather than relative to the current
-	 * sys_clock_elapsed().
-	 *
-	 * This means that timeouts being scheduled from within timeout callbacks
-	 * will be scheduled at well-defined offsets from the currently firing
-	 * timeout.
-	 *
-	 * As a side effect, the same will happen if an ISR with higher priority
-	 * preempts a timeout callback and schedules a timeout.
-	 *
-	 * The distinction is implemented by looking at announce_remaining which
-	 * will be non-zero while sys_clock_announce() is executing and zero
-	 * otherwise.
-	 */
-	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
 }
 
+static void insert_timeout(struct _timeout *to, k_ticks_t dticks)
+{
+	struct _timeout *t;
+
+	to->dticks = dticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
+static void timeout_advance(k_ticks_t dt)
+{
+	struct _timeout *t = first();
+
+	if (t != NULL) {
+		t->dticks -= dt;
+	}
+
+	curr_tick += dt;
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t next_timeout(int32_t ticks_elapsed)
 {
 	struct _timeout *to = first();
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(timeout_rem(to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, timeout_rem(to) - ticks_elapsed);
 	}
 
 	return ret;
@@ -115,34 +732,22 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
 		int32_t ticks_elapsed;
 		bool has_elapsed = false;
+		k_ticks_t dticks;
 
 		if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
 			ticks_elapsed = elapsed();
 			has_elapsed = true;
-			to->dticks = timeout.ticks + 1 + ticks_elapsed;
-			ticks = curr_tick + to->dticks;
+			dticks = timeout.ticks + 1 + ticks_elapsed;
+			ticks = curr_tick + dticks;
 		} else {
-			k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, dticks);
+			dticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+			dticks = MAX(1, dticks);
 			ticks = timeout.ticks;
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		insert_timeout(to, dticks);
 
 		if (to == first() && announce_remaining == 0) {
 			if (!has_elapsed) {
@@ -178,21 +783,6 @@ int z_abort_timeout(struct _timeout *to)
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
-{
-	k_ticks_t ticks = 0;
-
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks;
-}
-
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
@@ -251,13 +841,13 @@ void sys_clock_announce(int32_t ticks)
 	struct _timeout *t;
 
 	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
+	     (t != NULL) && (timeout_rem(t) <= announce_remaining);
 	     t = first()) {
-		int dt = t->dticks;
+		int dt = timeout_rem(t);
 
-		curr_tick += dt;
-		t->dticks = 0;
+		timeout_advance(dt);
 		remove_timeout(t);
+		t->dticks = 0;
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
@@ -265,11 +855,7 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
-
-	curr_tick += announce_remaining;
+	timeout_advance(announce_remaining);
 	announce_remaining = 0;
 
 	sys_clock_set_timeout(next_timeout(0), false);
@@ -281,6 +867,8 @@ void sys_clock_announce(int32_t ticks)
 #endif /* CONFIG_TIMESLICING */
 }
 
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 int64_t sys_clock_tick_get(void)
 {
 	uint64_t t = 0U;
@@ -353,7 +941,15 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
+#if defined(CONFIG_TIMEOUT_QUEUE_PER_CPU)
+	timeout_rebase(tick);
+#elif defined(CONFIG_TIMEOUT_QUEUE_WHEEL)
+	K_SPINLOCK(&timeout_lock) {
+		timeout_rebase(tick);
+	}
+#else
 	curr_tick = tick;
+#endif
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
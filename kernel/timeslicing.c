@@ -7,12 +7,29 @@
 #include <kswap.h>
 #include <ksched.h>
 #include <ipi.h>
+#include <zephyr/internal/syscall_handler.h>
 
 static int slice_ticks = DIV_ROUND_UP(CONFIG_TIMESLICE_SIZE * Z_HZ_ticks, Z_HZ_ms);
 static int slice_max_prio = CONFIG_TIMESLICE_PRIORITY;
 static struct _timeout slice_timeouts[CONFIG_MP_MAX_NUM_CPUS];
 static bool slice_expired[CONFIG_MP_MAX_NUM_CPUS];
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+/* Thread being charged for CPU time on each CPU, and since when */
+static struct k_thread *slice_owner[CONFIG_MP_MAX_NUM_CPUS];
+static k_ticks_t slice_start[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Sum of the utilization of all reservations, in parts per million */
+static uint32_t reserved_util;
+
+#define RESERVATION_MAX_UTIL (CONFIG_SCHED_DEADLINE_RESERVATION_MAX_UTILIZATION * 10000U)
+
+static inline bool is_reserved(struct k_thread *thread)
+{
+	return thread->base.reservation.period != 0;
+}
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
+
 #ifdef CONFIG_SWAP_NONATOMIC
 /* If z_swap() isn't atomic, then it's possible for a timer interrupt
  * to try to timeslice away _current after it has already pended
@@ -26,6 +43,13 @@ static inline int slice_time(struct k_thread *thread)
 {
 	int ret = slice_ticks;
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+	/* Reserved threads are sliced when their budget runs out */
+	if (is_reserved(thread)) {
+		return (int)CLAMP(thread->base.reservation.budget, 1, INT_MAX);
+	}
+#endif
+
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 	if (thread->base.slice_ticks != 0) {
 		ret = thread->base.slice_ticks;
@@ -48,9 +72,100 @@ bool thread_is_sliceable(struct k_thread *thread)
 	ret |= thread->base.slice_ticks != 0;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+	ret |= is_reserved(thread)
+		&& thread_is_preemptible(thread)
+		&& !z_is_thread_prevented_from_running(thread);
+#endif
+
 	return ret;
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+/* Convert the absolute reservation deadline (in ticks) to the cycle
+ * based deadline used for sorting the run queue.
+ */
+static void reservation_deadline_update(struct k_thread *thread, k_ticks_t now)
+{
+	k_ticks_t delta = MAX(thread->base.reservation.deadline - now, 0);
+
+	z_sched_deadline_update(thread, k_cycle_get_32() +
+				(uint32_t)k_ticks_to_cyc_floor64(delta));
+}
+
+/* Charge the CPU time consumed since the last reset to the thread
+ * that was running, and start accounting for the next one.
+ */
+static void reservation_charge(int cpu, struct k_thread *next)
+{
+	k_ticks_t now = sys_clock_tick_get();
+	struct k_thread *prev = slice_owner[cpu];
+
+	if ((prev != NULL) && is_reserved(prev)) {
+		prev->base.reservation.budget -= now - slice_start[cpu];
+	}
+
+	slice_owner[cpu] = next;
+	slice_start[cpu] = now;
+}
+
+/* The budget is exhausted: postpone the deadline by one period and
+ * replenish it.  Any overrun beyond the budget is forgiven.
+ */
+static void reservation_replenish(struct k_thread *thread)
+{
+	struct z_thread_reservation *res = &thread->base.reservation;
+	k_ticks_t now = sys_clock_tick_get();
+
+	res->overruns++;
+	res->deadline += res->period;
+	res->budget = res->runtime;
+	slice_start[_current_cpu->id] = now;
+
+	reservation_deadline_update(thread, now);
+}
+
+/* Called with _sched_spinlock held when a thread becomes runnable.
+ * If the remaining budget can't be consumed before the current
+ * deadline without exceeding the reserved bandwidth, a fresh
+ * deadline is generated (the constant bandwidth server wakeup rule).
+ */
+void z_sched_reservation_ready(struct k_thread *thread)
+{
+	struct z_thread_reservation *res = &thread->base.reservation;
+	k_ticks_t now;
+
+	if (!is_reserved(thread)) {
+		return;
+	}
+
+	now = sys_clock_tick_get();
+	if ((res->deadline <= now) ||
+	    (res->budget * res->period > (res->deadline - now) * res->runtime)) {
+		res->deadline = now + res->period;
+		res->budget = res->runtime;
+	}
+
+	reservation_deadline_update(thread, now);
+}
+
+/* Called with _sched_spinlock held when a thread is aborted */
+void z_sched_reservation_release(struct k_thread *thread)
+{
+	struct z_thread_reservation *res = &thread->base.reservation;
+
+	reserved_util -= res->util;
+	res->util = 0U;
+	res->period = 0;
+
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		if (slice_owner[i] == thread) {
+			slice_owner[i] = NULL;
+		}
+	}
+}
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
+
 static void slice_timeout(struct _timeout *timeout)
 {
 	int cpu = ARRAY_INDEX(slice_timeouts, timeout);
@@ -71,6 +186,9 @@ void z_reset_time_slice(struct k_thread *thread)
 
 	z_abort_timeout(&slice_timeouts[cpu]);
 	slice_expired[cpu] = false;
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+	reservation_charge(cpu, thread);
+#endif
 	if (thread_is_sliceable(thread)) {
 		z_add_timeout(&slice_timeouts[cpu], slice_timeout,
 			      K_TICKS(slice_time(thread) - 1));
@@ -121,6 +239,11 @@ void z_time_slice(void)
 			curr->base.slice_expired(curr, curr->base.slice_data);
 			key = k_spin_lock(&_sched_spinlock);
 		}
+#endif
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+		if (is_reserved(curr)) {
+			reservation_replenish(curr);
+		}
 #endif
 		if (!z_is_thread_prevented_from_running(curr)) {
 			move_thread_to_end_of_prio_q(curr);
@@ -129,3 +252,61 @@ void z_time_slice(void)
 	}
 	k_spin_unlock(&_sched_spinlock, key);
 }
+
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+int z_impl_k_thread_reservation_set(k_tid_t thread, uint32_t runtime_us,
+				    uint32_t period_us)
+{
+	struct z_thread_reservation *res = &thread->base.reservation;
+	uint32_t util = 0U;
+	int ret = 0;
+
+	if (runtime_us > period_us) {
+		return -EINVAL;
+	}
+
+	if (runtime_us != 0U) {
+		util = (uint32_t)(((uint64_t)runtime_us * 1000000U) / period_us);
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		k_ticks_t now = sys_clock_tick_get();
+
+		if (reserved_util - res->util + util > RESERVATION_MAX_UTIL) {
+			ret = -EBUSY;
+			K_SPINLOCK_BREAK;
+		}
+
+		reserved_util = reserved_util - res->util + util;
+		res->util = util;
+
+		if (runtime_us == 0U) {
+			res->runtime = 0;
+			res->period = 0;
+		} else {
+			res->runtime = MAX(k_us_to_ticks_floor64(runtime_us), 1);
+			res->period = k_us_to_ticks_ceil64(period_us);
+			res->budget = res->runtime;
+			res->deadline = now + res->period;
+			reservation_deadline_update(thread, now);
+		}
+
+		if (thread == _current) {
+			z_reset_time_slice(thread);
+		}
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_thread_reservation_set(k_tid_t thread, uint32_t runtime_us,
+						  uint32_t period_us)
+{
+	K_OOPS(K_SYSCALL_OBJ(thread, K_OBJ_THREAD));
+
+	return z_impl_k_thread_reservation_set(thread, runtime_us, period_us);
+}
+#include <zephyr/syscalls/k_thread_reservation_set_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
@@ -60,11 +60,154 @@ static inline uint32_t flags_get(const uint32_t *flagp)
 	return *flagp;
 }
 
-/* Lock to protect the internal state of all work items, work queues,
- * and pending_cancels.
+/* Lock protecting the internal state of work items that have never been
+ * submitted or scheduled to a work queue, and ordering the acquisition of
+ * several work queue locks.
+ *
+ * Each work queue has its own lock protecting its state, and also the
+ * state of every work item that was last submitted to it (i.e. whose
+ * queue field references it).  Moving a work item to another queue
+ * requires the locks of both queues: such operations take this lock
+ * first, so that at most one context at a time holds more than one
+ * queue lock and there can be no lock order inversion between them.
  */
 static struct k_spinlock lock;
 
+/* Lock protecting pending_cancels, always taken last. */
+static struct k_spinlock cancel_lock;
+
+/* Locks held while operating on a work item, see work_lock(). */
+struct work_lock {
+	k_spinlock_key_t key;
+
+	/* Lock protecting the work item state */
+	struct k_spinlock *item;
+
+	/* Lock of a queue the work item may be moved to, or NULL */
+	struct k_spinlock *extra;
+
+	/* True if the global lock was taken first */
+	bool global;
+
+	/* Queue whose lock was found missing by the operation, which must
+	 * then be retried with it, or NULL.
+	 */
+	struct k_work_q *retry;
+};
+
+static inline struct k_spinlock *queue_lock(struct k_work_q *queue)
+{
+	return (queue != NULL) ? &queue->lock : &lock;
+}
+
+/* Lock the state of a work item and, if not NULL, of a queue it may be
+ * submitted to.
+ *
+ * @param work the work item to lock
+ * @param queue queue that the operation may move the work item to
+ * @param wl lock state, to be passed to work_unlock()
+ */
+static void work_lock(const struct k_work *work, struct k_work_q *queue,
+		      struct work_lock *wl)
+{
+	struct k_spinlock *item;
+
+	wl->extra = NULL;
+	wl->retry = NULL;
+	wl->global = (queue != NULL);
+
+	if (!wl->global) {
+		/* The work item may be moved to another queue until its
+		 * current queue is locked, so check again once locked.
+		 */
+		for (;;) {
+			item = queue_lock(work->queue);
+			wl->key = k_spin_lock(item);
+			if (item == queue_lock(work->queue)) {
+				break;
+			}
+			k_spin_unlock(item, wl->key);
+		}
+
+		wl->item = item;
+		return;
+	}
+
+	wl->key = k_spin_lock(&lock);
+
+	for (;;) {
+		item = queue_lock(work->queue);
+		if (item == &lock) {
+			break;
+		}
+
+		(void)k_spin_lock(item);
+		if (item == queue_lock(work->queue)) {
+			break;
+		}
+		k_spin_release(item);
+	}
+
+	wl->item = item;
+
+	if (&queue->lock != item) {
+		(void)k_spin_lock(&queue->lock);
+		wl->extra = &queue->lock;
+	}
+}
+
+static void work_unlock(struct work_lock *wl)
+{
+	if (wl->extra != NULL) {
+		k_spin_release(wl->extra);
+	}
+
+	if (!wl->global) {
+		k_spin_unlock(wl->item, wl->key);
+		return;
+	}
+
+	if (wl->item != &lock) {
+		k_spin_release(wl->item);
+	}
+	k_spin_unlock(&lock, wl->key);
+}
+
+/* Check that submitting a work item to a queue only touches queues
+ * already locked.  If not, record the missing queue so the caller can
+ * retry with its lock.
+ *
+ * Must be checked before changing any state.
+ *
+ * @param work the work item that may be submitted
+ * @param queue the queue the work item may be submitted to
+ * @param wl the locks held
+ *
+ * @retval true if the submission can proceed
+ * @retval false if the operation must be retried
+ */
+static bool submit_locked_check(const struct k_work *work,
+				struct k_work_q *queue,
+				struct work_lock *wl)
+{
+	/* Canceling or queued work is not submitted, and running work
+	 * stays on the queue it belongs to.
+	 */
+	if ((queue == NULL) ||
+	    ((flags_get(&work->flags)
+	      & (K_WORK_CANCELING | K_WORK_QUEUED | K_WORK_RUNNING)) != 0U)) {
+		return true;
+	}
+
+	if ((&queue->lock == wl->item) || (&queue->lock == wl->extra)) {
+		return true;
+	}
+
+	wl->retry = queue;
+
+	return false;
+}
+
 /* Invoked by work thread */
 static void handle_flush(struct k_work *work) { }
 
@@ -92,7 +235,10 @@ static inline void init_work_cancel(struct z_work_canceller *canceler,
 {
 	k_sem_init(&canceler->sem, 0, 1);
 	canceler->work = work;
-	sys_slist_append(&pending_cancels, &canceler->node);
+
+	K_SPINLOCK(&cancel_lock) {
+		sys_slist_append(&pending_cancels, &canceler->node);
+	}
 }
 
 /* Complete flushing of a work item.
@@ -140,13 +286,15 @@ static void finalize_cancel_locked(struct k_work *work)
 	 * appear multiple times in the list if multiple threads
 	 * attempt to cancel it.
 	 */
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&pending_cancels, wc, tmp, node) {
-		if (wc->work == work) {
-			sys_slist_remove(&pending_cancels, prev, &wc->node);
-			k_sem_give(&wc->sem);
-			break;
+	K_SPINLOCK(&cancel_lock) {
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&pending_cancels, wc, tmp, node) {
+			if (wc->work == work) {
+				sys_slist_remove(&pending_cancels, prev, &wc->node);
+				k_sem_give(&wc->sem);
+				break;
+			}
+			prev = &wc->node;
 		}
-		prev = &wc->node;
 	}
 }
 
@@ -168,10 +316,13 @@ static inline int work_busy_get_locked(const struct k_work *work)
 
 int k_work_busy_get(const struct k_work *work)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct work_lock wl;
+
+	work_lock(work, NULL, &wl);
+
 	int ret = work_busy_get_locked(work);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&wl);
 
 	return ret;
 }
@@ -303,6 +454,9 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  *
  * @param work the work structure to be submitted
 
+ * @param wl the locks held.  The submission is not attempted, and must be
+ * retried with the lock of wl->retry, if it needs a queue lock not held.
+ *
  * @param queuep pointer to a queue reference.  On input this should
  * dereference to the proposed queue (which may be null); after completion it
  * will be null if the work was not submitted or if submitted will reference
@@ -316,13 +470,17 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * @retval -EBUSY if canceling or submission was rejected by queue
  * @retval -EINVAL if no queue is provided
  * @retval -ENODEV if the queue is not started
+ * @retval -EAGAIN if the submission must be retried with wl->retry locked
  */
 static int submit_to_queue_locked(struct k_work *work,
+				  struct work_lock *wl,
 				  struct k_work_q **queuep)
 {
 	int ret = 0;
 
-	if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
+	if (!submit_locked_check(work, *queuep, wl)) {
+		ret = -EAGAIN;
+	} else if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
 		/* Disallowed */
 		ret = -EBUSY;
 	} else if (!flag_test(&work->flags, K_WORK_QUEUED_BIT)) {
@@ -381,11 +539,21 @@ int z_work_submit_to_queue(struct k_work_q *queue,
 	__ASSERT_NO_MSG(work != NULL);
 	__ASSERT_NO_MSG(work->handler != NULL);
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct work_lock wl;
+	struct k_work_q *target;
+	int ret;
 
-	int ret = submit_to_queue_locked(work, &queue);
+	/* Work is usually resubmitted to the queue it belongs to, which
+	 * only needs the lock of that queue.
+	 */
+	wl.retry = (work->queue != queue) ? queue : NULL;
 
-	k_spin_unlock(&lock, key);
+	do {
+		target = queue;
+		work_lock(work, wl.retry, &wl);
+		ret = submit_to_queue_locked(work, &wl, &target);
+		work_unlock(&wl);
+	} while (wl.retry != NULL);
 
 	return ret;
 }
@@ -469,11 +637,13 @@ bool k_work_flush(struct k_work *work,
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, flush, work);
 
 	struct z_work_flusher *flusher = &sync->flusher;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct work_lock wl;
+
+	work_lock(work, NULL, &wl);
 
 	bool need_flush = work_flush_locked(work, flusher);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&wl);
 
 	/* If necessary wait until the flusher item completes */
 	if (need_flush) {
@@ -557,10 +727,13 @@ int k_work_cancel(struct k_work *work)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, cancel, work);
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct work_lock wl;
+
+	work_lock(work, NULL, &wl);
+
 	int ret = cancel_async_locked(work);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&wl);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, cancel, work, ret);
 
@@ -581,7 +754,10 @@ bool k_work_cancel_sync(struct k_work *work,
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, cancel_sync, work, sync);
 
 	struct z_work_canceller *canceller = &sync->canceller;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct work_lock wl;
+
+	work_lock(work, NULL, &wl);
+
 	bool pending = (work_busy_get_locked(work) != 0U);
 	bool need_wait = false;
 
@@ -590,7 +766,7 @@ bool k_work_cancel_sync(struct k_work *work,
 		need_wait = cancel_sync_locked(work, canceller);
 	}
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&wl);
 
 	if (need_wait) {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_work, cancel_sync, work, sync);
@@ -611,7 +787,7 @@ static void work_timeout_handler(struct _timeout *record)
 	const char *name;
 	const char *space = " ";
 
-	K_SPINLOCK(&lock) {
+	K_SPINLOCK(&queue->lock) {
 		work = queue->work;
 		handler = work->handler;
 	}
@@ -648,6 +824,164 @@ static void work_timeout_stop_locked(struct k_work_q *queue)
 }
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
 
+#if defined(CONFIG_WORKQUEUE_POOL)
+
+static inline bool work_is_flusher(sys_snode_t *node)
+{
+	return (node != NULL) &&
+	       (CONTAINER_OF(node, struct k_work, node)->handler == handle_flush);
+}
+
+/* Move the first work item pending on a queue of a pool to another
+ * queue of the pool.
+ *
+ * Invoked with the global lock and the locks of both queues held.
+ *
+ * A work item followed by a flusher is left in place, as the flusher
+ * must not complete before the work item it waits for.
+ *
+ * @retval true if a work item was moved
+ */
+static bool work_pool_move_locked(struct k_work_q *from, struct k_work_q *to)
+{
+	sys_snode_t *node = sys_slist_peek_head(&from->pending);
+	struct k_work *work;
+
+	if ((node == NULL) || work_is_flusher(node) ||
+	    work_is_flusher(sys_slist_peek_next(node))) {
+		return false;
+	}
+
+	(void)sys_slist_get(&from->pending);
+	sys_slist_append(&to->pending, node);
+
+	work = CONTAINER_OF(node, struct k_work, node);
+	work->queue = to;
+
+	return true;
+}
+
+/* Steal a work item pending on another queue of the pool.
+ *
+ * Invoked with no lock held, by the thread of @p queue.
+ *
+ * @retval true if a work item was added to @p queue
+ */
+static bool work_pool_steal(struct k_work_q *queue)
+{
+	struct k_work_pool *pool = queue->pool;
+	uint32_t self = queue - pool->queues;
+	bool stolen = false;
+
+	/* Taking the global lock first allows holding several queue
+	 * locks.
+	 */
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	(void)k_spin_lock(&queue->lock);
+
+	if ((flags_get(&queue->flags)
+	     & (K_WORK_QUEUE_DRAIN | K_WORK_QUEUE_PLUGGED | K_WORK_QUEUE_STOP)) == 0U) {
+		for (uint32_t i = 1U; !stolen && (i < pool->num_queues); i++) {
+			struct k_work_q *victim = &pool->queues[(self + i) % pool->num_queues];
+
+			(void)k_spin_lock(&victim->lock);
+			stolen = work_pool_move_locked(victim, queue);
+			k_spin_release(&victim->lock);
+		}
+	}
+
+	k_spin_release(&queue->lock);
+	k_spin_unlock(&lock, key);
+
+	return stolen;
+}
+
+/* Make sure that a thread of the pool handles work just submitted to
+ * @p queue.
+ *
+ * If the thread of @p queue is idle the submission woke it up.  Otherwise
+ * wake up another idle thread of the pool to steal the work.
+ */
+static void work_pool_kick(struct k_work_pool *pool, struct k_work_q *queue)
+{
+	atomic_val_t idle;
+
+	if (atomic_test_and_clear_bit(&pool->idle, queue - pool->queues)) {
+		return;
+	}
+
+	idle = atomic_get(&pool->idle);
+
+	while (idle != 0) {
+		uint32_t i = find_lsb_set(idle) - 1U;
+
+		if (atomic_test_and_clear_bit(&pool->idle, i)) {
+			struct k_work_q *idle_queue = &pool->queues[i];
+
+			K_SPINLOCK(&idle_queue->lock) {
+				flag_set(&idle_queue->flags, K_WORK_QUEUE_STEAL_BIT);
+				(void)notify_queue_locked(idle_queue);
+			}
+			break;
+		}
+
+		idle &= ~BIT(i);
+	}
+}
+
+/* Kick the pool of @p queue after a submission to it returned @p ret.
+ *
+ * Work that was running stays on the queue that ran it, whose thread is
+ * busy anyway.
+ */
+static void work_pool_submitted(struct k_work_q *queue, int ret)
+{
+	if ((ret == 1) && (queue->pool != NULL)) {
+		work_pool_kick(queue->pool, queue);
+	}
+}
+
+/* Look for work to steal before the thread of a pool queue goes to sleep.
+ *
+ * Invoked with the queue lock held, which is released if work may be
+ * available.
+ *
+ * @retval true if the lock was released and the thread should look for
+ * work again
+ * @retval false if the thread can go to sleep, with the lock held
+ */
+static bool work_pool_idle(struct k_work_q *queue, k_spinlock_key_t *key)
+{
+	struct k_work_pool *pool = queue->pool;
+	uint32_t self = queue - pool->queues;
+
+	/* Publish that this thread is idle before looking for work, so
+	 * that work submitted in the meantime kicks it.
+	 */
+	atomic_set_bit(&pool->idle, self);
+	k_spin_unlock(&queue->lock, *key);
+
+	if (work_pool_steal(queue)) {
+		atomic_clear_bit(&pool->idle, self);
+		return true;
+	}
+
+	*key = k_spin_lock(&queue->lock);
+
+	if (!sys_slist_is_empty(&queue->pending) ||
+	    ((flags_get(&queue->flags) & (K_WORK_QUEUE_DRAIN | K_WORK_QUEUE_STOP)) != 0U) ||
+	    flag_test_and_clear(&queue->flags, K_WORK_QUEUE_STEAL_BIT)) {
+		atomic_clear_bit(&pool->idle, self);
+		k_spin_unlock(&queue->lock, *key);
+		return true;
+	}
+
+	return false;
+}
+
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
@@ -663,7 +997,7 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		sys_snode_t *node;
 		struct k_work *work = NULL;
 		k_work_handler_t handler = NULL;
-		k_spinlock_key_t key = k_spin_lock(&lock);
+		k_spinlock_key_t key = k_spin_lock(&queue->lock);
 		bool yield;
 
 		/* Check for and prepare any new work. */
@@ -706,7 +1040,7 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			/* User has requested that the queue stop. Clear the status flags and exit.
 			 */
 			flags_set(&queue->flags, 0);
-			k_spin_unlock(&lock, key);
+			k_spin_unlock(&queue->lock, key);
 			return;
 		} else {
 			/* No work is available and no queue state requires
@@ -722,8 +1056,21 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * work thread will be woken and we can check again.
 			 */
 
-			(void)z_sched_wait(&lock, key, &queue->notifyq,
+#if defined(CONFIG_WORKQUEUE_POOL)
+			if ((queue->pool != NULL) && work_pool_idle(queue, &key)) {
+				continue;
+			}
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+
+			(void)z_sched_wait(&queue->lock, key, &queue->notifyq,
 					   K_FOREVER, NULL);
+
+#if defined(CONFIG_WORKQUEUE_POOL)
+			if (queue->pool != NULL) {
+				atomic_clear_bit(&queue->pool->idle,
+						 queue - queue->pool->queues);
+			}
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
 			continue;
 		}
 
@@ -731,7 +1078,7 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		work_timeout_start_locked(queue, work);
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
 
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&queue->lock, key);
 
 		__ASSERT_NO_MSG(handler != NULL);
 		handler(work);
@@ -741,7 +1088,7 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		 * was running.  Clear the BUSY flag and optionally
 		 * yield to prevent starving other threads.
 		 */
-		key = k_spin_lock(&lock);
+		key = k_spin_lock(&queue->lock);
 
 #if defined(CONFIG_WORKQUEUE_WORK_TIMEOUT)
 		work_timeout_stop_locked(queue);
@@ -757,7 +1104,7 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&queue->lock, key);
 
 		/* Optionally yield to prevent the work queue from
 		 * starving other threads.
@@ -809,11 +1156,17 @@ void k_work_queue_run(struct k_work_q *queue, const struct k_work_queue_config *
 	work_queue_main(queue, NULL, NULL);
 }
 
-void k_work_queue_start(struct k_work_q *queue,
-			k_thread_stack_t *stack,
-			size_t stack_size,
-			int prio,
-			const struct k_work_queue_config *cfg)
+/* Start a work queue thread.
+ *
+ * @param cpu CPU to pin the thread to, if CONFIG_SCHED_CPU_MASK is
+ * enabled, or -1
+ */
+static void work_queue_start(struct k_work_q *queue,
+			     k_thread_stack_t *stack,
+			     size_t stack_size,
+			     int prio,
+			     const struct k_work_queue_config *cfg,
+			     int cpu)
 {
 	__ASSERT_NO_MSG(queue);
 	__ASSERT_NO_MSG(stack);
@@ -857,12 +1210,29 @@ void k_work_queue_start(struct k_work_q *queue,
 	}
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
 
+#if defined(CONFIG_SCHED_CPU_MASK)
+	if (cpu >= 0) {
+		(void)k_thread_cpu_pin(&queue->thread, cpu);
+	}
+#else
+	ARG_UNUSED(cpu);
+#endif /* defined(CONFIG_SCHED_CPU_MASK) */
+
 	k_thread_start(&queue->thread);
 	queue->thread_id = &queue->thread;
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+void k_work_queue_start(struct k_work_q *queue,
+			k_thread_stack_t *stack,
+			size_t stack_size,
+			int prio,
+			const struct k_work_queue_config *cfg)
+{
+	work_queue_start(queue, stack, stack_size, prio, cfg, -1);
+}
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -872,7 +1242,7 @@ int k_work_queue_drain(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, drain, queue);
 
 	int ret = 0;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 
 	if (((flags_get(&queue->flags)
 	      & (K_WORK_QUEUE_BUSY | K_WORK_QUEUE_DRAIN)) != 0U)
@@ -884,10 +1254,10 @@ int k_work_queue_drain(struct k_work_q *queue,
 		}
 
 		notify_queue_locked(queue);
-		ret = z_sched_wait(&lock, key, &queue->drainq,
+		ret = z_sched_wait(&queue->lock, key, &queue->drainq,
 				   K_FOREVER, NULL);
 	} else {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&queue->lock, key);
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, drain, queue, ret);
@@ -902,13 +1272,13 @@ int k_work_queue_unplug(struct k_work_q *queue)
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, unplug, queue);
 
 	int ret = -EALREADY;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 
 	if (flag_test_and_clear(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT)) {
 		ret = 0;
 	}
 
-	k_spin_unlock(&lock, key);
+	k_spin_unlock(&queue->lock, key);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, unplug, queue, ret);
 
@@ -920,28 +1290,28 @@ int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout)
 	__ASSERT_NO_MSG(queue);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, stop, queue, timeout);
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 
 	if (!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT)) {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&queue->lock, key);
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, stop, queue, timeout, -EALREADY);
 		return -EALREADY;
 	}
 
 	if (!flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT)) {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&queue->lock, key);
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, stop, queue, timeout, -EBUSY);
 		return -EBUSY;
 	}
 
 	flag_set(&queue->flags, K_WORK_QUEUE_STOP_BIT);
 	notify_queue_locked(queue);
-	k_spin_unlock(&lock, key);
+	k_spin_unlock(&queue->lock, key);
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_work_queue, stop, queue, timeout);
 	if (k_thread_join(queue->thread_id, timeout)) {
-		key = k_spin_lock(&lock);
+		key = k_spin_lock(&queue->lock);
 		flag_clear(&queue->flags, K_WORK_QUEUE_STOP_BIT);
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&queue->lock, key);
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, stop, queue, timeout, -ETIMEDOUT);
 		return -ETIMEDOUT;
 	}
@@ -963,8 +1333,9 @@ static void work_timeout(struct _timeout *to)
 	struct k_work_delayable *dw
 		= CONTAINER_OF(to, struct k_work_delayable, timeout);
 	struct k_work *wp = &dw->work;
-	k_spinlock_key_t key = k_spin_lock(&lock);
 	struct k_work_q *queue = NULL;
+	struct work_lock wl;
+	int ret = 0;
 
 	/* If the work is still marked delayed (should be) then clear that
 	 * state and submit it to the queue.  If successful the queue will be
@@ -973,12 +1344,31 @@ static void work_timeout(struct _timeout *to)
 	 * If not successful there is no notification that the work has been
 	 * abandoned.  Sorry.
 	 */
-	if (flag_test_and_clear(&wp->flags, K_WORK_DELAYED_BIT)) {
-		queue = dw->queue;
-		(void)submit_to_queue_locked(wp, &queue);
-	}
+	wl.retry = (wp->queue != dw->queue) ? dw->queue : NULL;
 
-	k_spin_unlock(&lock, key);
+	do {
+		work_lock(wp, wl.retry, &wl);
+
+		if (flag_test(&wp->flags, K_WORK_DELAYED_BIT) &&
+		    submit_locked_check(wp, dw->queue, &wl)) {
+			flag_clear(&wp->flags, K_WORK_DELAYED_BIT);
+			queue = dw->queue;
+			ret = submit_to_queue_locked(wp, &wl, &queue);
+		}
+
+		work_unlock(&wl);
+	} while (wl.retry != NULL);
+
+#if defined(CONFIG_WORKQUEUE_POOL)
+	/* Expired work of a pool must not wait for the next submission to
+	 * get an idle thread of the pool going.
+	 */
+	if (queue != NULL) {
+		work_pool_submitted(queue, ret);
+	}
+#else
+	ARG_UNUSED(ret);
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
 }
 
 void k_work_init_delayable(struct k_work_delayable *dwork,
@@ -1007,10 +1397,13 @@ int k_work_delayable_busy_get(const struct k_work_delayable *dwork)
 {
 	__ASSERT_NO_MSG(dwork != NULL);
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct work_lock wl;
+
+	work_lock(&dwork->work, NULL, &wl);
+
 	int ret = work_delayable_busy_get_locked(dwork);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&wl);
 	return ret;
 }
 
@@ -1024,6 +1417,8 @@ int k_work_delayable_busy_get(const struct k_work_delayable *dwork)
  *
  * Invoked with work lock held.
  *
+ * @param wl the locks held
+ *
  * @param queuep pointer to a pointer to a queue.  On input this
  * should dereference to the proposed queue (which may be null); after
  * completion it will be null if the work was not submitted or if
@@ -1037,7 +1432,8 @@ int k_work_delayable_busy_get(const struct k_work_delayable *dwork)
  * @retval from submit_to_queue_locked() if delay is K_NO_WAIT; otherwise
  * @retval 1 to indicate successfully scheduled.
  */
-static int schedule_for_queue_locked(struct k_work_q **queuep,
+static int schedule_for_queue_locked(struct work_lock *wl,
+				     struct k_work_q **queuep,
 				     struct k_work_delayable *dwork,
 				     k_timeout_t delay)
 {
@@ -1045,7 +1441,7 @@ static int schedule_for_queue_locked(struct k_work_q **queuep,
 	struct k_work *work = &dwork->work;
 
 	if (K_TIMEOUT_EQ(delay, K_NO_WAIT)) {
-		return submit_to_queue_locked(work, queuep);
+		return submit_to_queue_locked(work, wl, queuep);
 	}
 
 	flag_set(&work->flags, K_WORK_DELAYED_BIT);
@@ -1113,15 +1509,24 @@ int k_work_schedule_for_queue(struct k_work_q *queue, struct k_work_delayable *d
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, schedule_for_queue, queue, dwork, delay);
 
 	struct k_work *work = &dwork->work;
-	int ret = 0;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_work_q *target;
+	struct work_lock wl;
+	int ret;
 
-	/* Schedule the work item if it's idle or running. */
-	if ((work_busy_get_locked(work) & ~K_WORK_RUNNING) == 0U) {
-		ret = schedule_for_queue_locked(&queue, dwork, delay);
-	}
+	wl.retry = (K_TIMEOUT_EQ(delay, K_NO_WAIT) && (work->queue != queue)) ? queue : NULL;
 
-	k_spin_unlock(&lock, key);
+	do {
+		ret = 0;
+		target = queue;
+		work_lock(work, wl.retry, &wl);
+
+		/* Schedule the work item if it's idle or running. */
+		if ((work_busy_get_locked(work) & ~K_WORK_RUNNING) == 0U) {
+			ret = schedule_for_queue_locked(&wl, &target, dwork, delay);
+		}
+
+		work_unlock(&wl);
+	} while (wl.retry != NULL);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, schedule_for_queue, queue, dwork, delay, ret);
 
@@ -1147,16 +1552,31 @@ int k_work_reschedule_for_queue(struct k_work_q *queue, struct k_work_delayable
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, reschedule_for_queue, queue, dwork, delay);
 
-	int ret;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_work *work = &dwork->work;
+	struct k_work_q *target;
+	struct work_lock wl;
+	int ret = 0;
 
-	/* Remove any active scheduling. */
-	(void)unschedule_locked(dwork);
+	wl.retry = (K_TIMEOUT_EQ(delay, K_NO_WAIT) && (work->queue != queue)) ? queue : NULL;
 
-	/* Schedule the work item with the new parameters. */
-	ret = schedule_for_queue_locked(&queue, dwork, delay);
+	do {
+		target = queue;
+		work_lock(work, wl.retry, &wl);
 
-	k_spin_unlock(&lock, key);
+		/* Don't unschedule if the new schedule can't be applied
+		 * with the locks held.
+		 */
+		if (!K_TIMEOUT_EQ(delay, K_NO_WAIT) ||
+		    submit_locked_check(work, queue, &wl)) {
+			/* Remove any active scheduling. */
+			(void)unschedule_locked(dwork);
+
+			/* Schedule the work item with the new parameters. */
+			ret = schedule_for_queue_locked(&wl, &target, dwork, delay);
+		}
+
+		work_unlock(&wl);
+	} while (wl.retry != NULL);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, reschedule_for_queue, queue, dwork, delay, ret);
 
@@ -1180,10 +1600,13 @@ int k_work_cancel_delayable(struct k_work_delayable *dwork)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, cancel_delayable, dwork);
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct work_lock wl;
+
+	work_lock(&dwork->work, NULL, &wl);
+
 	int ret = cancel_delayable_async_locked(dwork);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&wl);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, cancel_delayable, dwork, ret);
 
@@ -1203,7 +1626,10 @@ bool k_work_cancel_delayable_sync(struct k_work_delayable *dwork,
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, cancel_delayable_sync, dwork, sync);
 
 	struct z_work_canceller *canceller = &sync->canceller;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct work_lock wl;
+
+	work_lock(&dwork->work, NULL, &wl);
+
 	bool pending = (work_delayable_busy_get_locked(dwork) != 0U);
 	bool need_wait = false;
 
@@ -1212,7 +1638,7 @@ bool k_work_cancel_delayable_sync(struct k_work_delayable *dwork,
 		need_wait = cancel_sync_locked(&dwork->work, canceller);
 	}
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&wl);
 
 	if (need_wait) {
 		k_sem_take(&canceller->sem, K_FOREVER);
@@ -1236,16 +1662,29 @@ bool k_work_flush_delayable(struct k_work_delayable *dwork,
 
 	struct k_work *work = &dwork->work;
 	struct z_work_flusher *flusher = &sync->flusher;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct work_lock wl;
+	bool need_flush;
 
-	/* If it's idle release the lock and return immediately. */
-	if (work_busy_get_locked(work) == 0U) {
-		k_spin_unlock(&lock, key);
+	wl.retry = NULL;
 
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, flush_delayable, dwork, sync, false);
+	do {
+		work_lock(work, wl.retry, &wl);
 
-		return false;
-	}
+		/* If it's idle release the lock and return immediately. */
+		if (work_busy_get_locked(work) == 0U) {
+			work_unlock(&wl);
+
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, flush_delayable, dwork, sync,
+						       false);
+
+			return false;
+		}
+
+		if (flag_test(&work->flags, K_WORK_DELAYED_BIT) &&
+		    !submit_locked_check(work, dwork->queue, &wl)) {
+			work_unlock(&wl);
+		}
+	} while (wl.retry != NULL);
 
 	/* If unscheduling did something then submit it.  Ignore a
 	 * failed submission (e.g. when cancelling).
@@ -1253,13 +1692,13 @@ bool k_work_flush_delayable(struct k_work_delayable *dwork,
 	if (unschedule_locked(dwork)) {
 		struct k_work_q *queue = dwork->queue;
 
-		(void)submit_to_queue_locked(work, &queue);
+		(void)submit_to_queue_locked(work, &wl, &queue);
 	}
 
 	/* Wait for it to finish */
-	bool need_flush = work_flush_locked(work, flusher);
+	need_flush = work_flush_locked(work, flusher);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&wl);
 
 	/* If necessary wait until the flusher item completes */
 	if (need_flush) {
@@ -1272,3 +1711,63 @@ bool k_work_flush_delayable(struct k_work_delayable *dwork,
 }
 
 #endif /* CONFIG_SYS_CLOCK_EXISTS */
+
+#if defined(CONFIG_WORKQUEUE_POOL)
+
+/* Queue of the pool associated with the current CPU.  The caller may
+ * migrate right after, which only affects how work is spread.
+ */
+static struct k_work_q *work_pool_local(struct k_work_pool *pool)
+{
+#ifdef CONFIG_SMP
+	uint32_t cpu = arch_curr_cpu()->id;
+#else
+	uint32_t cpu = 0U;
+#endif /* CONFIG_SMP */
+
+	return &pool->queues[cpu % pool->num_queues];
+}
+
+void k_work_pool_start(struct k_work_pool *pool, int prio,
+		       const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG((pool->num_queues > 0U) && (pool->num_queues <= ATOMIC_BITS));
+
+	atomic_clear(&pool->idle);
+
+	for (uint32_t i = 0U; i < pool->num_queues; i++) {
+		struct k_work_q *queue = &pool->queues[i];
+
+		queue->pool = pool;
+		work_queue_start(queue, &pool->stacks[i * pool->stack_stride],
+				 pool->stack_size, prio, cfg,
+				 (int)(i % arch_num_cpus()));
+	}
+}
+
+int k_work_pool_submit(struct k_work_pool *pool, struct k_work *work)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+
+	struct k_work_q *queue = work_pool_local(pool);
+	int ret = k_work_submit_to_queue(queue, work);
+
+	work_pool_submitted(queue, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_SYS_CLOCK_EXISTS
+
+int k_work_pool_schedule(struct k_work_pool *pool,
+			 struct k_work_delayable *dwork, k_timeout_t delay)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+
+	return k_work_schedule_for_queue(work_pool_local(pool), dwork, delay);
+}
+
+#endif /* CONFIG_SYS_CLOCK_EXISTS */
+
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
@@ -0,0 +1,246 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/arena.h>
+#include <zephyr/sys/heap_listener.h>
+
+/* Blocks are singly linked in the order they are allocated from.
+ * Everything past arena->cur is unused and kept around for reuse, so
+ * rolling back only needs to move the bump pointer.
+ */
+
+static inline uintptr_t block_start(struct sys_arena_block *b)
+{
+	return (uintptr_t)(b + 1);
+}
+
+static inline uintptr_t block_end(struct sys_arena_block *b)
+{
+	return (uintptr_t)b + b->size;
+}
+
+static void set_block(struct sys_arena *arena, struct sys_arena_block *b,
+		      uintptr_t pos)
+{
+	arena->cur = b;
+	arena->pos = pos;
+	arena->end = (b != NULL) ? block_end(b) : 0;
+}
+
+static bool block_fits(struct sys_arena_block *b, size_t align, size_t bytes)
+{
+	uintptr_t p = ROUND_UP(block_start(b), align);
+
+	return (p <= block_end(b)) && (bytes <= block_end(b) - p);
+}
+
+static struct sys_arena_block *block_get(struct sys_arena *arena, size_t align,
+					 size_t bytes)
+{
+	size_t need = sizeof(struct sys_arena_block) + bytes + align - 1;
+	struct sys_arena_block *b = NULL;
+	size_t size = 0;
+
+	if (need < bytes) {
+		return NULL; /* overflow */
+	}
+
+	switch (arena->source) {
+	case SYS_ARENA_HEAP:
+		size = MAX(arena->block_size, need);
+		b = k_heap_alloc(arena->heap, size, K_NO_WAIT);
+		break;
+	case SYS_ARENA_SLAB:
+		size = arena->block_size;
+		if (need <= size) {
+			void *mem;
+
+			if (k_mem_slab_alloc(arena->slab, &mem, K_NO_WAIT) == 0) {
+				b = mem;
+			}
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (b != NULL) {
+		b->next = NULL;
+		b->size = size;
+		heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(arena), b, size);
+	}
+
+	return b;
+}
+
+static void block_put(struct sys_arena *arena, struct sys_arena_block *b)
+{
+	heap_listener_notify_free(HEAP_ID_FROM_POINTER(arena), b, b->size);
+
+	if (arena->source == SYS_ARENA_HEAP) {
+		k_heap_free(arena->heap, b);
+	} else {
+		k_mem_slab_free(arena->slab, b);
+	}
+}
+
+static void init_common(struct sys_arena *arena, enum sys_arena_source source,
+			size_t block_size)
+{
+	arena->first = NULL;
+	arena->source = source;
+	arena->block_size = block_size;
+	set_block(arena, NULL, 0);
+}
+
+void sys_arena_init(struct sys_arena *arena, void *mem, size_t bytes)
+{
+	uintptr_t addr = ROUND_UP(mem, sizeof(void *));
+	size_t pad = addr - (uintptr_t)mem;
+
+	__ASSERT(bytes > pad + sizeof(struct sys_arena_block),
+		 "arena buffer is too small");
+
+	struct sys_arena_block *b = (struct sys_arena_block *)addr;
+
+	init_common(arena, SYS_ARENA_BUFFER, 0);
+
+	b->next = NULL;
+	b->size = bytes - pad;
+	arena->first = b;
+	set_block(arena, b, block_start(b));
+}
+
+void sys_arena_init_heap(struct sys_arena *arena, struct k_heap *heap,
+			 size_t block_size)
+{
+	init_common(arena, SYS_ARENA_HEAP, block_size);
+	arena->heap = heap;
+}
+
+void sys_arena_init_slab(struct sys_arena *arena, struct k_mem_slab *slab)
+{
+	__ASSERT(slab->info.block_size > sizeof(struct sys_arena_block),
+		 "slab blocks are too small");
+
+	init_common(arena, SYS_ARENA_SLAB, slab->info.block_size);
+	arena->slab = slab;
+}
+
+void *sys_arena_aligned_alloc(struct sys_arena *arena, size_t align,
+			      size_t bytes)
+{
+	struct sys_arena_block *b;
+	uintptr_t p;
+
+	if (bytes == 0) {
+		return NULL;
+	}
+
+	if (align == 0) {
+		align = 1;
+	}
+	__ASSERT((align & (align - 1)) == 0, "align must be a power of 2");
+
+	/* Fast path: bump within the current block */
+	if (arena->cur != NULL) {
+		p = ROUND_UP(arena->pos, align);
+		if ((p <= arena->end) && (bytes <= arena->end - p)) {
+			arena->pos = p + bytes;
+			return (void *)p;
+		}
+	}
+
+	/* Move on to the next retained block if it fits, otherwise
+	 * get a new one and put it right after the current block.
+	 */
+	b = (arena->cur != NULL) ? arena->cur->next : arena->first;
+	if ((b == NULL) || !block_fits(b, align, bytes)) {
+		b = block_get(arena, align, bytes);
+		if (b == NULL) {
+			return NULL;
+		}
+
+		if (arena->cur != NULL) {
+			b->next = arena->cur->next;
+			arena->cur->next = b;
+		} else {
+			b->next = arena->first;
+			arena->first = b;
+		}
+	}
+
+	p = ROUND_UP(block_start(b), align);
+	set_block(arena, b, p + bytes);
+
+	return (void *)p;
+}
+
+void sys_arena_restore(struct sys_arena *arena, struct sys_arena_mark mark)
+{
+	if (mark.block == NULL) {
+		sys_arena_reset(arena);
+		return;
+	}
+
+	__ASSERT((mark.pos >= block_start(mark.block)) &&
+		 (mark.pos <= block_end(mark.block)), "invalid arena mark");
+
+	set_block(arena, mark.block, mark.pos);
+}
+
+void sys_arena_reset(struct sys_arena *arena)
+{
+	struct sys_arena_block *b = arena->first;
+
+	set_block(arena, b, (b != NULL) ? block_start(b) : 0);
+}
+
+void sys_arena_trim(struct sys_arena *arena)
+{
+	struct sys_arena_block *b, *next;
+
+	if ((arena->source == SYS_ARENA_BUFFER) || (arena->cur == NULL)) {
+		return;
+	}
+
+	for (b = arena->cur->next; b != NULL; b = next) {
+		next = b->next;
+		block_put(arena, b);
+	}
+	arena->cur->next = NULL;
+}
+
+void sys_arena_release(struct sys_arena *arena)
+{
+	struct sys_arena_block *b, *next;
+
+	sys_arena_reset(arena);
+
+	if (arena->source == SYS_ARENA_BUFFER) {
+		return;
+	}
+
+	for (b = arena->first; b != NULL; b = next) {
+		next = b->next;
+		block_put(arena, b);
+	}
+	arena->first = NULL;
+	set_block(arena, NULL, 0);
+}
+
+size_t sys_arena_capacity(struct sys_arena *arena)
+{
+	size_t total = 0;
+
+	for (struct sys_arena_block *b = arena->first; b != NULL; b = b->next) {
+		total += b->size;
+	}
+
+	return total;
+}
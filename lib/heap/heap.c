@@ -160,6 +160,124 @@ static chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
 	return (mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* Size class front end.  Small chunks released by sys_heap_free() are
+ * parked on one LIFO list per chunk size rather than merged back into
+ * the buckets, so that the next allocation of that exact size is a
+ * simple pop.  Parked chunks keep their "used" bit, which stops
+ * free_chunk() from merging neighbours into them, and are linked
+ * through their FREE_NEXT field.  They are handed back to the heap
+ * proper when an allocation would otherwise fail.
+ */
+static inline bool size_class_eligible(chunksz_t sz)
+{
+	return sz <= CONFIG_SYS_HEAP_SIZE_CLASS_CHUNKS;
+}
+
+static bool size_class_push(struct z_heap *h, chunkid_t c)
+{
+	chunksz_t sz = chunk_size(h, c);
+
+	if (!size_class_eligible(sz) ||
+	    h->class_count[sz - 1] >= CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH) {
+		return false;
+	}
+
+	set_next_free_chunk(h, c, h->class_head[sz - 1]);
+	h->class_head[sz - 1] = c;
+	h->class_count[sz - 1]++;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes += chunksz_to_bytes(h, sz);
+#endif
+	return true;
+}
+
+static chunkid_t size_class_pop(struct z_heap *h, chunksz_t sz)
+{
+	chunkid_t c = h->class_head[sz - 1];
+
+	if (c != 0U) {
+		CHECK(chunk_used(h, c));
+		CHECK(chunk_size(h, c) == sz);
+
+		h->class_head[sz - 1] = next_free_chunk(h, c);
+		h->class_count[sz - 1]--;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		h->free_bytes -= chunksz_to_bytes(h, sz);
+#endif
+	}
+
+	return c;
+}
+
+/* Returns true if any parked chunk was given back to the heap */
+static bool size_class_flush(struct z_heap *h)
+{
+	bool flushed = false;
+	chunkid_t c;
+
+	for (chunksz_t sz = 1; sz <= CONFIG_SYS_HEAP_SIZE_CLASS_CHUNKS; sz++) {
+		while ((c = size_class_pop(h, sz)) != 0U) {
+			set_chunk_used(h, c, false);
+			free_chunk(h, c);
+			flushed = true;
+		}
+	}
+
+	return flushed;
+}
+
+#ifdef CONFIG_SYS_HEAP_VALIDATE
+static bool size_class_contains(struct z_heap *h, chunkid_t c)
+{
+	chunksz_t sz = chunk_size(h, c);
+
+	if (!size_class_eligible(sz)) {
+		return false;
+	}
+
+	for (chunkid_t i = h->class_head[sz - 1]; i != 0U;
+	     i = next_free_chunk(h, i)) {
+		if (i == c) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
+
+int sys_heap_size_class_stats_get(struct sys_heap *heap,
+				  struct sys_heap_size_class_stats *stats)
+{
+	if ((heap == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	struct z_heap *h = heap->heap;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	stats->hits = h->class_hits;
+	stats->misses = h->class_misses;
+#else
+	stats->hits = 0U;
+	stats->misses = 0U;
+#endif
+	stats->cached_chunks = 0U;
+	stats->cached_bytes = 0U;
+
+	for (chunksz_t sz = 1; sz <= CONFIG_SYS_HEAP_SIZE_CLASS_CHUNKS; sz++) {
+		stats->cached_chunks += h->class_count[sz - 1];
+		stats->cached_bytes += h->class_count[sz - 1] *
+				       chunksz_to_bytes(h, sz);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SYS_HEAP_SIZE_CLASSES */
+
 void sys_heap_free(struct sys_heap *heap, void *mem)
 {
 	if (mem == NULL) {
@@ -184,7 +302,15 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
+#if defined(CONFIG_SYS_HEAP_SIZE_CLASSES) && defined(CONFIG_SYS_HEAP_VALIDATE)
+	/* Parked chunks still look used, so the first check can't
+	 * catch a double free of one.  Walking the list is only worth
+	 * it when validating.
+	 */
+	__ASSERT(!size_class_contains(h, c),
+		 "unexpected heap state (double-free?) for memory at %p", mem);
+#endif
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
 #endif
@@ -194,6 +320,13 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 				  chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if (size_class_push(h, c)) {
+		return;
+	}
+#endif
+
+	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
 
@@ -257,6 +390,13 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 		return c;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Out of luck: give parked chunks back and try again */
+	if (size_class_flush(h)) {
+		return alloc_chunk(h, sz);
+	}
+#endif
+
 	return 0;
 }
 
@@ -270,19 +410,35 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes, 0);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
+	chunkid_t c = 0U;
 
-	if (c == 0U) {
-		return NULL;
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if (size_class_eligible(chunk_sz)) {
+		c = size_class_pop(h, chunk_sz);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		if (c != 0U) {
+			h->class_hits++;
+		} else {
+			h->class_misses++;
+		}
+#endif
 	}
+#endif
 
-	/* Split off remainder if any */
-	if (chunk_size(h, c) > chunk_sz) {
-		split_chunks(h, c, c + chunk_sz);
-		free_list_add(h, c + chunk_sz);
-	}
+	if (c == 0U) {
+		c = alloc_chunk(h, chunk_sz);
+		if (c == 0U) {
+			return NULL;
+		}
 
-	set_chunk_used(h, c, true);
+		/* Split off remainder if any */
+		if (chunk_size(h, c) > chunk_sz) {
+			split_chunks(h, c, c + chunk_sz);
+			free_list_add(h, c + chunk_sz);
+		}
+
+		set_chunk_used(h, c, true);
+	}
 
 	mem = chunk_mem(h, c);
 
@@ -571,6 +727,17 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 		h->buckets[i].next = 0;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	for (int i = 0; i < CONFIG_SYS_HEAP_SIZE_CLASS_CHUNKS; i++) {
+		h->class_head[i] = 0;
+		h->class_count[i] = 0;
+	}
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->class_hits = 0;
+	h->class_misses = 0;
+#endif
+#endif
+
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
 	set_left_chunk_size(h, 0, 0);
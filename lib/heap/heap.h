@@ -73,6 +73,14 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	chunkid_t class_head[CONFIG_SYS_HEAP_SIZE_CLASS_CHUNKS];
+	uint16_t class_count[CONFIG_SYS_HEAP_SIZE_CLASS_CHUNKS];
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	uint32_t class_hits;
+	uint32_t class_misses;
+#endif
 #endif
 	struct z_heap_bucket buckets[0];
 };
@@ -279,6 +287,16 @@ static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
 		}
 	}
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Chunks parked on the size class lists look used but are free */
+	for (int i = 0; i < CONFIG_SYS_HEAP_SIZE_CLASS_CHUNKS; i++) {
+		for (c = h->class_head[i]; c != 0U; c = next_free_chunk(h, c)) {
+			*alloc_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+		}
+	}
+#endif
 }
 
 #endif /* ZEPHYR_INCLUDE_LIB_OS_HEAP_H_ */
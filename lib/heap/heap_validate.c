@@ -85,6 +85,27 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/*
+	 * Parked chunks must be valid, marked used, of the size of
+	 * their class, and match the class count.
+	 */
+	for (int i = 0; i < CONFIG_SYS_HEAP_SIZE_CLASS_CHUNKS; i++) {
+		uint32_t n = 0;
+
+		for (c = h->class_head[i]; c != 0; n++, c = next_free_chunk(h, c)) {
+			if (n >= h->class_count[i] || !in_bounds(h, c) ||
+			    !chunk_used(h, c) || chunk_size(h, c) != i + 1) {
+				return false;
+			}
+		}
+
+		if (n != h->class_count[i]) {
+			return false;
+		}
+	}
+#endif
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	/*
 	 * Validate sys_heap_runtime_stats_get API.
@@ -0,0 +1,566 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/zvfs/epoll.h>
+
+#define ZVFS_EPOLL_EVENTS (ZVFS_EPOLLIN | ZVFS_EPOLLPRI | ZVFS_EPOLLOUT | \
+			   ZVFS_EPOLLERR | ZVFS_EPOLLHUP)
+
+/* Kernel objects a descriptor may need to be watched on, a TLS socket
+ * waits on its underlying socket as well.
+ */
+#define ZVFS_EPOLL_POLL_EVENTS 3
+
+struct zvfs_epoll;
+
+struct zvfs_epoll_item {
+	/* Node in the interest list of the instance */
+	sys_dnode_t node;
+	/* Node in the ready list of the instance */
+	sys_dnode_t ready_node;
+	/* Submitted to the system workqueue when one of the events triggers */
+	struct k_work_poll work;
+	struct k_poll_event pev[ZVFS_EPOLL_POLL_EVENTS];
+	int num_pev;
+	struct zvfs_epoll *ep;
+	/* Object the descriptor referred to when it was added */
+	void *obj;
+	int fd;
+	struct zvfs_epoll_event event;
+	bool queued;
+	bool disabled;
+};
+
+struct zvfs_epoll {
+	/* Serializes zvfs_epoll_ctl() and zvfs_epoll_wait() */
+	struct k_mutex mutex;
+	/* Protects the ready list, which is fed from the workqueue */
+	struct k_spinlock lock;
+	struct k_poll_signal sig;
+	sys_dlist_t items;
+	sys_dlist_t ready;
+	bool in_use;
+};
+
+SYS_BITARRAY_DEFINE_STATIC(eps_bitarray, CONFIG_ZVFS_EPOLL_MAX);
+static struct zvfs_epoll eps[CONFIG_ZVFS_EPOLL_MAX];
+
+SYS_BITARRAY_DEFINE_STATIC(items_bitarray, CONFIG_ZVFS_EPOLL_MAX_ITEMS);
+static struct zvfs_epoll_item items[CONFIG_ZVFS_EPOLL_MAX_ITEMS];
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable;
+
+static void zvfs_epoll_item_ready(struct zvfs_epoll_item *item)
+{
+	struct zvfs_epoll *ep = item->ep;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ep->lock);
+
+	if (!item->queued) {
+		sys_dlist_append(&ep->ready, &item->ready_node);
+		item->queued = true;
+	}
+
+	k_spin_unlock(&ep->lock, key);
+
+	k_poll_signal_raise(&ep->sig, 0);
+}
+
+static void zvfs_epoll_item_triggered(struct k_work *work)
+{
+	struct k_work_poll *pwork = CONTAINER_OF(work, struct k_work_poll, work);
+
+	zvfs_epoll_item_ready(CONTAINER_OF(pwork, struct zvfs_epoll_item, work));
+}
+
+/* Query the current state of the descriptor, leaving the kernel objects
+ * it depends on in item->pev.
+ */
+static int zvfs_epoll_item_check(struct zvfs_epoll_item *item, uint32_t *revents)
+{
+	const struct fd_op_vtable *vtable;
+	struct zvfs_pollfd pfd;
+	struct k_poll_event *pev;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	item->num_pev = 0;
+	*revents = 0;
+
+	obj = zvfs_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+	if (obj == NULL || obj != item->obj) {
+		*revents = ZVFS_EPOLLNVAL;
+		return 0;
+	}
+
+	pfd.fd = item->fd;
+	pfd.events = item->event.events & ZVFS_EPOLL_EVENTS;
+	pfd.revents = 0;
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	pev = item->pev;
+	ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				      item->pev + ARRAY_SIZE(item->pev));
+	if (ret == -EALREADY) {
+		ret = 0;
+	} else if (ret == -EXDEV) {
+		/* Offloaded sockets have their own poll implementation */
+		ret = -EPERM;
+	}
+
+	if (ret < 0) {
+		goto unlock;
+	}
+
+	item->num_pev = pev - item->pev;
+	if (item->num_pev > 0) {
+		/* Only updates the state of the events */
+		(void)k_poll(item->pev, item->num_pev, K_NO_WAIT);
+	}
+
+	pev = item->pev;
+	ret = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_UPDATE, &pfd, &pev);
+	if (ret == -EAGAIN) {
+		/* Not ready after all, e.g. a partial TLS record */
+		ret = 0;
+	} else if (ret == 0) {
+		*revents = (uint16_t)pfd.revents;
+	}
+
+unlock:
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+/* Queue the item if the descriptor is ready, otherwise watch its kernel
+ * objects until one of them changes state.
+ */
+static int zvfs_epoll_item_arm(struct zvfs_epoll_item *item)
+{
+	uint32_t revents;
+	int ret;
+
+	if (item->disabled) {
+		return 0;
+	}
+
+	ret = zvfs_epoll_item_check(item, &revents);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (revents != 0) {
+		zvfs_epoll_item_ready(item);
+		return 0;
+	}
+
+	return k_work_poll_submit(&item->work, item->pev, item->num_pev, K_FOREVER);
+}
+
+static void zvfs_epoll_item_disarm(struct zvfs_epoll_item *item)
+{
+	struct zvfs_epoll *ep = item->ep;
+	struct k_work_sync sync;
+	k_spinlock_key_t key;
+
+	(void)k_work_poll_cancel(&item->work);
+	(void)k_work_cancel_sync(&item->work.work, &sync);
+
+	/* The work may have been cancelled while pending, start afresh */
+	k_work_poll_init(&item->work, zvfs_epoll_item_triggered);
+
+	key = k_spin_lock(&ep->lock);
+
+	if (item->queued) {
+		sys_dlist_remove(&item->ready_node);
+		item->queued = false;
+	}
+
+	k_spin_unlock(&ep->lock, key);
+}
+
+static struct zvfs_epoll_item *zvfs_epoll_item_alloc(struct zvfs_epoll *ep)
+{
+	struct zvfs_epoll_item *item;
+	size_t offset;
+
+	if (sys_bitarray_alloc(&items_bitarray, 1, &offset) < 0) {
+		return NULL;
+	}
+
+	item = &items[offset];
+	*item = (struct zvfs_epoll_item){ .ep = ep };
+
+	sys_dnode_init(&item->ready_node);
+	k_work_poll_init(&item->work, zvfs_epoll_item_triggered);
+	sys_dlist_append(&ep->items, &item->node);
+
+	return item;
+}
+
+static void zvfs_epoll_item_free(struct zvfs_epoll_item *item)
+{
+	int err;
+
+	zvfs_epoll_item_disarm(item);
+	sys_dlist_remove(&item->node);
+
+	err = sys_bitarray_free(&items_bitarray, 1, item - items);
+	__ASSERT(err == 0, "sys_bitarray_free() failed: %d", err);
+}
+
+static struct zvfs_epoll_item *zvfs_epoll_item_find(struct zvfs_epoll *ep, int fd)
+{
+	struct zvfs_epoll_item *item;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&ep->items, item, node) {
+		if (item->fd == fd) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+/* Go through the ready list only, rearming the descriptors that are not
+ * ready anymore. Level-triggered descriptors that are reported are put
+ * back at the end of the list, to be checked again by the next call.
+ */
+static int zvfs_epoll_collect(struct zvfs_epoll *ep, struct zvfs_epoll_event *events,
+			      int maxevents)
+{
+	struct zvfs_epoll_item *item;
+	sys_dlist_t reported;
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	uint32_t revents;
+	int count = 0;
+	int ret;
+
+	sys_dlist_init(&reported);
+
+	key = k_spin_lock(&ep->lock);
+
+	while (count < maxevents && (node = sys_dlist_get(&ep->ready)) != NULL) {
+		item = CONTAINER_OF(node, struct zvfs_epoll_item, ready_node);
+		item->queued = false;
+
+		k_spin_unlock(&ep->lock, key);
+
+		ret = zvfs_epoll_item_check(item, &revents);
+		if (ret < 0) {
+			revents = ZVFS_EPOLLERR;
+		}
+
+		if (revents == 0) {
+			(void)k_work_poll_submit(&item->work, item->pev, item->num_pev,
+						 K_FOREVER);
+		} else {
+			events[count].events = revents;
+			events[count].data = item->event.data;
+			count++;
+
+			if ((item->event.events & ZVFS_EPOLLONESHOT) ||
+			    (revents & ZVFS_EPOLLNVAL) || ret < 0) {
+				item->disabled = true;
+			}
+		}
+
+		key = k_spin_lock(&ep->lock);
+
+		if (revents != 0 && !item->disabled && !item->queued) {
+			sys_dlist_append(&reported, &item->ready_node);
+			item->queued = true;
+		}
+	}
+
+	while ((node = sys_dlist_get(&reported)) != NULL) {
+		sys_dlist_append(&ep->ready, node);
+	}
+
+	if (sys_dlist_is_empty(&ep->ready)) {
+		k_poll_signal_reset(&ep->sig);
+	}
+
+	k_spin_unlock(&ep->lock, key);
+
+	return count;
+}
+
+static int zvfs_epoll_close_op(void *obj)
+{
+	struct zvfs_epoll *ep = (struct zvfs_epoll *)obj;
+	struct zvfs_epoll_item *item, *next;
+	int err;
+
+	(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->items, item, next, node) {
+		zvfs_epoll_item_free(item);
+	}
+
+	ep->in_use = false;
+
+	err = sys_bitarray_free(&eps_bitarray, 1, ep - eps);
+	__ASSERT(err == 0, "sys_bitarray_free() failed: %d", err);
+
+	k_mutex_unlock(&ep->mutex);
+
+	/* Wake up the waiters, they will notice the instance is gone */
+	k_poll_signal_raise(&ep->sig, 0);
+
+	return 0;
+}
+
+static int zvfs_epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	struct zvfs_epoll *ep = (struct zvfs_epoll *)obj;
+	int ret = 0;
+
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE: {
+		struct zvfs_pollfd *pfd;
+		struct k_poll_event **pev;
+		struct k_poll_event *pev_end;
+
+		pfd = va_arg(args, struct zvfs_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+		pev_end = va_arg(args, struct k_poll_event *);
+
+		if (pfd->events & ZVFS_POLLIN) {
+			if (*pev == pev_end) {
+				return -ENOMEM;
+			}
+
+			k_poll_event_init(*pev, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+					  &ep->sig);
+			(*pev)++;
+		}
+	} break;
+
+	case ZFD_IOCTL_POLL_UPDATE: {
+		struct zvfs_pollfd *pfd;
+		struct k_poll_event **pev;
+		k_spinlock_key_t key;
+
+		pfd = va_arg(args, struct zvfs_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+
+		if (pfd->events & ZVFS_POLLIN) {
+			key = k_spin_lock(&ep->lock);
+			pfd->revents |= ZVFS_POLLIN * !sys_dlist_is_empty(&ep->ready);
+			k_spin_unlock(&ep->lock, key);
+			(*pev)++;
+		}
+	} break;
+
+	default:
+		errno = EOPNOTSUPP;
+		ret = -1;
+		break;
+	}
+
+	return ret;
+}
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable = {
+	.close = zvfs_epoll_close_op,
+	.ioctl = zvfs_epoll_ioctl_op,
+};
+
+/*
+ * Public-facing API
+ */
+
+int zvfs_epoll_create(int flags)
+{
+	struct zvfs_epoll *ep;
+	size_t offset;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sys_bitarray_alloc(&eps_bitarray, 1, &offset) < 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ep = &eps[offset];
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		sys_bitarray_free(&eps_bitarray, 1, offset);
+		return -1;
+	}
+
+	k_mutex_init(&ep->mutex);
+	k_poll_signal_init(&ep->sig);
+	sys_dlist_init(&ep->items);
+	sys_dlist_init(&ep->ready);
+	ep->in_use = true;
+
+	zvfs_finalize_fd(fd, ep, &zvfs_epoll_fd_vtable);
+
+	return fd;
+}
+
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event)
+{
+	struct zvfs_epoll_item *item;
+	struct zvfs_epoll *ep;
+	void *obj;
+	int ret = 0;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (fd == epfd) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (op != ZVFS_EPOLL_CTL_DEL) {
+		if (event == NULL) {
+			errno = EFAULT;
+			return -1;
+		}
+
+		if (event->events & ~(ZVFS_EPOLL_EVENTS | ZVFS_EPOLLONESHOT)) {
+			/* Edge-triggered mode is not supported */
+			errno = EINVAL;
+			return -1;
+		}
+	}
+
+	(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+
+	item = zvfs_epoll_item_find(ep, fd);
+
+	switch (op) {
+	case ZVFS_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		obj = zvfs_get_fd_obj(fd, NULL, EBADF);
+		if (obj == NULL) {
+			ret = -errno;
+			break;
+		}
+
+		item = zvfs_epoll_item_alloc(ep);
+		if (item == NULL) {
+			ret = -ENOSPC;
+			break;
+		}
+
+		item->obj = obj;
+		item->fd = fd;
+		item->event = *event;
+
+		ret = zvfs_epoll_item_arm(item);
+		if (ret < 0) {
+			zvfs_epoll_item_free(item);
+		}
+
+		break;
+
+	case ZVFS_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		zvfs_epoll_item_disarm(item);
+
+		item->event = *event;
+		item->disabled = false;
+
+		ret = zvfs_epoll_item_arm(item);
+		break;
+
+	case ZVFS_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		zvfs_epoll_item_free(item);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&ep->mutex);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout)
+{
+	struct k_poll_event pev;
+	struct zvfs_epoll *ep;
+	k_timepoint_t end;
+	int ret;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	while (true) {
+		(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+
+		if (!ep->in_use) {
+			k_mutex_unlock(&ep->mutex);
+			errno = EBADF;
+			return -1;
+		}
+
+		ret = zvfs_epoll_collect(ep, events, maxevents);
+
+		k_mutex_unlock(&ep->mutex);
+
+		if (ret > 0 || sys_timepoint_expired(end)) {
+			return ret;
+		}
+
+		k_poll_event_init(&pev, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &ep->sig);
+
+		ret = k_poll(&pev, 1, sys_timepoint_timeout(end));
+		if (ret == -EAGAIN) {
+			return 0;
+		}
+	}
+}
@@ -61,6 +61,20 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+#if defined(CONFIG_NET_CONN_HASH)
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_NET_CONN_HASH_SIZE),
+	     "CONFIG_NET_CONN_HASH_SIZE must be a power of two");
+
+/* Used UDP and TCP connections with a local port are also linked in a
+ * bucket of conn_hash, selected by the remote address and both ports for
+ * connected ones and by the local port for the others. All the remaining
+ * connections are linked in conn_wildcard.
+ */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_SIZE];
+static sys_slist_t conn_wildcard;
+static uint32_t conn_order;
+#endif
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -113,6 +127,84 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+static uint32_t conn_hash_mix(uint32_t hash, uint32_t val)
+{
+	hash = (hash ^ val) * 0x9e3779b1U;
+
+	return hash ^ (hash >> 15);
+}
+
+/* Ports are in network byte order */
+static uint32_t conn_hash_bound(uint16_t proto, uint16_t local_port)
+{
+	return conn_hash_mix(proto, local_port) & (CONFIG_NET_CONN_HASH_SIZE - 1);
+}
+
+static uint32_t conn_hash_connected(uint16_t proto, uint16_t local_port,
+				    uint16_t remote_port,
+				    const uint8_t *remote_addr, size_t addr_len)
+{
+	uint32_t hash = conn_hash_mix(proto, local_port | ((uint32_t)remote_port << 16));
+
+	for (size_t i = 0; i < addr_len; i += sizeof(uint32_t)) {
+		hash = conn_hash_mix(hash, UNALIGNED_GET((const uint32_t *)&remote_addr[i]));
+	}
+
+	return hash & (CONFIG_NET_CONN_HASH_SIZE - 1);
+}
+
+/* The bucket must only depend on what conn_is_matching() requires to be
+ * equal in the packet, not on the rank flags.
+ */
+static sys_slist_t *conn_hash_list(struct net_conn *conn)
+{
+	uint16_t local_port = net_sin(&conn->local_addr)->sin_port;
+	uint16_t remote_port = net_sin(&conn->remote_addr)->sin_port;
+	struct sockaddr *remote = &conn->remote_addr;
+
+	if ((conn->family != AF_INET && conn->family != AF_INET6) ||
+	    (conn->proto != IPPROTO_UDP && conn->proto != IPPROTO_TCP) ||
+	    conn->type == SOCK_RAW || local_port == 0U) {
+		return &conn_wildcard;
+	}
+
+	if (remote_port != 0U && (conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
+		if (IS_ENABLED(CONFIG_NET_IPV6) && remote->sa_family == AF_INET6 &&
+		    !net_ipv6_is_addr_unspecified(&net_sin6(remote)->sin6_addr)) {
+			return &conn_hash[conn_hash_connected(
+				conn->proto, local_port, remote_port,
+				net_sin6(remote)->sin6_addr.s6_addr,
+				sizeof(struct in6_addr))];
+		}
+
+		if (IS_ENABLED(CONFIG_NET_IPV4) && remote->sa_family == AF_INET &&
+		    net_sin(remote)->sin_addr.s_addr != 0U) {
+			return &conn_hash[conn_hash_connected(
+				conn->proto, local_port, remote_port,
+				net_sin(remote)->sin_addr.s4_addr,
+				sizeof(struct in_addr))];
+		}
+	}
+
+	return &conn_hash[conn_hash_bound(conn->proto, local_port)];
+}
+
+/* Called with conn_lock held */
+static void conn_hash_add(struct net_conn *conn)
+{
+	sys_slist_prepend(conn_hash_list(conn), &conn->hash_node);
+}
+
+static void conn_hash_del(struct net_conn *conn)
+{
+	sys_slist_find_and_remove(conn_hash_list(conn), &conn->hash_node);
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_del(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -138,6 +230,10 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+#if defined(CONFIG_NET_CONN_HASH)
+	conn->order = conn_order++;
+#endif
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -463,6 +559,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_del(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -489,14 +586,19 @@ int net_conn_update(struct net_conn_handle *handle,
 		return -ENOENT;
 	}
 
+	/* The connection may move to another hash bucket */
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	conn_hash_del(conn);
+
 	net_conn_change_callback(conn, cb, user_data);
 
 	ret = net_conn_change_local(conn, local_addr, local_port);
-	if (ret < 0) {
-		return ret;
+	if (ret == 0) {
+		ret = net_conn_change_remote(conn, remote_addr, remote_port);
 	}
 
-	ret = net_conn_change_remote(conn, remote_addr, remote_port);
+	conn_hash_add(conn);
+	k_mutex_unlock(&conn_lock);
 
 	return ret;
 }
@@ -608,6 +710,158 @@ static bool is_iface_matching(struct net_conn *conn, struct net_pkt *pkt)
 	return (net_pkt_iface(pkt) == net_context_get_iface(conn->context));
 }
 
+/* Is the TCP/UDP packet accepted by the candidate connection? */
+static bool conn_is_matching(struct net_conn *conn, struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr, uint8_t proto,
+			     uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+
+	/* Is the candidate connection matching the packet's interface? */
+	if (!is_iface_matching(conn, pkt)) {
+		return false; /* wrong interface */
+	}
+
+	/* Is the candidate connection matching the packet's protocol family? */
+	if (conn->family != AF_UNSPEC && conn->family != pkt_family) {
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
+			      !conn->v6only && conn->type != SOCK_RAW)) {
+				return false;
+			}
+		} else {
+			return false; /* wrong protocol family */
+		}
+
+		/* We might have a match for v4-to-v6 mapping, check more */
+	}
+
+	/* Is the candidate connection matching the packet's protocol within the family? */
+	if (conn->proto != proto) {
+		return false; /* wrong protocol */
+	}
+
+	/* Apply protocol-specific matching criteria... */
+	uint8_t conn_family = conn->family;
+
+	if (!(IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) ||
+	    !(conn_family == AF_INET || conn_family == AF_INET6 ||
+	      conn_family == AF_UNSPEC)) {
+		return false;
+	}
+
+	/* Is the candidate connection matching the packet's TCP/UDP
+	 * address and port?
+	 */
+	if (net_sin(&conn->remote_addr)->sin_port &&
+	    net_sin(&conn->remote_addr)->sin_port != src_port) {
+		return false; /* wrong remote port */
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port &&
+	    net_sin(&conn->local_addr)->sin_port != dst_port) {
+		return false; /* wrong local port */
+	}
+
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+		return false; /* wrong remote address */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+		/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+		 * has no IPV6_V6ONLY option set and if the local IPV6 address
+		 * is unspecified, then we could accept a connection from IPv4
+		 * address by mapping it to IPv6 address.
+		 */
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
+			      !conn->v6only &&
+			      net_ipv6_is_addr_unspecified(
+				      &net_sin6(&conn->local_addr)->sin6_addr))) {
+				return false; /* wrong local address */
+			}
+		} else {
+			return false; /* wrong local address */
+		}
+
+		/* We might have a match for v4-to-v6 mapping,
+		 * continue with rank checking.
+		 */
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+static bool conn_is_better(struct net_conn *conn, struct net_conn *best)
+{
+	if (NET_CONN_RANK(conn->flags) != NET_CONN_RANK(best->flags)) {
+		return NET_CONN_RANK(conn->flags) > NET_CONN_RANK(best->flags);
+	}
+
+	/* Same as with the list of used connections, newest first */
+	return (int32_t)(conn->order - best->order) > 0;
+}
+
+/* Only the buckets the packet could be hashed to and the wildcard list
+ * are checked, with the same matching and ranking rules as the full list.
+ */
+static struct net_conn *conn_hash_lookup(struct net_pkt *pkt,
+					 union net_ip_header *ip_hdr,
+					 uint8_t proto, uint16_t src_port,
+					 uint16_t dst_port)
+{
+	struct net_conn *best_match = NULL;
+	struct net_conn *conn;
+	sys_slist_t *lists[3];
+	const uint8_t *src;
+	size_t addr_len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		src = ip_hdr->ipv6->src;
+		addr_len = sizeof(struct in6_addr);
+	} else {
+		src = ip_hdr->ipv4->src;
+		addr_len = sizeof(struct in_addr);
+	}
+
+	lists[0] = &conn_hash[conn_hash_connected(proto, dst_port, src_port,
+						  src, addr_len)];
+	lists[1] = &conn_hash[conn_hash_bound(proto, dst_port)];
+	lists[2] = &conn_wildcard;
+
+	ARRAY_FOR_EACH(lists, i) {
+		if (i == 1 && lists[1] == lists[0]) {
+			continue;
+		}
+
+		SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, hash_node) {
+			if (!conn_is_matching(conn, pkt, ip_hdr, proto,
+					      src_port, dst_port)) {
+				continue;
+			}
+
+			if (best_match == NULL || conn_is_better(conn, best_match)) {
+				best_match = conn;
+			}
+		}
+	}
+
+	return best_match;
+}
+#else
+static inline struct net_conn *conn_hash_lookup(struct net_pkt *pkt,
+						union net_ip_header *ip_hdr,
+						uint8_t proto, uint16_t src_port,
+						uint16_t dst_port)
+{
+	return NULL;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 #if defined(CONFIG_NET_SOCKETS_PACKET) || defined(CONFIG_NET_SOCKETS_INET_RAW)
 static void conn_raw_socket_deliver(struct net_pkt *pkt, struct net_conn *conn,
 				    bool is_ip)
@@ -936,77 +1190,13 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		/* Is the candidate connection matching the packet's interface? */
-		if (!is_iface_matching(conn, pkt)) {
-			continue; /* wrong interface */
-		}
-
-		/* Is the candidate connection matching the packet's protocol family? */
-		if (conn->family != AF_UNSPEC && conn->family != pkt_family) {
-			if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-				if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-				      !conn->v6only && conn->type != SOCK_RAW)) {
-					continue;
-				}
-			} else {
-				continue; /* wrong protocol family */
-			}
-
-			/* We might have a match for v4-to-v6 mapping, check more */
-		}
-
-		/* Is the candidate connection matching the packet's protocol within the family? */
-		if (conn->proto != proto) {
-			continue; /* wrong protocol */
-		}
-
-		/* Apply protocol-specific matching criteria... */
-		uint8_t conn_family = conn->family;
-
-		if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
-		    (conn_family == AF_INET || conn_family == AF_INET6 ||
-		     conn_family == AF_UNSPEC)) {
-			/* Is the candidate connection matching the packet's TCP/UDP
-			 * address and port?
-			 */
-			if (net_sin(&conn->remote_addr)->sin_port &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
+	if (IS_ENABLED(CONFIG_NET_CONN_HASH) && !is_mcast_pkt) {
+		best_match = conn_hash_lookup(pkt, ip_hdr, proto, src_port, dst_port);
+	} else {
+		SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+			if (!conn_is_matching(conn, pkt, ip_hdr, proto,
+					      src_port, dst_port)) {
+				continue;
 			}
 
 			if (best_rank < NET_CONN_RANK(conn->flags)) {
@@ -1036,8 +1226,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 					goto drop;
 				}
 
-				if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
-				    NET_DROP) {
+				if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr,
+					     conn->user_data) == NET_DROP) {
 					net_stats_update_per_proto_drop(pkt_iface, proto);
 					net_pkt_unref(mcast_pkt);
 				} else {
@@ -1046,8 +1236,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 				mcast_pkt_delivered = true;
 			}
-		}
-	} /* loop end */
+		} /* loop end */
+	}
 
 	if (best_match != NULL) {
 		cb = best_match->cb;
@@ -1118,6 +1308,14 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	ARRAY_FOR_EACH(conn_hash, i) {
+		sys_slist_init(&conn_hash[i]);
+	}
+
+	sys_slist_init(&conn_wildcard);
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
@@ -54,6 +54,14 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Internal slist node of the lookup hash table */
+	sys_snode_t hash_node;
+
+	/** Registration order, the newest handler wins ties in lookups */
+	uint32_t order;
+#endif
+
 	/** Remote socket address */
 	struct sockaddr remote_addr;
 
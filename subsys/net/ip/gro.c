@@ -0,0 +1,389 @@
+/** @file
+ * @brief Generic receive offload
+ *
+ * Coalesces in-order TCP segments of a connection, received in one
+ * batch, into a single packet before they reach the IP layer.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_gro, CONFIG_NET_CORE_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/ethernet.h>
+
+#include "net_private.h"
+#include "net_stats.h"
+#include "gro.h"
+
+/* TCP flags of the segments that can be coalesced */
+#define GRO_TCP_PSH 0x08
+#define GRO_TCP_ACK 0x10
+
+/* Headers of a TCP packet, contiguous in its first buffer */
+struct gro_hdrs {
+	uint8_t *ip;
+	struct net_tcp_hdr *tcp;
+	uint16_t ip_len;
+	uint16_t hdr_len;
+	uint16_t len;
+	uint32_t seq;
+	sa_family_t family;
+};
+
+/* Like process_l3(), only look at the IP header of packets that L2 says
+ * are IP. A CAN frame or a packet socket frame could start with anything.
+ */
+static bool gro_is_ip(struct net_pkt *pkt, uint8_t version)
+{
+	uint8_t family = net_pkt_family(pkt);
+	uint16_t ptype = net_pkt_ll_proto_type(pkt);
+
+	if (family != AF_INET && family != AF_INET6 && family != AF_UNSPEC) {
+		return false;
+	}
+
+	if (version == 0x40) {
+		return family != AF_INET6 && (ptype == 0U || ptype == NET_ETH_PTYPE_IP);
+	}
+
+	return family != AF_INET && (ptype == 0U || ptype == NET_ETH_PTYPE_IPV6);
+}
+
+static bool gro_parse(struct net_pkt *pkt, struct gro_hdrs *h)
+{
+	struct net_buf *buf = pkt->buffer;
+	uint8_t version;
+	uint8_t th_off;
+
+	if (buf == NULL || buf->len == 0U) {
+		return false;
+	}
+
+	h->ip = buf->data;
+	version = h->ip[0] & 0xf0;
+
+	if ((version != 0x40 && version != 0x60) || !gro_is_ip(pkt, version)) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && version == 0x40) {
+		struct net_ipv4_hdr *ip = (struct net_ipv4_hdr *)h->ip;
+
+		/* No options and no fragments */
+		if (buf->len < NET_IPV4H_LEN || ip->vhl != 0x45 ||
+		    ip->proto != IPPROTO_TCP ||
+		    (sys_get_be16(ip->offset) &
+		     (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK))) {
+			return false;
+		}
+
+		h->family = AF_INET;
+		h->ip_len = NET_IPV4H_LEN;
+		h->len = ntohs(ip->len);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && version == 0x60) {
+		struct net_ipv6_hdr *ip = (struct net_ipv6_hdr *)h->ip;
+
+		/* No extension headers */
+		if (buf->len < NET_IPV6H_LEN || ip->nexthdr != IPPROTO_TCP) {
+			return false;
+		}
+
+		h->family = AF_INET6;
+		h->ip_len = NET_IPV6H_LEN;
+		h->len = NET_IPV6H_LEN + ntohs(ip->len);
+	} else {
+		return false;
+	}
+
+	if (buf->len < h->ip_len + NET_TCPH_LEN) {
+		return false;
+	}
+
+	h->tcp = (struct net_tcp_hdr *)(h->ip + h->ip_len);
+	th_off = h->tcp->offset >> 4;
+	h->hdr_len = h->ip_len + th_off * 4U;
+
+	if (th_off < NET_TCPH_LEN / 4U || buf->len < h->hdr_len ||
+	    h->len < h->hdr_len || net_pkt_get_len(pkt) < h->len) {
+		return false;
+	}
+
+	h->seq = sys_get_be32(h->tcp->seq);
+
+	return true;
+}
+
+/* Only data segments without any flag but ACK and PSH are coalesced */
+static bool gro_is_data(const struct gro_hdrs *h)
+{
+	return h->len > h->hdr_len &&
+	       (h->tcp->flags & GRO_TCP_ACK) &&
+	       !(h->tcp->flags & ~(GRO_TCP_ACK | GRO_TCP_PSH));
+}
+
+static void gro_flow_hdrs(struct net_gro_flow *flow, struct gro_hdrs *h)
+{
+	h->ip = flow->pkt->buffer->data;
+	h->family = net_pkt_family(flow->pkt);
+	h->ip_len = net_pkt_ip_hdr_len(flow->pkt);
+	h->tcp = (struct net_tcp_hdr *)(h->ip + h->ip_len);
+	h->hdr_len = flow->hdr_len;
+	h->len = flow->len;
+	h->seq = flow->next_seq;
+}
+
+static bool gro_same_conn(struct net_gro_flow *flow, struct net_pkt *pkt,
+			  const struct gro_hdrs *h)
+{
+	struct gro_hdrs f;
+
+	if (net_pkt_iface(flow->pkt) != net_pkt_iface(pkt)) {
+		return false;
+	}
+
+	gro_flow_hdrs(flow, &f);
+
+	if (f.family != h->family ||
+	    f.tcp->src_port != h->tcp->src_port ||
+	    f.tcp->dst_port != h->tcp->dst_port) {
+		return false;
+	}
+
+	if (h->family == AF_INET) {
+		return memcmp(((struct net_ipv4_hdr *)f.ip)->src,
+			      ((struct net_ipv4_hdr *)h->ip)->src,
+			      2 * sizeof(struct in_addr)) == 0;
+	}
+
+	return memcmp(((struct net_ipv6_hdr *)f.ip)->src,
+		      ((struct net_ipv6_hdr *)h->ip)->src,
+		      2 * sizeof(struct in6_addr)) == 0;
+}
+
+static struct net_gro_flow *gro_flow_find(struct net_gro *gro,
+					  struct net_pkt *pkt,
+					  const struct gro_hdrs *h)
+{
+	for (int i = 0; i < gro->count; i++) {
+		if (gro_same_conn(&gro->flows[i], pkt, h)) {
+			return &gro->flows[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* The segment directly follows the held data and only differs from the
+ * held packet by its sequence number, length, window and PSH flag.
+ */
+static bool gro_can_merge(struct net_gro_flow *flow, const struct gro_hdrs *h)
+{
+	struct gro_hdrs f;
+
+	gro_flow_hdrs(flow, &f);
+
+	if (h->seq != flow->next_seq || h->hdr_len != f.hdr_len ||
+	    (uint32_t)flow->len + (h->len - h->hdr_len) > UINT16_MAX) {
+		return false;
+	}
+
+	if (memcmp(f.tcp->ack, h->tcp->ack, sizeof(f.tcp->ack)) != 0 ||
+	    memcmp(f.tcp->optdata, h->tcp->optdata,
+		   h->hdr_len - h->ip_len - NET_TCPH_LEN) != 0) {
+		return false;
+	}
+
+	if (h->family == AF_INET) {
+		struct net_ipv4_hdr *a = (struct net_ipv4_hdr *)f.ip;
+		struct net_ipv4_hdr *b = (struct net_ipv4_hdr *)h->ip;
+
+		return a->tos == b->tos && a->ttl == b->ttl &&
+		       memcmp(a->offset, b->offset, sizeof(a->offset)) == 0;
+	}
+
+	/* Version, traffic class, flow label and hop limit */
+	return memcmp(f.ip, h->ip, 4) == 0 &&
+	       ((struct net_ipv6_hdr *)f.ip)->hop_limit ==
+	       ((struct net_ipv6_hdr *)h->ip)->hop_limit;
+}
+
+/* Checksums cannot be verified anymore once segments are coalesced, so
+ * do it here, as the IP and TCP layers would.
+ */
+static bool gro_chksum_ok(struct net_pkt *pkt, const struct gro_hdrs *h)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+
+	net_pkt_set_family(pkt, h->family);
+	net_pkt_set_ip_hdr_len(pkt, h->ip_len);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && h->family == AF_INET) {
+		net_pkt_set_ipv4_opts_len(pkt, 0);
+
+		if (net_if_need_calc_rx_checksum(iface, NET_IF_CHECKSUM_IPV4_HEADER) &&
+		    net_calc_chksum_ipv4(pkt) != 0U) {
+			return false;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6)) {
+		net_pkt_set_ipv6_ext_len(pkt, 0);
+	}
+
+	/* Drop the link layer padding */
+	if (net_pkt_get_len(pkt) > h->len && net_pkt_update_length(pkt, h->len) < 0) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
+	    net_if_need_calc_rx_checksum(iface, h->family == AF_INET6 ?
+					 NET_IF_CHECKSUM_IPV6_TCP :
+					 NET_IF_CHECKSUM_IPV4_TCP) &&
+	    net_calc_chksum_tcp(pkt) != 0U) {
+		return false;
+	}
+
+	return true;
+}
+
+static void gro_merge(struct net_gro_flow *flow, struct net_pkt *pkt,
+		      const struct gro_hdrs *h)
+{
+	uint16_t data_len = h->len - h->hdr_len;
+	struct gro_hdrs f;
+
+	gro_flow_hdrs(flow, &f);
+
+	memcpy(f.tcp->wnd, h->tcp->wnd, sizeof(f.tcp->wnd));
+	f.tcp->flags |= h->tcp->flags;
+
+	/* Keep the data only and chain it to the held packet */
+	net_buf_pull(pkt->buffer, h->hdr_len);
+	if (pkt->buffer->len == 0U) {
+		pkt->buffer = net_buf_frag_del(NULL, pkt->buffer);
+	}
+
+	net_pkt_append_buffer(flow->pkt, pkt->buffer);
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	flow->len += data_len;
+	flow->next_seq += data_len;
+	flow->segs++;
+}
+
+static void gro_flow_flush(struct net_gro *gro, struct net_gro_flow *flow)
+{
+	struct net_pkt *pkt = flow->pkt;
+	struct gro_hdrs f;
+
+	if (flow->segs > 1U) {
+		gro_flow_hdrs(flow, &f);
+
+		if (f.family == AF_INET) {
+			struct net_ipv4_hdr *ip = (struct net_ipv4_hdr *)f.ip;
+
+			ip->len = htons(flow->len);
+
+			if (net_if_need_calc_rx_checksum(net_pkt_iface(pkt),
+							 NET_IF_CHECKSUM_IPV4_HEADER)) {
+				ip->chksum = 0U;
+				ip->chksum = net_calc_chksum_ipv4(pkt);
+			}
+		} else {
+			((struct net_ipv6_hdr *)f.ip)->len =
+				htons(flow->len - NET_IPV6H_LEN);
+		}
+	}
+
+	gro->count--;
+	memmove(flow, flow + 1,
+		(&gro->flows[gro->count] - flow) * sizeof(*flow));
+
+	net_stats_update_gro_flushed(net_pkt_iface(pkt));
+
+	net_pkt_cursor_init(pkt);
+	net_process_gro_packet(pkt);
+}
+
+void net_gro_init(struct net_gro *gro)
+{
+	memset(gro, 0, sizeof(*gro));
+}
+
+enum net_verdict net_gro_receive(struct net_gro *gro, struct net_pkt *pkt)
+{
+	struct net_gro_flow *flow;
+	struct gro_hdrs h;
+
+	if (!gro_parse(pkt, &h)) {
+		return NET_CONTINUE;
+	}
+
+	flow = gro_flow_find(gro, pkt, &h);
+
+	if (!gro_is_data(&h) || !gro_chksum_ok(pkt, &h)) {
+		goto pass;
+	}
+
+	net_pkt_set_gro_chksum_ok(pkt, true);
+
+	if (flow != NULL && gro_can_merge(flow, &h)) {
+		bool push = h.tcp->flags & GRO_TCP_PSH;
+
+		gro_merge(flow, pkt, &h);
+		net_stats_update_gro_merged(net_pkt_iface(flow->pkt));
+
+		/* The sender has nothing more to add for now */
+		if (push) {
+			gro_flow_flush(gro, flow);
+		}
+
+		return NET_OK;
+	}
+
+	if (flow != NULL) {
+		gro_flow_flush(gro, flow);
+	}
+
+	if (h.tcp->flags & GRO_TCP_PSH) {
+		return NET_CONTINUE;
+	}
+
+	if (gro->count == ARRAY_SIZE(gro->flows)) {
+		gro_flow_flush(gro, &gro->flows[0]);
+	}
+
+	flow = &gro->flows[gro->count++];
+	flow->pkt = pkt;
+	flow->next_seq = h.seq + (h.len - h.hdr_len);
+	flow->hdr_len = h.hdr_len;
+	flow->len = h.len;
+	flow->segs = 1U;
+
+	net_stats_update_gro_held(net_pkt_iface(pkt));
+
+	return NET_OK;
+
+pass:
+	/* Keep the order of the segments of the connection */
+	if (flow != NULL) {
+		gro_flow_flush(gro, flow);
+	}
+
+	return NET_CONTINUE;
+}
+
+void net_gro_flush(struct net_gro *gro)
+{
+	while (gro->count > 0U) {
+		gro_flow_flush(gro, &gro->flows[0]);
+	}
+}
@@ -0,0 +1,89 @@
+/** @file
+ * @brief Generic receive offload
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __GRO_H
+#define __GRO_H
+
+#include <zephyr/types.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+
+struct net_gro_flow {
+	/** Held packet, starting at its IP header */
+	struct net_pkt *pkt;
+
+	/** Sequence number the next segment must start with */
+	uint32_t next_seq;
+
+	/** Length of the IP and TCP headers */
+	uint16_t hdr_len;
+
+	/** Total length of the held packet */
+	uint16_t len;
+
+	/** Number of segments coalesced in the held packet */
+	uint8_t segs;
+};
+
+/** @endcond */
+
+/**
+ * @brief Coalescing state of an RX thread.
+ *
+ * Packets are only held between net_gro_receive() calls of the same
+ * batch, the owner calls net_gro_flush() once the batch is done.
+ */
+struct net_gro {
+	struct net_gro_flow flows[CONFIG_NET_GRO_MAX_FLOWS];
+	uint8_t count;
+};
+
+/**
+ * @brief Initialize the coalescing state.
+ *
+ * @param gro Coalescing state.
+ */
+void net_gro_init(struct net_gro *gro);
+
+/**
+ * @brief Try to coalesce a received packet.
+ *
+ * The packet has been processed by the L2 and starts at its IP header.
+ * In-order TCP data segments are held, or appended to the held packet
+ * of the same connection. A packet that is not held is processed by the
+ * caller, after any held packet of the same connection was passed on.
+ *
+ * @param gro Coalescing state.
+ * @param pkt Received packet.
+ *
+ * @return NET_OK if the packet was taken, NET_CONTINUE otherwise.
+ */
+enum net_verdict net_gro_receive(struct net_gro *gro, struct net_pkt *pkt);
+
+/**
+ * @brief Pass on all held packets to the IP layer.
+ *
+ * @param gro Coalescing state.
+ */
+void net_gro_flush(struct net_gro *gro);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GRO_H */
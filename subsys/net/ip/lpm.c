@@ -0,0 +1,221 @@
+/** @file
+ * @brief Longest prefix match table
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/sys/__assert.h>
+
+#include "lpm.h"
+
+static inline uint8_t bit_get(const uint8_t *key, uint8_t pos)
+{
+	return (key[pos / 8] >> (7 - (pos % 8))) & 1;
+}
+
+/* Number of leading bits a and b have in common, up to max. The bits
+ * before from are known to be equal.
+ */
+static uint8_t common_len(const uint8_t *a, const uint8_t *b, uint8_t from,
+			  uint8_t max)
+{
+	unsigned int pos = from;
+
+	while (pos < max) {
+		unsigned int idx = pos / 8;
+		uint8_t diff = (a[idx] ^ b[idx]) & (0xff >> (pos % 8));
+
+		if (diff != 0U) {
+			pos = idx * 8 + __builtin_clz((uint32_t)diff) - 24;
+			return MIN(pos, max);
+		}
+
+		pos = (idx + 1) * 8;
+	}
+
+	return max;
+}
+
+static struct net_lpm_node *node_alloc(struct net_lpm *lpm,
+				       const uint8_t *prefix,
+				       uint8_t prefix_len)
+{
+	struct net_lpm_node *node = lpm->free;
+	size_t len = DIV_ROUND_UP(prefix_len, 8);
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	lpm->free = node->parent;
+
+	memset(node, 0, sizeof(*node));
+	memcpy(node->prefix, prefix, len);
+	if (prefix_len % 8) {
+		node->prefix[len - 1] &= 0xff << (8 - (prefix_len % 8));
+	}
+
+	node->prefix_len = prefix_len;
+	sys_slist_init(&node->entries);
+
+	return node;
+}
+
+static void node_free(struct net_lpm *lpm, struct net_lpm_node *node)
+{
+	node->parent = lpm->free;
+	lpm->free = node;
+}
+
+static struct net_lpm_node **node_link(struct net_lpm *lpm,
+				       struct net_lpm_node *node)
+{
+	struct net_lpm_node *parent = node->parent;
+
+	if (parent == NULL) {
+		return &lpm->root;
+	}
+
+	return &parent->child[parent->child[1] == node];
+}
+
+void net_lpm_init(struct net_lpm *lpm)
+{
+	lpm->root = NULL;
+	lpm->free = NULL;
+
+	for (int i = 0; i < lpm->num_nodes; i++) {
+		node_free(lpm, &lpm->nodes[i]);
+	}
+}
+
+struct net_lpm_node *net_lpm_get(struct net_lpm *lpm, const uint8_t *prefix,
+				 uint8_t prefix_len)
+{
+	struct net_lpm_node **link = &lpm->root;
+	struct net_lpm_node *parent = NULL;
+	struct net_lpm_node *node, *new, *branch;
+	uint8_t common = 0U;
+
+	__ASSERT(prefix_len <= lpm->key_len, "prefix too long");
+
+	while ((node = *link) != NULL) {
+		common = common_len(node->prefix, prefix,
+				    parent != NULL ? parent->prefix_len : 0,
+				    MIN(node->prefix_len, prefix_len));
+		if (common < node->prefix_len) {
+			break;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			return node;
+		}
+
+		parent = node;
+		link = &node->child[bit_get(prefix, node->prefix_len)];
+	}
+
+	new = node_alloc(lpm, prefix, prefix_len);
+	if (new == NULL) {
+		return NULL;
+	}
+
+	new->parent = parent;
+
+	if (node == NULL) {
+		*link = new;
+		return new;
+	}
+
+	/* The new prefix is a prefix of the node, insert it above */
+	if (common == prefix_len) {
+		new->child[bit_get(node->prefix, prefix_len)] = node;
+		node->parent = new;
+		*link = new;
+		return new;
+	}
+
+	/* Both diverge after their common part, branch there */
+	branch = node_alloc(lpm, prefix, common);
+	if (branch == NULL) {
+		node_free(lpm, new);
+		return NULL;
+	}
+
+	branch->parent = parent;
+	branch->child[bit_get(prefix, common)] = new;
+	branch->child[bit_get(node->prefix, common)] = node;
+	new->parent = branch;
+	node->parent = branch;
+	*link = branch;
+
+	return new;
+}
+
+void net_lpm_put(struct net_lpm *lpm, struct net_lpm_node *node)
+{
+	struct net_lpm_node *parent, *child;
+
+	while (node != NULL && sys_slist_is_empty(&node->entries)) {
+		if (node->child[0] != NULL && node->child[1] != NULL) {
+			return; /* still a branch node */
+		}
+
+		parent = node->parent;
+		child = node->child[0] != NULL ? node->child[0] : node->child[1];
+
+		*node_link(lpm, node) = child;
+		node_free(lpm, node);
+
+		if (child != NULL) {
+			child->parent = parent;
+			return;
+		}
+
+		/* The parent lost a child, it may not be needed anymore */
+		node = parent;
+	}
+}
+
+struct net_lpm_node *net_lpm_lookup(struct net_lpm *lpm, const uint8_t *key)
+{
+	struct net_lpm_node *node = lpm->root;
+	struct net_lpm_node *match = NULL;
+	uint8_t from = 0U;
+
+	while (node != NULL) {
+		if (common_len(node->prefix, key, from,
+			       node->prefix_len) < node->prefix_len) {
+			break;
+		}
+
+		match = node;
+
+		if (node->prefix_len == lpm->key_len) {
+			break;
+		}
+
+		from = node->prefix_len;
+		node = node->child[bit_get(key, node->prefix_len)];
+	}
+
+	if (match != NULL && sys_slist_is_empty(&match->entries)) {
+		match = net_lpm_lookup_next(match);
+	}
+
+	return match;
+}
+
+struct net_lpm_node *net_lpm_lookup_next(struct net_lpm_node *node)
+{
+	do {
+		node = node->parent;
+	} while (node != NULL && sys_slist_is_empty(&node->entries));
+
+	return node;
+}
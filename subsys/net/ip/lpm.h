@@ -0,0 +1,149 @@
+/** @file
+ * @brief Longest prefix match table
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __LPM_H
+#define __LPM_H
+
+#include <zephyr/types.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Longest key supported, in bytes (an IPv6 address) */
+#define NET_LPM_MAX_KEY_LEN 16
+
+/**
+ * @brief Node of a longest prefix match table.
+ *
+ * The table is a path compressed binary trie: every node stores its
+ * whole prefix and only exists if entries were added for that exact
+ * prefix, or if two longer prefixes diverge right after it.
+ */
+struct net_lpm_node {
+	/** Parent node, also links unused nodes together */
+	struct net_lpm_node *parent;
+
+	/** Children, selected by the bit following the prefix */
+	struct net_lpm_node *child[2];
+
+	/** Caller entries with this exact prefix, empty for branch nodes */
+	sys_slist_t entries;
+
+	/** Prefix, the bits after prefix_len are zero */
+	uint8_t prefix[NET_LPM_MAX_KEY_LEN];
+
+	/** Prefix length in bits */
+	uint8_t prefix_len;
+};
+
+/**
+ * @brief Longest prefix match table.
+ *
+ * Nodes are taken from a fixed pool. A table of N distinct prefixes
+ * needs at most 2 * N - 1 nodes, so NET_LPM_DEFINE() never runs out for
+ * the number of prefixes it was sized for. The table is not locked,
+ * callers must serialize the accesses.
+ */
+struct net_lpm {
+	struct net_lpm_node *root;
+	struct net_lpm_node *free;
+	struct net_lpm_node *nodes;
+	uint16_t num_nodes;
+
+	/** Key length in bits, 32 for IPv4 and 128 for IPv6 */
+	uint8_t key_len;
+};
+
+/**
+ * @brief Statically define a longest prefix match table.
+ *
+ * @param _name Name of the table.
+ * @param _max_prefixes Number of distinct prefixes the table can hold.
+ * @param _key_len Key length in bits, at most 8 * NET_LPM_MAX_KEY_LEN.
+ */
+#define NET_LPM_DEFINE(_name, _max_prefixes, _key_len)			\
+	BUILD_ASSERT((_key_len) > 0 &&					\
+		     (_key_len) <= 8 * NET_LPM_MAX_KEY_LEN);		\
+	static struct net_lpm_node _name##_nodes[2 * (_max_prefixes)];	\
+	static struct net_lpm _name = {					\
+		.nodes = _name##_nodes,					\
+		.num_nodes = ARRAY_SIZE(_name##_nodes),			\
+		.key_len = (_key_len),					\
+	}
+
+/**
+ * @brief Empty a table and put all its nodes back to the pool.
+ *
+ * @param lpm Table to initialize.
+ */
+void net_lpm_init(struct net_lpm *lpm);
+
+/**
+ * @brief Get the node of a prefix, adding it if needed.
+ *
+ * The caller links its entries in the entries list of the node, and
+ * calls net_lpm_put() once the list is empty again.
+ *
+ * @param lpm Table.
+ * @param prefix Prefix, in network byte order. Bits after prefix_len are
+ *        ignored.
+ * @param prefix_len Prefix length in bits, at most the key length.
+ *
+ * @return Node of the prefix, NULL if the node pool is exhausted.
+ */
+struct net_lpm_node *net_lpm_get(struct net_lpm *lpm, const uint8_t *prefix,
+				 uint8_t prefix_len);
+
+/**
+ * @brief Release a node whose entries list became empty.
+ *
+ * The node is removed from the table unless it is still needed as a
+ * branch node. Nothing is done if the node still has entries.
+ *
+ * @param lpm Table.
+ * @param node Node returned by net_lpm_get().
+ */
+void net_lpm_put(struct net_lpm *lpm, struct net_lpm_node *node);
+
+/**
+ * @brief Find the longest prefix with entries that matches a key.
+ *
+ * Runs in time proportional to the key length, whatever the number of
+ * prefixes in the table.
+ *
+ * @param lpm Table.
+ * @param key Key of the table key length, in network byte order.
+ *
+ * @return Matching node, NULL if no prefix matches.
+ */
+struct net_lpm_node *net_lpm_lookup(struct net_lpm *lpm, const uint8_t *key);
+
+/**
+ * @brief Find the next shorter prefix with entries that matches a key.
+ *
+ * Lets the caller fall back to shorter prefixes when none of the
+ * entries of a node are suitable.
+ *
+ * @param node Node returned by net_lpm_lookup() or this function.
+ *
+ * @return Next matching node, NULL if there are no shorter ones.
+ */
+struct net_lpm_node *net_lpm_lookup_next(struct net_lpm_node *node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LPM_H */
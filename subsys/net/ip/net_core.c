@@ -63,9 +63,42 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 
 #include "net_stats.h"
 
+#if defined(CONFIG_NET_GRO)
+#include "gro.h"
+#endif
+
 #if defined(CONFIG_NET_NATIVE)
+static inline enum net_verdict process_l3(struct net_pkt *pkt,
+					  bool is_loopback)
+{
+	uint8_t family = net_pkt_family(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IP) && (family == AF_INET || family == AF_INET6 ||
+					  family == AF_UNSPEC || family == AF_PACKET)) {
+		/* IP version and header length. */
+		uint8_t vtc_vhl = NET_IPV6_HDR(pkt)->vtc & 0xf0;
+
+		if (IS_ENABLED(CONFIG_NET_IPV6) && vtc_vhl == 0x60) {
+			return net_ipv6_input(pkt, is_loopback);
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) && vtc_vhl == 0x40) {
+			return net_ipv4_input(pkt, is_loopback);
+		}
+
+		NET_DBG("Unknown IP family packet (0x%x)", NET_IPV6_HDR(pkt)->vtc & 0xf0);
+		net_stats_update_ip_errors_protoerr(net_pkt_iface(pkt));
+		net_stats_update_ip_errors_vhlerr(net_pkt_iface(pkt));
+		return NET_DROP;
+	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && family == AF_CAN) {
+		return net_canbus_socket_input(pkt);
+	}
+
+	NET_DBG("Unknown protocol family packet (0x%x)", family);
+	return NET_DROP;
+}
+
 static inline enum net_verdict process_data(struct net_pkt *pkt,
-					    bool is_loopback)
+					    bool is_loopback,
+					    struct net_gro *gro)
 {
 	int ret;
 	bool locally_routed = false;
@@ -123,40 +156,34 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 		}
 	}
 
-	uint8_t family = net_pkt_family(pkt);
-
-	if (IS_ENABLED(CONFIG_NET_IP) && (family == AF_INET || family == AF_INET6 ||
-					  family == AF_UNSPEC || family == AF_PACKET)) {
-		/* IP version and header length. */
-		uint8_t vtc_vhl = NET_IPV6_HDR(pkt)->vtc & 0xf0;
-
-		if (IS_ENABLED(CONFIG_NET_IPV6) && vtc_vhl == 0x60) {
-			return net_ipv6_input(pkt, is_loopback);
-		} else if (IS_ENABLED(CONFIG_NET_IPV4) && vtc_vhl == 0x40) {
-			return net_ipv4_input(pkt, is_loopback);
+#if defined(CONFIG_NET_GRO)
+	/* Segments of a TCP connection received in the same batch can be
+	 * coalesced before they reach the IP layer.
+	 */
+	if (gro != NULL && !is_loopback && !locally_routed) {
+		ret = net_gro_receive(gro, pkt);
+		if (ret != NET_CONTINUE) {
+			return ret;
 		}
-
-		NET_DBG("Unknown IP family packet (0x%x)", NET_IPV6_HDR(pkt)->vtc & 0xf0);
-		net_stats_update_ip_errors_protoerr(net_pkt_iface(pkt));
-		net_stats_update_ip_errors_vhlerr(net_pkt_iface(pkt));
-		return NET_DROP;
-	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && family == AF_CAN) {
-		return net_canbus_socket_input(pkt);
 	}
+#else
+	ARG_UNUSED(gro);
+#endif
 
-	NET_DBG("Unknown protocol family packet (0x%x)", family);
-	return NET_DROP;
+	return process_l3(pkt, is_loopback);
 }
 
-static void processing_data(struct net_pkt *pkt, bool is_loopback)
+static void processing_verdict(struct net_pkt *pkt, enum net_verdict verdict,
+			       bool is_loopback)
 {
 again:
-	switch (process_data(pkt, is_loopback)) {
+	switch (verdict) {
 	case NET_CONTINUE:
 		if (IS_ENABLED(CONFIG_NET_L2_VIRTUAL)) {
 			/* If we have a tunneling packet, feed it back
 			 * to the stack in this case.
 			 */
+			verdict = process_data(pkt, is_loopback, NULL);
 			goto again;
 		} else {
 			NET_DBG("Dropping pkt %p", pkt);
@@ -174,6 +201,12 @@ again:
 	}
 }
 
+static void processing_data(struct net_pkt *pkt, bool is_loopback,
+			    struct net_gro *gro)
+{
+	processing_verdict(pkt, process_data(pkt, is_loopback, gro), is_loopback);
+}
+
 /* Things to setup after we are able to RX and TX */
 static void net_post_init(void)
 {
@@ -421,7 +454,7 @@ int net_try_send_data(struct net_pkt *pkt, k_timeout_t timeout)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
-		processing_data(pkt, true);
+		processing_data(pkt, true, NULL);
 		ret = 0;
 		goto err;
 	}
@@ -479,7 +512,8 @@ err:
 	return ret;
 }
 
-static void net_rx(struct net_if *iface, struct net_pkt *pkt)
+static void net_rx(struct net_if *iface, struct net_pkt *pkt,
+		   struct net_gro *gro)
 {
 	bool is_loopback = false;
 	size_t pkt_len;
@@ -498,21 +532,33 @@ static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 #endif
 	}
 
-	processing_data(pkt, is_loopback);
+	processing_data(pkt, is_loopback, gro);
 
 	net_print_statistics();
 	net_pkt_print();
 }
 
-void net_process_rx_packet(struct net_pkt *pkt)
+void net_process_rx_packet_gro(struct net_pkt *pkt, struct net_gro *gro)
 {
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
 	net_capture_pkt(net_pkt_iface(pkt), pkt);
 
-	net_rx(net_pkt_iface(pkt), pkt);
+	net_rx(net_pkt_iface(pkt), pkt, gro);
 }
 
+void net_process_rx_packet(struct net_pkt *pkt)
+{
+	net_process_rx_packet_gro(pkt, NULL);
+}
+
+#if defined(CONFIG_NET_GRO)
+void net_process_gro_packet(struct net_pkt *pkt)
+{
+	processing_verdict(pkt, process_l3(pkt, false), false);
+}
+#endif
+
 static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 {
 	size_t len = net_pkt_get_len(pkt);
@@ -61,6 +61,11 @@ extern void net_if_stats_reset(struct net_if *iface);
 extern void net_if_stats_reset_all(void);
 extern const char *net_if_oper_state2str(enum net_if_oper_state state);
 extern void net_process_rx_packet(struct net_pkt *pkt);
+struct net_gro;
+extern void net_process_rx_packet_gro(struct net_pkt *pkt, struct net_gro *gro);
+#if defined(CONFIG_NET_GRO)
+extern void net_process_gro_packet(struct net_pkt *pkt);
+#endif
 extern void net_process_tx_packet(struct net_pkt *pkt);
 
 extern struct net_if_addr *net_if_ipv4_addr_get_first_by_index(int ifindex);
@@ -172,6 +172,13 @@ static inline void stats(struct net_if *iface)
 			 GET_STAT(iface, tcp.connrst));
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_GRO)
+		NET_INFO("GRO held       %u\tmerged\t%u\tflushed\t%u",
+			 GET_STAT(iface, gro.held),
+			 GET_STAT(iface, gro.merged),
+			 GET_STAT(iface, gro.flushed));
+#endif
+
 		NET_INFO("Bytes received %llu", GET_STAT(iface, bytes.received));
 		NET_INFO("Bytes sent     %llu", GET_STAT(iface, bytes.sent));
 		NET_INFO("Processing err %u",
@@ -332,6 +339,12 @@ static int net_stats_get(uint64_t mgmt_request, struct net_if *iface,
 		len_chk = sizeof(struct net_stats_pm);
 		src = GET_STAT_ADDR(iface, pm);
 		break;
+#endif
+#if defined(CONFIG_NET_STATISTICS_GRO)
+	case NET_REQUEST_STATS_CMD_GET_GRO:
+		len_chk = sizeof(struct net_stats_gro);
+		src = GET_STAT_ADDR(iface, gro);
+		break;
 #endif
 	}
 
@@ -401,6 +414,11 @@ NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_PM,
 				  net_stats_get);
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_GRO)
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_GRO,
+				  net_stats_get);
+#endif
+
 #endif /* CONFIG_NET_STATISTICS_USER_API */
 
 void net_stats_reset(struct net_if *iface)
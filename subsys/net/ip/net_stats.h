@@ -276,6 +276,28 @@ static inline void net_stats_update_udp_chkerr(struct net_if *iface)
 #define net_stats_update_udp_chkerr(iface)
 #endif /* CONFIG_NET_STATISTICS_UDP */
 
+#if defined(CONFIG_NET_STATISTICS_GRO)
+/* Generic receive offload stats */
+static inline void net_stats_update_gro_held(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.gro.held++);
+}
+
+static inline void net_stats_update_gro_merged(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.gro.merged++);
+}
+
+static inline void net_stats_update_gro_flushed(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.gro.flushed++);
+}
+#else
+#define net_stats_update_gro_held(iface)
+#define net_stats_update_gro_merged(iface)
+#define net_stats_update_gro_flushed(iface)
+#endif /* CONFIG_NET_STATISTICS_GRO */
+
 #if defined(CONFIG_NET_STATISTICS_TCP) && defined(CONFIG_NET_NATIVE_TCP)
 /* TCP stats */
 static inline void net_stats_update_tcp_sent(struct net_if *iface, uint32_t bytes)
@@ -18,6 +18,10 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include "net_stats.h"
 #include "net_tc_mapping.h"
 
+#if defined(CONFIG_NET_GRO)
+#include "gro.h"
+#endif
+
 #define TC_RX_PSEUDO_QUEUE (COND_CODE_1(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO, (1), (0)))
 #define NET_TC_RX_EFFECTIVE_COUNT (NET_TC_RX_COUNT + TC_RX_PSEUDO_QUEUE)
 
@@ -295,19 +299,33 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 #else
 	ARG_UNUSED(p2);
 #endif
-	struct net_pkt *pkt;
+	struct net_pkt *pkts[CONFIG_NET_TC_RX_BATCH_SIZE];
+	int count;
+#if defined(CONFIG_NET_GRO)
+	struct net_gro gro;
+
+	net_gro_init(&gro);
+#endif
 
 	while (1) {
-		pkt = k_fifo_get(fifo, K_FOREVER);
-		if (pkt == NULL) {
-			continue;
-		}
+		count = k_fifo_get_batch(fifo, (void **)pkts, ARRAY_SIZE(pkts), K_FOREVER);
 
+		for (int i = 0; i < count; i++) {
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
-		k_sem_give(fifo_slot);
+			k_sem_give(fifo_slot);
 #endif
 
-		net_process_rx_packet(pkt);
+#if defined(CONFIG_NET_GRO)
+			net_process_rx_packet_gro(pkts[i], &gro);
+#else
+			net_process_rx_packet(pkts[i]);
+#endif
+		}
+
+#if defined(CONFIG_NET_GRO)
+		/* Nothing is held across batches */
+		net_gro_flush(&gro);
+#endif
 	}
 }
 #endif
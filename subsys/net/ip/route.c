@@ -40,6 +40,22 @@ static sys_slist_t active_route_lifetime_timers;
 /* Timer that manages expired route entries. */
 static struct k_work_delayable route_lifetime_timer;
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+/* Routes are linked in the trie node of their prefix, one per interface */
+NET_LPM_DEFINE(route_lpm, CONFIG_NET_MAX_ROUTES, 128);
+#endif
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Results of the last lookups, flushed whenever the routes change */
+struct route_cache_entry {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+#endif
+
 static void net_route_nexthop_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Nexthop %p removed", nbr);
@@ -204,6 +220,9 @@ static struct net_nbr *nbr_new(struct net_if *iface,
 
 	net_ipaddr_copy(&net_route_data(nbr)->addr, addr);
 	net_route_data(nbr)->prefix_len = prefix_len;
+#if defined(CONFIG_NET_ROUTE_LPM)
+	net_route_data(nbr)->lpm = NULL;
+#endif
 
 	NET_DBG("[%d] nbr %p iface %p IPv6 %s/%d",
 		nbr->idx, nbr, iface,
@@ -267,15 +286,101 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+static struct route_cache_entry *route_cache_slot(struct net_if *iface,
+						  struct in6_addr *dst)
+{
+	uint32_t hash = UNALIGNED_GET(&dst->s6_addr32[3]) ^ POINTER_TO_UINT(iface);
+
+	return &route_cache[hash % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static struct net_route_entry *route_cache_get(struct net_if *iface,
+					       struct in6_addr *dst)
+{
+	struct route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	if (entry->route != NULL && entry->iface == iface &&
+	    net_ipv6_addr_cmp(&entry->dst, dst)) {
+		return entry->route;
+	}
+
+	return NULL;
+}
+
+static void route_cache_set(struct net_if *iface, struct in6_addr *dst,
+			    struct net_route_entry *route)
+{
+	struct route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	net_ipaddr_copy(&entry->dst, dst);
+	entry->iface = iface;
+	entry->route = route;
+}
+
+static void route_cache_flush(void)
+{
+	memset(route_cache, 0, sizeof(route_cache));
+}
+#else
+#define route_cache_get(...) NULL
+#define route_cache_set(...)
+#define route_cache_flush(...)
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+static void route_lpm_add(struct net_route_entry *route)
+{
+	struct net_lpm_node *node;
+
+	node = net_lpm_get(&route_lpm, route->addr.s6_addr, route->prefix_len);
+
+	/* The trie has room for as many prefixes as there are routes */
+	NET_ASSERT(node != NULL, "No free route trie node");
+
+	sys_slist_append(&node->entries, &route->lpm_entry);
+	route->lpm = node;
+}
+
+static void route_lpm_del(struct net_route_entry *route)
+{
+	if (route->lpm == NULL) {
+		return;
+	}
+
+	sys_slist_find_and_remove(&route->lpm->entries, &route->lpm_entry);
+	net_lpm_put(&route_lpm, route->lpm);
+	route->lpm = NULL;
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
+{
+	struct net_route_entry *route;
+	struct net_lpm_node *node;
+
+	for (node = net_lpm_lookup(&route_lpm, dst->s6_addr); node != NULL;
+	     node = net_lpm_lookup_next(node)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->entries, route, lpm_entry) {
+			if (iface == NULL || route->iface == iface) {
+				return route;
+			}
+		}
+	}
+
+	return NULL;
+}
+#else
+#define route_lpm_add(...)
+#define route_lpm_del(...)
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +403,25 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_LPM */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	found = route_cache_get(iface, dst);
+	if (!found) {
+		found = route_find(iface, dst);
+		if (found) {
+			route_cache_set(iface, dst, found);
+		}
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -445,6 +569,8 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	net_route_update_lifetime(route, lifetime);
 
 	sys_slist_prepend(&routes, &route->node);
+	route_lpm_add(route);
+	route_cache_flush();
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -587,6 +713,8 @@ int net_route_del(struct net_route_entry *route)
 	}
 
 	sys_slist_find_and_remove(&routes, &route->node);
+	route_lpm_del(route);
+	route_cache_flush();
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -1130,6 +1258,9 @@ void net_route_init(void)
 
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	memset(route_mcast_entries, 0, sizeof(route_mcast_entries));
+#endif
+#if defined(CONFIG_NET_ROUTE_LPM)
+	net_lpm_init(&route_lpm);
 #endif
 	k_work_init_delayable(&route_lifetime_timer, route_lifetime_timeout);
 }
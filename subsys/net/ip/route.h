@@ -20,6 +20,7 @@
 #include <zephyr/net/net_timeout.h>
 
 #include "nbr.h"
+#include "lpm.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,6 +69,14 @@ struct net_route_entry {
 
 	/** Is the route valid forever */
 	uint8_t is_infinite : 1;
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	/** Node in the list of routes of the same prefix */
+	sys_snode_t lpm_entry;
+
+	/** Lookup trie node of the prefix */
+	struct net_lpm_node *lpm;
+#endif
 };
 
 /* Route preference values, as defined in RFC 4191 */
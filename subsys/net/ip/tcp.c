@@ -19,6 +19,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/udp.h>
+#include <zephyr/net/ethernet.h>
 #include "ipv4.h"
 #include "ipv6.h"
 #include "connection.h"
@@ -36,6 +37,13 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #define ZWP_MAX_DELAY_MS 120000
 #define DUPLICATE_ACK_RETRANSMIT_TRHESHOLD 3
 
+/* Largest receive window that can be advertised to the peer */
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define TCP_RECV_WIN_LIMIT ((uint32_t)UINT16_MAX << NET_TCP_WINDOW_SCALE_MAX)
+#else
+#define TCP_RECV_WIN_LIMIT UINT16_MAX
+#endif
+
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
 static int tcp_max_timeout_ms;
@@ -68,6 +76,8 @@ static int tcp_tx_window =
 /* Define the number of MSS sections the congestion window is initialized at */
 #define TCP_CONGESTION_INITIAL_WIN 1
 #define TCP_CONGESTION_INITIAL_SSTHRESH 3
+/* Upper bound of the congestion window, keeps the arithmetic in range */
+#define TCP_CONGESTION_MAX_WIN INT32_MAX
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
@@ -443,21 +453,49 @@ static void tcp_derive_rto(struct tcp *conn)
 
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-/* Implementation according to RFC6582 */
-
-static void tcp_new_reno_log(struct tcp *conn, char *step)
+static void tcp_ca_log(struct tcp *conn, char *step)
 {
-	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
-		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
+	NET_DBG("conn: %p, %s %s, cwnd=%u, ssthres=%u, fast_pend=%u",
+		conn, conn->ca_ops->name, step, conn->ca.cwnd, conn->ca.ssthresh,
 		conn->ca.pending_fast_retransmit_bytes);
 }
 
+static void tcp_ca_slow_start(struct tcp *conn, uint32_t acked_len)
+{
+	uint32_t new_win = conn->ca.cwnd + MIN(acked_len, conn_mss(conn));
+
+	conn->ca.cwnd = MIN(new_win, TCP_CONGESTION_MAX_WIN);
+}
+
+/* Deflate the window inflated by duplicate acks during fast recovery.
+ * Returns false if there is no fast recovery in progress.
+ */
+static bool tcp_ca_recovery_acked(struct tcp *conn, uint32_t acked_len)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		return false;
+	}
+
+	/* Check if it is still in fast recovery mode */
+	if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+		conn->ca.pending_fast_retransmit_bytes = 0;
+		conn->ca.cwnd = conn->ca.ssthresh;
+	} else {
+		conn->ca.pending_fast_retransmit_bytes -= acked_len;
+		conn->ca.cwnd -= acked_len;
+	}
+
+	return true;
+}
+
+/* Implementation according to RFC6582 */
+
 static void tcp_new_reno_init(struct tcp *conn)
 {
 	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
 	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
 	conn->ca.pending_fast_retransmit_bytes = 0;
-	tcp_new_reno_log(conn, "init");
+	tcp_ca_log(conn, "init");
 }
 
 static void tcp_new_reno_fast_retransmit(struct tcp *conn)
@@ -467,7 +505,7 @@ static void tcp_new_reno_fast_retransmit(struct tcp *conn)
 		/* Account for the lost segments */
 		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
 		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
-		tcp_new_reno_log(conn, "fast_retransmit");
+		tcp_ca_log(conn, "fast_retransmit");
 	}
 }
 
@@ -475,69 +513,574 @@ static void tcp_new_reno_timeout(struct tcp *conn)
 {
 	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
 	conn->ca.cwnd = conn_mss(conn);
-	tcp_new_reno_log(conn, "timeout");
+	tcp_ca_log(conn, "timeout");
 }
 
 /* For every duplicate ack increment the cwnd by mss */
 static void tcp_new_reno_dup_ack(struct tcp *conn)
 {
-	int32_t new_win = conn->ca.cwnd;
+	uint32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	tcp_new_reno_log(conn, "dup_ack");
+	conn->ca.cwnd = MIN(new_win, TCP_CONGESTION_MAX_WIN);
+	tcp_ca_log(conn, "dup_ack");
+}
+
+static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt_ms)
+{
+	uint32_t new_win = conn->ca.cwnd;
+	uint32_t win_inc = MIN(acked_len, conn_mss(conn));
+
+	ARG_UNUSED(rtt_ms);
+
+	if (tcp_ca_recovery_acked(conn, acked_len)) {
+		/* Deflating the window after a fast retransmit */
+	} else if (conn->ca.cwnd < conn->ca.ssthresh) {
+		tcp_ca_slow_start(conn, acked_len);
+	} else {
+		/* Implement a div_ceil	to avoid rounding to 0 */
+		new_win += ((uint64_t)win_inc * win_inc + conn->ca.cwnd - 1) /
+			   conn->ca.cwnd;
+		conn->ca.cwnd = MIN(new_win, TCP_CONGESTION_MAX_WIN);
+	}
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_new_reno_ops = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+
+/* Implementation according to RFC9438, with beta = 0.7 and C set by
+ * CONFIG_NET_TCP_CONGESTION_CUBIC_C. Fast recovery works like in NewReno,
+ * only the window reduction and the growth in congestion avoidance differ.
+ */
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+/* alpha = 3 * (1 - beta) / (1 + beta) */
+#define CUBIC_ALPHA_NUM 9
+#define CUBIC_ALPHA_DEN 17
+/* C in 1/1000 segments/s^3 */
+#define CUBIC_C CONFIG_NET_TCP_CONGESTION_CUBIC_C
+/* Bound of |t - K| so that its cube in milliseconds times C fits in 64 bits */
+#define CUBIC_MAX_DELTA_MS 60000
+
+static uint32_t tcp_cubic_cbrt(uint64_t x)
+{
+	uint32_t lo = 0;
+	uint32_t hi = BIT(21); /* cube of 2^21 is 2^63 */
+
+	while (lo < hi) {
+		uint32_t mid = hi - (hi - lo) / 2;
+
+		if ((uint64_t)mid * mid * mid <= x) {
+			lo = mid;
+		} else {
+			hi = mid - 1;
+		}
+	}
+
+	return lo;
 }
 
-static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
+static void tcp_cubic_init(struct tcp *conn)
 {
-	int32_t new_win = conn->ca.cwnd;
-	int32_t win_inc = MIN(acked_len, conn_mss(conn));
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+	tcp_new_reno_init(conn);
+}
+
+/* cwnd is the window before the loss */
+static void tcp_cubic_reduce(struct tcp *conn, uint64_t cwnd)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+
+	/* Fast convergence, leave room for new flows if the window shrinks */
+	if (cwnd < cubic->w_max) {
+		cwnd = cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) / (2 * CUBIC_BETA_DEN);
+	}
+
+	cubic->w_max = cwnd;
+	cubic->epoch_start = 0;
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2,
+				(uint64_t)conn->unacked_len * CUBIC_BETA_NUM / CUBIC_BETA_DEN);
+}
 
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
 	if (conn->ca.pending_fast_retransmit_bytes == 0) {
-		if (conn->ca.cwnd < conn->ca.ssthresh) {
-			new_win += win_inc;
+		uint32_t cwnd = conn->ca.cwnd;
+
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+		/* Without the inflation by the duplicate acks */
+		cwnd -= MIN(cwnd, (uint32_t)conn->dup_ack_cnt * conn_mss(conn));
+#endif
+		tcp_cubic_reduce(conn, cwnd);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_ca_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn, conn->ca.cwnd);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_ca_log(conn, "timeout");
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt_ms)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t now = k_uptime_get_32();
+	uint64_t new_win;
+	int64_t target;
+	int64_t t;
+
+	ARG_UNUSED(rtt_ms);
+
+	if (tcp_ca_recovery_acked(conn, acked_len)) {
+		goto out;
+	}
+
+	if (cwnd < conn->ca.ssthresh) {
+		tcp_ca_slow_start(conn, acked_len);
+		goto out;
+	}
+
+	if (cubic->epoch_start == 0) {
+		cubic->epoch_start = MAX(now, 1U);
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			/* K = cbrt((W_max - cwnd) / C) seconds, in segments */
+			cubic->origin = cubic->w_max;
+			cubic->k_ms = tcp_cubic_cbrt((uint64_t)(cubic->w_max - cwnd) *
+						     (1000000000000ULL / CUBIC_C) / mss);
 		} else {
-			/* Implement a div_ceil	to avoid rounding to 0 */
-			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
+			cubic->origin = cwnd;
+			cubic->k_ms = 0;
 		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	}
+
+	/* W_cubic(t + RTT) = C * (t + RTT - K)^3 + W_max */
+	t = (int64_t)(now - cubic->epoch_start) + conn->ca.srtt_ms - cubic->k_ms;
+	t = CLAMP(t, -CUBIC_MAX_DELTA_MS, CUBIC_MAX_DELTA_MS);
+	target = cubic->origin + t * t * t / 1000 * CUBIC_C / 1000000 * mss / 1000;
+	target = CLAMP(target, (int64_t)cwnd, (int64_t)cwnd * 3 / 2);
+
+	/* The window NewReno would have, CUBIC must not be slower */
+	cubic->w_est = MIN((uint64_t)cubic->w_est +
+			   (uint64_t)acked_len * mss * CUBIC_ALPHA_NUM /
+			   ((uint64_t)cwnd * CUBIC_ALPHA_DEN),
+			   TCP_CONGESTION_MAX_WIN);
+
+	if (cubic->w_est > target) {
+		new_win = cubic->w_est;
 	} else {
-		/* Check if it is still in fast recovery mode */
-		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
-			conn->ca.pending_fast_retransmit_bytes = 0;
-			conn->ca.cwnd = conn->ca.ssthresh;
-		} else {
-			conn->ca.pending_fast_retransmit_bytes -= acked_len;
-			conn->ca.cwnd -= acked_len;
+		new_win = cwnd + (target - cwnd) * acked_len / cwnd;
+	}
+
+	conn->ca.cwnd = MIN(new_win, TCP_CONGESTION_MAX_WIN);
+out:
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_cubic_ops = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.pkts_acked = tcp_cubic_pkts_acked,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.fast_retransmit = tcp_cubic_fast_retransmit,
+	.timeout = tcp_cubic_timeout,
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_CUBIC */
+
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+
+/* Simplified BBR v1. The bottleneck bandwidth is the maximum delivery
+ * rate of the last TCP_BBR_BW_FILTER_LEN round trips, measured once per
+ * round trip, and the congestion window and pacing rate are derived from
+ * it and from the minimum RTT. Losses do not reduce the window, only a
+ * retransmission timeout does.
+ */
+/* Gains are fixed point, in units of 1/BBR_UNIT */
+#define BBR_UNIT 256
+#define BBR_HIGH_GAIN (BBR_UNIT * 2885 / 1000 + 1)
+#define BBR_DRAIN_GAIN (BBR_UNIT * 1000 / 2885)
+#define BBR_CWND_GAIN (BBR_UNIT * 2)
+#define BBR_FULL_BW_THRESH (BBR_UNIT * 5 / 4)
+#define BBR_FULL_BW_CNT 3
+#define BBR_MIN_CWND_SEGS 4
+#define BBR_MIN_RTT_WIN_MS 10000
+#define BBR_PROBE_RTT_MS 200
+
+static const uint16_t tcp_bbr_cycle_gain[] = {
+	BBR_UNIT * 5 / 4, BBR_UNIT * 3 / 4,
+	BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT,
+};
+
+static uint32_t tcp_bbr_max_bw(struct tcp_ca_bbr *bbr)
+{
+	uint32_t bw = 0;
+
+	ARRAY_FOR_EACH(bbr->bw, i) {
+		bw = MAX(bw, bbr->bw[i]);
+	}
+
+	return bw;
+}
+
+static bool tcp_bbr_full_bw_reached(struct tcp_ca_bbr *bbr)
+{
+	return bbr->full_bw_cnt >= BBR_FULL_BW_CNT;
+}
+
+/* Bandwidth-delay product scaled by gain */
+static uint32_t tcp_bbr_bdp(struct tcp *conn, uint32_t gain)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t bw = tcp_bbr_max_bw(bbr);
+	uint64_t bdp;
+
+	if (bw == 0 || bbr->min_rtt_ms == UINT32_MAX) {
+		/* No model of the path yet */
+		return TCP_CONGESTION_MAX_WIN;
+	}
+
+	bdp = (uint64_t)bw * bbr->min_rtt_ms / MSEC_PER_SEC;
+
+	return MIN(bdp * gain / BBR_UNIT, TCP_CONGESTION_MAX_WIN);
+}
+
+static uint32_t tcp_bbr_pacing_gain(struct tcp_ca_bbr *bbr)
+{
+	switch (bbr->mode) {
+	case TCP_BBR_STARTUP:
+		return BBR_HIGH_GAIN;
+	case TCP_BBR_DRAIN:
+		return BBR_DRAIN_GAIN;
+	case TCP_BBR_PROBE_BW:
+		return tcp_bbr_cycle_gain[bbr->cycle_idx];
+	default:
+		return BBR_UNIT;
+	}
+}
+
+static void tcp_bbr_init(struct tcp *conn)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t now = k_uptime_get_32();
+
+	memset(bbr, 0, sizeof(*bbr));
+	bbr->mode = TCP_BBR_STARTUP;
+	bbr->min_rtt_ms = UINT32_MAX;
+	bbr->min_rtt_stamp = now;
+	bbr->round_start = now;
+	bbr->round_end_seq = conn->seq;
+
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = TCP_CONGESTION_MAX_WIN;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	tcp_ca_log(conn, "init");
+}
+
+/* Called once all data sent at the start of the round is acked */
+static void tcp_bbr_round_end(struct tcp *conn, uint32_t now)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t elapsed = now - bbr->round_start;
+	uint32_t bw = 0;
+
+	if (elapsed > 0) {
+		bw = MIN((uint64_t)bbr->round_delivered * MSEC_PER_SEC / elapsed,
+			 UINT32_MAX);
+	}
+
+	bbr->round_cnt++;
+	bbr->bw[bbr->round_cnt % TCP_BBR_BW_FILTER_LEN] = bw;
+
+	/* Leave STARTUP once the bandwidth stops growing by 25% per round */
+	if (bbr->mode == TCP_BBR_STARTUP && !tcp_bbr_full_bw_reached(bbr)) {
+		bw = tcp_bbr_max_bw(bbr);
+
+		if ((uint64_t)bw * BBR_UNIT >= (uint64_t)bbr->full_bw * BBR_FULL_BW_THRESH) {
+			bbr->full_bw = bw;
+			bbr->full_bw_cnt = 0;
+		} else if (++bbr->full_bw_cnt >= BBR_FULL_BW_CNT) {
+			bbr->mode = TCP_BBR_DRAIN;
+		}
+	}
+
+	bbr->round_delivered = 0;
+	bbr->round_start = now;
+	bbr->round_end_seq = conn->seq + conn->unacked_len;
+}
+
+static void tcp_bbr_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt_ms)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t mss = conn_mss(conn);
+	uint32_t min_cwnd = mss * BBR_MIN_CWND_SEGS;
+	uint32_t now = k_uptime_get_32();
+	bool rtt_expired = (now - bbr->min_rtt_stamp) > BBR_MIN_RTT_WIN_MS;
+	uint64_t cwnd = conn->ca.cwnd;
+	uint32_t target;
+
+	if (rtt_ms > 0 && (rtt_ms <= bbr->min_rtt_ms || rtt_expired)) {
+		bbr->min_rtt_ms = rtt_ms;
+		bbr->min_rtt_stamp = now;
+	}
+
+	bbr->round_delivered += acked_len;
+	if (net_tcp_seq_cmp(conn->seq + acked_len, bbr->round_end_seq) >= 0) {
+		tcp_bbr_round_end(conn, now);
+	}
+
+	switch (bbr->mode) {
+	case TCP_BBR_DRAIN:
+		/* Wait until the queue built up in STARTUP is gone */
+		if ((uint32_t)conn->unacked_len <= tcp_bbr_bdp(conn, BBR_UNIT) + acked_len) {
+			bbr->mode = TCP_BBR_PROBE_BW;
+			bbr->cycle_idx = 0;
+			bbr->cycle_stamp = now;
+		}
+		break;
+	case TCP_BBR_PROBE_BW:
+		if (now - bbr->cycle_stamp > bbr->min_rtt_ms) {
+			bbr->cycle_idx = (bbr->cycle_idx + 1) % ARRAY_SIZE(tcp_bbr_cycle_gain);
+			bbr->cycle_stamp = now;
+		}
+		break;
+	case TCP_BBR_PROBE_RTT:
+		if ((int32_t)(now - bbr->probe_rtt_done_stamp) >= 0) {
+			bbr->min_rtt_stamp = now;
+			bbr->mode = tcp_bbr_full_bw_reached(bbr) ? TCP_BBR_PROBE_BW :
+								   TCP_BBR_STARTUP;
+			bbr->cycle_stamp = now;
 		}
+		break;
+	default:
+		break;
+	}
+
+	/* Drain the queue from time to time to measure the real minimum RTT */
+	if (rtt_expired && bbr->mode != TCP_BBR_PROBE_RTT) {
+		bbr->mode = TCP_BBR_PROBE_RTT;
+		bbr->probe_rtt_done_stamp = now + BBR_PROBE_RTT_MS;
+	}
+
+	target = MAX(tcp_bbr_bdp(conn, bbr->mode == TCP_BBR_STARTUP ?
+				       BBR_HIGH_GAIN : BBR_CWND_GAIN), min_cwnd);
+
+	if (tcp_bbr_full_bw_reached(bbr)) {
+		cwnd = MIN(cwnd + acked_len, target);
+	} else if (cwnd < target) {
+		cwnd += acked_len;
+	}
+
+	cwnd = MAX(cwnd, min_cwnd);
+	if (bbr->mode == TCP_BBR_PROBE_RTT) {
+		cwnd = MIN(cwnd, min_cwnd);
+	}
+
+	conn->ca.cwnd = MIN(cwnd, TCP_CONGESTION_MAX_WIN);
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+static void tcp_bbr_timeout(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_ca_log(conn, "timeout");
+}
+
+static uint32_t tcp_bbr_pacing_rate(struct tcp *conn)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+
+	return MIN((uint64_t)tcp_bbr_max_bw(bbr) * tcp_bbr_pacing_gain(bbr) / BBR_UNIT,
+		   UINT32_MAX);
+}
+
+static const struct tcp_ca_ops tcp_bbr_ops = {
+	.name = "bbr",
+	.init = tcp_bbr_init,
+	.pkts_acked = tcp_bbr_pkts_acked,
+	.timeout = tcp_bbr_timeout,
+	.pacing_rate = tcp_bbr_pacing_rate,
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_BBR */
+
+static const struct tcp_ca_ops *const tcp_ca_algos[] = {
+	&tcp_new_reno_ops,
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	&tcp_cubic_ops,
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+	&tcp_bbr_ops,
+#endif
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+#define TCP_CA_DEFAULT (&tcp_cubic_ops)
+#elif defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_BBR)
+#define TCP_CA_DEFAULT (&tcp_bbr_ops)
+#else
+#define TCP_CA_DEFAULT (&tcp_new_reno_ops)
+#endif
+
+/* Time one segment per round trip, except retransmitted ones (Karn) */
+static void tcp_ca_rtt_track(struct tcp *conn, uint32_t end_seq, bool resend)
+{
+	if (resend) {
+		conn->ca.rtt_pending = false;
+	} else if (!conn->ca.rtt_pending) {
+		conn->ca.rtt_seq = end_seq;
+		conn->ca.rtt_start = k_uptime_get_32();
+		conn->ca.rtt_pending = true;
+	}
+}
+
+static uint32_t tcp_ca_rtt_sample(struct tcp *conn, uint32_t ack)
+{
+	uint32_t rtt;
+
+	if (!conn->ca.rtt_pending || net_tcp_seq_cmp(ack, conn->ca.rtt_seq) < 0) {
+		return 0;
+	}
+
+	conn->ca.rtt_pending = false;
+	rtt = MAX(k_uptime_get_32() - conn->ca.rtt_start, 1U);
+
+	if (conn->ca.srtt_ms == 0) {
+		conn->ca.srtt_ms = rtt;
+	} else {
+		conn->ca.srtt_ms = MAX((7 * conn->ca.srtt_ms + rtt) / 8, 1U);
 	}
-	tcp_new_reno_log(conn, "pkts_acked");
+
+	return rtt;
 }
 
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca.srtt_ms = 0;
+	conn->ca.rtt_pending = false;
+	conn->ca_ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca.rtt_pending = false;
+	if (conn->ca_ops->fast_retransmit != NULL) {
+		conn->ca_ops->fast_retransmit(conn);
+	}
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca.rtt_pending = false;
+	if (conn->ca_ops->timeout != NULL) {
+		conn->ca_ops->timeout(conn);
+	}
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	if (conn->ca_ops->dup_ack != NULL) {
+		conn->ca_ops->dup_ack(conn);
+	}
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	uint32_t rtt_ms = tcp_ca_rtt_sample(conn, conn->seq + acked_len);
+
+	if (conn->ca_ops->pkts_acked != NULL) {
+		conn->ca_ops->pkts_acked(conn, acked_len, rtt_ms);
+	}
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const char *name = value;
+
+	if (name == NULL) {
+		return -EINVAL;
+	}
+
+	/* Like in other systems, the name does not need to be terminated */
+	len = strnlen(name, len);
+
+	ARRAY_FOR_EACH(tcp_ca_algos, i) {
+		const struct tcp_ca_ops *ops = tcp_ca_algos[i];
+
+		if (strlen(ops->name) != len || strncmp(ops->name, name, len) != 0) {
+			continue;
+		}
+
+		if (conn->ca_ops != ops) {
+			conn->ca_ops = ops;
+
+			/* Start over with the new algorithm */
+			if (conn->state == TCP_ESTABLISHED ||
+			    conn->state == TCP_CLOSE_WAIT) {
+				tcp_ca_init(conn);
+			}
+		}
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca_ops->name) + 1;
+
+	if (len == NULL) {
+		return -EINVAL;
+	}
+
+	*len = MIN(*len, name_len);
+	memcpy(value, conn->ca_ops->name, *len);
+
+	return 0;
+}
+
+#if defined(CONFIG_NET_TCP_PACING)
+static uint32_t tcp_ca_pacing_rate(struct tcp *conn)
+{
+	uint64_t rate;
+
+	if (conn->ca_ops->pacing_rate != NULL) {
+		return conn->ca_ops->pacing_rate(conn);
+	}
+
+	if (conn->ca.srtt_ms == 0) {
+		return 0;
+	}
+
+	/* Leave room for growth: the window doubles per RTT in slow start */
+	rate = (uint64_t)conn->ca.cwnd * MSEC_PER_SEC / conn->ca.srtt_ms;
+	if (conn->ca.cwnd < conn->ca.ssthresh) {
+		rate *= 2;
+	} else {
+		rate = rate * 6 / 5;
+	}
+
+	return MIN(rate, UINT32_MAX);
 }
+#endif /* CONFIG_NET_TCP_PACING */
+
 #else
 
 static void tcp_ca_init(struct tcp *conn) { }
@@ -550,8 +1093,58 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static void tcp_ca_rtt_track(struct tcp *conn, uint32_t end_seq, bool resend) { }
+
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
+
 #endif
 
+#if defined(CONFIG_NET_TCP_PACING)
+/* Returns true if the next segment must wait, the pacing timer then
+ * resumes the transmission.
+ */
+static bool tcp_pacing_wait(struct tcp *conn)
+{
+	int64_t now;
+
+	if (tcp_ca_pacing_rate(conn) == 0) {
+		return false;
+	}
+
+	now = k_ticks_to_us_floor64(k_uptime_ticks());
+	if (conn->pacing_next_us <= now) {
+		return false;
+	}
+
+	k_work_schedule_for_queue(&tcp_work_q, &conn->pacing_timer,
+				  K_USEC(conn->pacing_next_us - now));
+
+	return true;
+}
+
+static void tcp_pacing_sent(struct tcp *conn, int len)
+{
+	uint32_t rate = tcp_ca_pacing_rate(conn);
+	int64_t now;
+
+	if (rate == 0) {
+		return;
+	}
+
+	/* The timer cannot wait for less than a tick, so let the schedule
+	 * lag up to one tick behind to still reach rates above one segment
+	 * per tick.
+	 */
+	now = k_ticks_to_us_floor64(k_uptime_ticks()) - k_ticks_to_us_ceil64(1);
+	conn->pacing_next_us = MAX(conn->pacing_next_us, now) +
+			       (int64_t)len * USEC_PER_SEC / rate;
+}
+#else
+#define tcp_pacing_wait(...) false
+#define tcp_pacing_sent(...)
+#endif /* CONFIG_NET_TCP_PACING */
+
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 
 static void tcp_send_keepalive_probe(struct k_work *work);
@@ -806,6 +1399,9 @@ static void tcp_conn_release(struct k_work *work)
 	(void)k_work_cancel_delayable(&conn->ack_timer);
 	(void)k_work_cancel_delayable(&conn->send_timer);
 	(void)k_work_cancel_delayable(&conn->recv_queue_timer);
+#if defined(CONFIG_NET_TCP_PACING)
+	(void)k_work_cancel_delayable(&conn->pacing_timer);
+#endif
 	keep_alive_timer_stop(conn);
 
 	k_mutex_unlock(&conn->lock);
@@ -998,8 +1594,11 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 	return buf;
 }
 
+/* MSS, window scale and SACK permitted are only valid in SYN segments,
+ * so they are only updated when @p syn is set.
+ */
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -1009,8 +1608,11 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1045,6 +1647,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
+			if (!syn) {
+				break;
+			}
+
 			recv_options->mss =
 				ntohs(UNALIGNED_GET((uint16_t *)(options + 2)));
 			recv_options->mss_found = true;
@@ -1056,8 +1662,49 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			if (!syn) {
+				break;
+			}
+
+			recv_options->window = options[2];
+			if (recv_options->window > NET_TCP_WINDOW_SCALE_MAX) {
+				/* RFC 7323 ch 2.3: use 14 instead */
+				recv_options->window = NET_TCP_WINDOW_SCALE_MAX;
+			}
+
 			recv_options->wnd_found = true;
+			NET_DBG("WS=%hu", (uint16_t)recv_options->window);
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			if (syn) {
+				recv_options->sack_perm_found = true;
+				NET_DBG("SACK permitted");
+			}
+			break;
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+#if defined(CONFIG_NET_TCP_SACK)
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_cnt < NET_TCP_SACK_MAX_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_cnt++];
+
+				block->left = ntohl(UNALIGNED_GET((uint32_t *)(options + i)));
+				block->right = ntohl(UNALIGNED_GET((uint32_t *)(options + i + 4)));
+				NET_DBG("SACK %u-%u", block->left, block->right);
+			}
+#endif
 			break;
 		default:
 			continue;
@@ -1108,7 +1755,7 @@ static int tcp_update_recv_wnd(struct tcp *conn, int32_t delta)
 	bool short_win_before;
 	bool short_win_after;
 
-	new_win = conn->recv_win + delta;
+	new_win = (int32_t)conn->recv_win + delta;
 	if (new_win < 0) {
 		new_win = 0;
 	} else if (new_win > conn->recv_win_max) {
@@ -1249,6 +1896,83 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+/* Smallest shift count that lets us advertise the whole receive window */
+static uint8_t tcp_window_scale_get(struct tcp *conn)
+{
+	uint8_t shift = 0;
+
+	while (shift < NET_TCP_WINDOW_SCALE_MAX &&
+	       (conn->recv_win_max >> shift) > UINT16_MAX) {
+		shift++;
+	}
+
+	return shift;
+}
+#endif
+
+/* Window value to put in the header of an outgoing segment */
+static uint16_t tcp_adv_win(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	/* The window of a SYN segment is never scaled, RFC 7323 ch 2.2 */
+	if (!(flags & SYN)) {
+		win >>= conn->rcv_wscale;
+	}
+#endif
+
+	return MIN(win, UINT16_MAX);
+}
+
+/* Window advertised by the peer in a received segment */
+static uint32_t tcp_peer_win(struct tcp *conn, struct tcphdr *th)
+{
+	uint32_t win = ntohs(th_win(th));
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (!(th_flags(th) & SYN)) {
+		win <<= conn->snd_wscale;
+	}
+#endif
+
+	return win;
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* SACK option length, padded with two NOPs to keep 32-bit alignment */
+static size_t tcp_sack_opt_len(uint8_t blocks)
+{
+	return 2 + 2 + blocks * NET_TCP_SACK_BLOCK_SIZE;
+}
+
+/* Report the out-of-order data we have queued in a SACK block. Only
+ * pure ACKs carry SACK blocks, so segments never exceed the MSS.
+ */
+static uint8_t tcp_sack_blocks_get(struct tcp *conn, uint8_t flags,
+				   struct net_pkt *data)
+{
+	struct tcp_sack_block *block = &conn->send_options.sack[0];
+
+	if (!conn->sack_ok || data != NULL || (flags & SYN) || !(flags & ACK) ||
+	    conn->queue_recv_data == NULL ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return 0;
+	}
+
+	/* The receive queue holds a single contiguous range */
+	block->left = tcp_get_seq(conn->queue_recv_data->buffer);
+	block->right = block->left + net_pkt_get_len(conn->queue_recv_data);
+
+	if (!net_tcp_seq_greater(block->left, conn->ack)) {
+		return 0;
+	}
+
+	return 1;
+}
+#endif
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 			  uint32_t seq)
 {
@@ -1270,8 +1994,22 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 		th->th_off++;
 	}
 
+	if (conn->send_options.wnd_found) {
+		th->th_off++;
+	}
+
+	if (conn->send_options.sack_perm_found) {
+		th->th_off++;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->send_options.sack_cnt > 0) {
+		th->th_off += tcp_sack_opt_len(conn->send_options.sack_cnt) / 4;
+	}
+#endif
+
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), UNALIGNED_MEMBER_ADDR(th, th_win));
+	UNALIGNED_PUT(htons(tcp_adv_win(conn, flags)), UNALIGNED_MEMBER_ADDR(th, th_win));
 	UNALIGNED_PUT(htonl(seq), UNALIGNED_MEMBER_ADDR(th, th_seq));
 
 	if (ACK & flags) {
@@ -1348,6 +2086,69 @@ static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 	return net_pkt_set_data(pkt, &mss_opt_access);
 }
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+static int net_tcp_set_wnd_scale_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(wnd_opt_access, struct tcp_mss_option);
+	struct tcp_mss_option *wnd;
+	uint32_t opt;
+
+	wnd = net_pkt_get_data(pkt, &wnd_opt_access);
+	if (!wnd) {
+		return -ENOBUFS;
+	}
+
+	/* Padded with a NOP to keep the option list 32-bit aligned */
+	opt = (NET_TCP_NOP_OPT << 24) | (NET_TCP_WINDOW_SCALE_OPT << 16) |
+	      (NET_TCP_WINDOW_SCALE_SIZE << 8) | conn->rcv_wscale;
+
+	UNALIGNED_PUT(htonl(opt), (uint32_t *)wnd);
+
+	return net_pkt_set_data(pkt, &wnd_opt_access);
+}
+#endif
+
+static int net_tcp_set_sack_perm_opt(struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(sack_opt_access, struct tcp_mss_option);
+	struct tcp_mss_option *sack;
+	uint32_t opt;
+
+	sack = net_pkt_get_data(pkt, &sack_opt_access);
+	if (!sack) {
+		return -ENOBUFS;
+	}
+
+	opt = (NET_TCP_NOP_OPT << 24) | (NET_TCP_NOP_OPT << 16) |
+	      (NET_TCP_SACK_PERM_OPT << 8) | NET_TCP_SACK_PERM_SIZE;
+
+	UNALIGNED_PUT(htonl(opt), (uint32_t *)sack);
+
+	return net_pkt_set_data(pkt, &sack_opt_access);
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+static int net_tcp_set_sack_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	uint8_t opt[2 + 2 + NET_TCP_SACK_MAX_BLOCKS * NET_TCP_SACK_BLOCK_SIZE];
+	uint8_t blocks = conn->send_options.sack_cnt;
+	uint8_t *p = opt;
+
+	*p++ = NET_TCP_NOP_OPT;
+	*p++ = NET_TCP_NOP_OPT;
+	*p++ = NET_TCP_SACK_OPT;
+	*p++ = 2 + blocks * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (int i = 0; i < blocks; i++) {
+		sys_put_be32(conn->send_options.sack[i].left, p);
+		sys_put_be32(conn->send_options.sack[i].right, p + 4);
+		p += NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	return net_pkt_write(pkt, opt, p - opt);
+}
+#endif
+
 static bool is_destination_local(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
@@ -1465,6 +2266,21 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		alloc_len += sizeof(uint32_t);
 	}
 
+	if (conn->send_options.wnd_found) {
+		alloc_len += sizeof(uint32_t);
+	}
+
+	if (conn->send_options.sack_perm_found) {
+		alloc_len += sizeof(uint32_t);
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->send_options.sack_cnt = tcp_sack_blocks_get(conn, flags, data);
+	if (conn->send_options.sack_cnt > 0) {
+		alloc_len += tcp_sack_opt_len(conn->send_options.sack_cnt);
+	}
+#endif
+
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1472,6 +2288,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	}
 
 	if (data) {
+		/* More than a segment of data is split up by the L2 or the
+		 * driver, see tcp_send_max_len().
+		 */
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) &&
+		    net_pkt_get_len(data) > conn_mss(conn)) {
+			net_pkt_set_gso_size(pkt, conn_mss(conn));
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -1497,6 +2321,34 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (conn->send_options.wnd_found) {
+		ret = net_tcp_set_wnd_scale_opt(conn, pkt);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+#endif
+
+	if (conn->send_options.sack_perm_found) {
+		ret = net_tcp_set_sack_perm_opt(pkt);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->send_options.sack_cnt > 0) {
+		ret = net_tcp_set_sack_opt(conn, pkt);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+#endif
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1532,6 +2384,60 @@ static void tcp_out(struct tcp *conn, uint8_t flags)
 	(void)tcp_out_ext(conn, flags, NULL /* no data */, conn->seq + conn->unacked_len);
 }
 
+/* SYN and SYN-ACK segments carry the options negotiated at connection setup */
+static int tcp_out_syn(struct tcp *conn, uint8_t flags, uint32_t seq)
+{
+	int ret;
+
+	/* Options other than MSS are only answered with one of our own */
+	conn->send_options.mss_found = true;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	conn->send_options.wnd_found = !(flags & ACK) || conn->wscale_ok;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->send_options.sack_perm_found = !(flags & ACK) || conn->sack_ok;
+#endif
+
+	ret = tcp_out_ext(conn, flags, NULL /* no data */, seq);
+
+	conn->send_options.mss_found = false;
+	conn->send_options.wnd_found = false;
+	conn->send_options.sack_perm_found = false;
+
+	return ret;
+}
+
+/* Called when a SYN is received in LISTEN or SYN-SENT state */
+static void tcp_syn_options_negotiate(struct tcp *conn, bool has_options)
+{
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	conn->wscale_ok = has_options && conn->recv_options.wnd_found;
+
+	if (conn->wscale_ok) {
+		conn->snd_wscale = conn->recv_options.window;
+
+		/* Our shift count went out with the SYN already in SYN-SENT */
+		if (conn->state == TCP_LISTEN) {
+			conn->rcv_wscale = tcp_window_scale_get(conn);
+		}
+	} else {
+		/* Scaling is only used if both sides asked for it */
+		conn->snd_wscale = 0;
+		conn->rcv_wscale = 0;
+	}
+
+	NET_DBG("conn: %p window scale snd %hu rcv %hu", conn,
+		(uint16_t)conn->snd_wscale, (uint16_t)conn->rcv_wscale);
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sack_ok = has_options && conn->recv_options.sack_perm_found;
+
+	NET_DBG("conn: %p SACK %s", conn, conn->sack_ok ? "on" : "off");
+#endif
+	ARG_UNUSED(conn);
+	ARG_UNUSED(has_options);
+}
+
 static int tcp_pkt_pull(struct net_pkt *pkt, size_t len)
 {
 	int total = net_pkt_get_len(pkt);
@@ -1661,6 +2567,81 @@ static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
 	return ret;
 }
 
+/* Like tcp_pkt_append(), but the data is written by the callback directly
+ * into the packet buffers. Returns the number of bytes appended, which is
+ * less than len if the callback runs out of data.
+ */
+static int tcp_pkt_append_fill(struct net_pkt *pkt, size_t len,
+			       net_tcp_fill_cb_t cb, void *user_data)
+{
+	size_t alloc_len = len;
+	struct net_buf *last = NULL;
+	struct net_buf *prev;
+	struct net_buf *buf;
+	size_t filled = 0;
+	int ret = 0;
+
+	if (pkt->buffer) {
+		last = net_buf_frag_last(pkt->buffer);
+		alloc_len -= MIN(len, net_buf_tailroom(last));
+	}
+
+	if (alloc_len > 0) {
+		ret = net_pkt_alloc_buffer_raw(pkt, alloc_len,
+					       TCP_PKT_ALLOC_TIMEOUT);
+		if (ret < 0) {
+			return -ENOBUFS;
+		}
+	}
+
+	buf = last != NULL ? last : pkt->buffer;
+
+	while (buf != NULL && filled < len) {
+		size_t write_len = MIN(len - filled, net_buf_tailroom(buf));
+
+		if (write_len > 0) {
+			ret = cb(net_buf_tail(buf), write_len, user_data);
+			if (ret <= 0) {
+				break;
+			}
+
+			net_buf_add(buf, ret);
+			filled += ret;
+
+			if ((size_t)ret < write_len) {
+				break;
+			}
+		}
+
+		buf = buf->frags;
+	}
+
+	/* Give back the buffers the callback had no data for */
+	prev = last;
+	buf = last != NULL ? last->frags : pkt->buffer;
+
+	while (buf != NULL && buf->len > 0) {
+		prev = buf;
+		buf = buf->frags;
+	}
+
+	if (buf != NULL) {
+		if (prev != NULL) {
+			prev->frags = NULL;
+		} else {
+			pkt->buffer = NULL;
+		}
+
+		net_buf_unref(buf);
+	}
+
+	if (filled == 0 && ret < 0) {
+		return ret;
+	}
+
+	return filled;
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
 	bool window_full = (conn->send_data_total >= conn->send_win);
@@ -1693,81 +2674,364 @@ static int tcp_unsent_len(struct tcp *conn)
 	} else {
 		unsent_len = MIN(unsent_len, conn->send_win - conn->unacked_len);
 
-#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-		if (conn->unacked_len >= conn->ca.cwnd) {
-			unsent_len = 0;
-		} else {
-			unsent_len = MIN(unsent_len, conn->ca.cwnd - conn->unacked_len);
-		}
-#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		if (conn->unacked_len >= conn->ca.cwnd) {
+			unsent_len = 0;
+		} else {
+			unsent_len = MIN(unsent_len, conn->ca.cwnd - conn->unacked_len);
+		}
+#endif
+	}
+ out:
+	return unsent_len;
+}
+
+/* A helper function to reduce code repeat. It should already be protected by mutex
+ * and the 'conn' parameter is not NULL.
+ */
+static void tcp_setup_retransmission(struct tcp *conn)
+{
+	conn->send_data_retries = 0;
+	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer, K_MSEC(TCP_RTO_MS));
+}
+
+/* Send len bytes of the send_data queue, starting offset bytes after conn->seq */
+static int tcp_send_segment(struct tcp *conn, size_t offset, int len, bool resend)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = tcp_pkt_alloc(conn, len);
+	if (!pkt) {
+		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
+	if (ret == 0) {
+		tcp_ca_rtt_track(conn, conn->seq + offset + len, resend);
+
+		if (resend) {
+			net_stats_update_tcp_resent(conn->iface, len);
+			net_stats_update_tcp_seg_rexmit(conn->iface);
+		} else {
+			net_stats_update_tcp_sent(conn->iface, len);
+
+			for (int i = 0; i < DIV_ROUND_UP(len, conn_mss(conn)); i++) {
+				net_stats_update_tcp_seg_sent(conn->iface);
+			}
+		}
+	}
+
+	/* The data we want to send, has been moved to the send queue so we
+	 * can unref the head net_pkt. If there was an error, we need to remove
+	 * the packet anyway.
+	 */
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
+#if defined(CONFIG_NET_TCP_GSO)
+/* Largest IPv4 header and largest TCP header */
+#define TCP_GSO_MAX_HDR_LEN (2 * 60)
+
+static bool tcp_is_peer_local(struct tcp *conn)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV4) && conn->dst.sa.sa_family == AF_INET) {
+		return net_ipv4_is_addr_loopback(&conn->dst.sin.sin_addr) ||
+		       net_ipv4_is_my_addr(&conn->dst.sin.sin_addr);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && conn->dst.sa.sa_family == AF_INET6) {
+		return net_ipv6_is_addr_loopback(&conn->dst.sin6.sin6_addr) ||
+		       net_ipv6_is_my_addr(&conn->dst.sin6.sin6_addr);
+	}
+
+	return false;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+/* Amount of data tcp_send_data() puts in one packet. Over Ethernet this
+ * can be several segments, which are split up by the driver or right
+ * before the link layer header is added. Retransmissions stay one
+ * segment, as do packets that are looped back and never reach an L2.
+ */
+static int tcp_send_max_len(struct tcp *conn)
+{
+	int mss = conn_mss(conn);
+
+#if defined(CONFIG_NET_TCP_GSO)
+	if (conn->data_mode != TCP_DATA_MODE_RESEND && tcp_send_cb == NULL &&
+	    net_if_l2(conn->iface) == &NET_L2_GET_NAME(ETHERNET) &&
+	    !tcp_is_peer_local(conn)) {
+		return MIN(CONFIG_NET_TCP_GSO_MAX_SEGS,
+			   (UINT16_MAX - TCP_GSO_MAX_HDR_LEN) / mss) * mss;
+	}
+#endif
+
+	return mss;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int len;
+
+	len = MIN(tcp_unsent_len(conn), tcp_send_max_len(conn));
+	if (len < 0) {
+		ret = len;
+		goto out;
+	}
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len,
+			       conn->data_mode == TCP_DATA_MODE_RESEND);
+	if (ret == 0) {
+		conn->unacked_len += len;
+		tcp_pacing_sent(conn, len);
+	}
+
+	conn_send_data_dump(conn);
+
+ out:
+	return ret;
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sacked_cnt = 0;
+	conn->sack_recovery = false;
+}
+
+/* Merge one SACK block into the scoreboard, keeping it sorted */
+static void tcp_sack_insert(struct tcp *conn, uint32_t left, uint32_t right)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	int i, j;
+
+	/* Find the first range that ends at or after the new block */
+	for (i = 0; i < conn->sacked_cnt; i++) {
+		if (net_tcp_seq_cmp(sb[i].right, left) >= 0) {
+			break;
+		}
+	}
+
+	if (i < conn->sacked_cnt && net_tcp_seq_cmp(sb[i].left, right) <= 0) {
+		/* Overlaps or touches range i, extend it and absorb followers */
+		if (net_tcp_seq_cmp(left, sb[i].left) < 0) {
+			sb[i].left = left;
+		}
+
+		if (net_tcp_seq_cmp(right, sb[i].right) > 0) {
+			sb[i].right = right;
+		}
+
+		for (j = i + 1; j < conn->sacked_cnt &&
+		     net_tcp_seq_cmp(sb[j].left, sb[i].right) <= 0; j++) {
+			if (net_tcp_seq_cmp(sb[j].right, sb[i].right) > 0) {
+				sb[i].right = sb[j].right;
+			}
+		}
+
+		memmove(&sb[i + 1], &sb[j], (conn->sacked_cnt - j) * sizeof(*sb));
+		conn->sacked_cnt -= j - (i + 1);
+		return;
+	}
+
+	/* New range before range i. When full, the highest range is the
+	 * least useful one, as the holes below it are filled first.
+	 */
+	if (conn->sacked_cnt == ARRAY_SIZE(conn->sacked)) {
+		if (i == conn->sacked_cnt) {
+			return;
+		}
+
+		conn->sacked_cnt--;
+	}
+
+	memmove(&sb[i + 1], &sb[i], (conn->sacked_cnt - i) * sizeof(*sb));
+	sb[i].left = left;
+	sb[i].right = right;
+	conn->sacked_cnt++;
+}
+
+/* Drop what the cumulative ACK covers and add the blocks of this segment */
+static void tcp_sack_update(struct tcp *conn)
+{
+	uint32_t snd_una = conn->seq;
+	uint32_t snd_max = conn->seq + conn->send_data_total;
+	int i;
+
+	for (i = 0; i < conn->sacked_cnt; i++) {
+		if (net_tcp_seq_cmp(conn->sacked[i].right, snd_una) > 0) {
+			break;
+		}
+	}
+
+	memmove(&conn->sacked[0], &conn->sacked[i],
+		(conn->sacked_cnt - i) * sizeof(conn->sacked[0]));
+	conn->sacked_cnt -= i;
+
+	if (conn->sacked_cnt > 0 &&
+	    net_tcp_seq_cmp(conn->sacked[0].left, snd_una) < 0) {
+		conn->sacked[0].left = snd_una;
+	}
+
+	for (i = 0; i < conn->recv_options.sack_cnt; i++) {
+		struct tcp_sack_block *block = &conn->recv_options.sack[i];
+
+		/* Ignore D-SACKs and blocks outside of the data in flight */
+		if (net_tcp_seq_cmp(block->left, snd_una) <= 0 ||
+		    net_tcp_seq_cmp(block->right, snd_max) > 0 ||
+		    net_tcp_seq_cmp(block->left, block->right) >= 0) {
+			continue;
+		}
+
+		tcp_sack_insert(conn, block->left, block->right);
+	}
+}
+
+/* RFC 6675 IsLost(): enough data above seq has been SACKed */
+static bool tcp_sack_is_lost(struct tcp *conn, uint32_t seq)
+{
+	uint32_t sacked = 0;
+
+	for (int i = 0; i < conn->sacked_cnt; i++) {
+		if (net_tcp_seq_cmp(conn->sacked[i].left, seq) > 0) {
+			sacked += conn->sacked[i].right - conn->sacked[i].left;
+		}
+	}
+
+	return sacked >= DUPLICATE_ACK_RETRANSMIT_TRHESHOLD * conn_mss(conn);
+}
+
+/* Retransmit the first hole not retransmitted yet during this recovery.
+ * Only holes below the highest SACKed byte are considered, except that
+ * the segment at conn->seq is always sent when @p first is set.
+ */
+static void tcp_sack_retransmit(struct tcp *conn, bool first)
+{
+	uint32_t seq = conn->sack_rexmit_next;
+	uint32_t end = conn->seq + conn->unacked_len;
+	int len;
+
+	if (net_tcp_seq_cmp(seq, conn->seq) < 0) {
+		seq = conn->seq;
+	}
+
+	if (!first) {
+		if (conn->sacked_cnt == 0) {
+			return;
+		}
+
+		end = conn->sacked[conn->sacked_cnt - 1].right;
+	}
+
+	/* Skip data already SACKed and stop at the next SACKed range */
+	for (int i = 0; i < conn->sacked_cnt; i++) {
+		if (net_tcp_seq_cmp(conn->sacked[i].right, seq) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(conn->sacked[i].left, seq) <= 0) {
+			seq = conn->sacked[i].right;
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(conn->sacked[i].left, end) < 0) {
+			end = conn->sacked[i].left;
+		}
+
+		break;
+	}
+
+	if (net_tcp_seq_cmp(end, conn->seq + conn->unacked_len) > 0) {
+		end = conn->seq + conn->unacked_len;
+	}
+
+	if (net_tcp_seq_cmp(end, seq) <= 0) {
+		return;
+	}
+
+	len = MIN(end - seq, conn_mss(conn));
+
+	NET_DBG("conn: %p SACK retransmit %u-%u", conn, seq, seq + len);
+
+	if (tcp_send_segment(conn, seq - conn->seq, len, true) == 0) {
+		conn->sack_rexmit_next = seq + len;
 	}
- out:
-	return unsent_len;
 }
 
-/* A helper function to reduce code repeat. It should already be protected by mutex
- * and the 'conn' parameter is not NULL.
+/* Loss detection and recovery using the SACK scoreboard, called for
+ * every ACK once the cumulative acknowledgement has been processed.
  */
-static void tcp_setup_retransmission(struct tcp *conn)
+static void tcp_sack_process(struct tcp *conn)
 {
-	conn->send_data_retries = 0;
-	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer, K_MSEC(TCP_RTO_MS));
-}
+	if (!conn->sack_ok || conn->data_mode != TCP_DATA_MODE_SEND) {
+		return;
+	}
 
-static int tcp_send_data(struct tcp *conn)
-{
-	int ret = 0;
-	int len;
-	struct net_pkt *pkt;
+	tcp_sack_update(conn);
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
-	if (len < 0) {
-		ret = len;
-		goto out;
-	}
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
+	if (conn->sack_recovery &&
+	    net_tcp_seq_cmp(conn->seq, conn->sack_recovery_point) >= 0) {
+		NET_DBG("conn: %p SACK recovery done", conn);
+		conn->sack_recovery = false;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
-	if (!pkt) {
-		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+	if (conn->unacked_len == 0) {
+		return;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
-	if (ret < 0) {
-		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
-	}
+	if (!conn->sack_recovery) {
+		if (conn->dup_ack_cnt < DUPLICATE_ACK_RETRANSMIT_TRHESHOLD &&
+		    !tcp_sack_is_lost(conn, conn->seq)) {
+			return;
+		}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
-	if (ret == 0) {
-		conn->unacked_len += len;
+		NET_DBG("conn: %p SACK recovery from %u", conn, conn->seq);
 
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
-			net_stats_update_tcp_resent(conn->iface, len);
-			net_stats_update_tcp_seg_rexmit(conn->iface);
-		} else {
-			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
+		conn->sack_recovery = true;
+		conn->sack_recovery_point = conn->seq + conn->unacked_len;
+		conn->sack_rexmit_next = conn->seq;
+
+		tcp_sack_retransmit(conn, true);
+		tcp_ca_fast_retransmit(conn);
+		if (tcp_window_full(conn)) {
+			(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 		}
+
+		return;
 	}
 
-	/* The data we want to send, has been moved to the send queue so we
-	 * can unref the head net_pkt. If there was an error, we need to remove
-	 * the packet anyway.
+	/* One retransmission per incoming ACK keeps the data in flight
+	 * constant during recovery.
 	 */
-	tcp_pkt_unref(pkt);
+	tcp_sack_retransmit(conn, false);
+}
+#endif /* CONFIG_NET_TCP_SACK */
 
-	conn_send_data_dump(conn);
+static inline bool tcp_sack_enabled(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_SACK)
+	return conn->sack_ok;
+#else
+	ARG_UNUSED(conn);
 
- out:
-	return ret;
+	return false;
+#endif
 }
 
 /* Send all queued but unsent data from the send_data packet by packet
@@ -1795,6 +3059,10 @@ static int tcp_send_queued_data(struct tcp *conn)
 			}
 		}
 
+		if (tcp_pacing_wait(conn)) {
+			break;
+		}
+
 		ret = tcp_send_data(conn);
 		if (ret < 0) {
 			break;
@@ -1816,6 +3084,22 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_PACING)
+static void tcp_pacing_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, pacing_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+		(void)tcp_send_queued_data(conn);
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+#endif
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1853,10 +3137,10 @@ static void tcp_resend_data(struct k_work *work)
 
 	switch (conn->state) {
 	case TCP_SYN_SENT:
-		(void)tcp_out_ext(conn, SYN, NULL, conn->seq - 1);
+		(void)tcp_out_syn(conn, SYN, conn->seq - 1);
 		break;
 	case TCP_SYN_RECEIVED:
-		(void)tcp_out_ext(conn, SYN | ACK, NULL, conn->seq - 1);
+		(void)tcp_out_syn(conn, SYN | ACK, conn->seq - 1);
 		break;
 	case TCP_ESTABLISHED:
 	case TCP_CLOSE_WAIT:
@@ -1868,6 +3152,10 @@ static void tcp_resend_data(struct k_work *work)
 			}
 		}
 
+#if defined(CONFIG_NET_TCP_SACK)
+		/* SACK information must be ignored after a timeout, RFC 2018 ch 8 */
+		tcp_sack_reset(conn);
+#endif
 		conn->data_mode = TCP_DATA_MODE_RESEND;
 		conn->unacked_len = 0;
 
@@ -2098,7 +3386,7 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
-	conn->recv_win_max = tcp_rx_window;
+	conn->recv_win_max = MIN((uint32_t)tcp_rx_window, TCP_RECV_WIN_LIMIT);
 	conn->recv_win = conn->recv_win_max;
 	conn->recv_win_sent = conn->recv_win_max;
 	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
@@ -2112,7 +3400,8 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = TCP_CONGESTION_MAX_WIN;
+	conn->ca_ops = TCP_CA_DEFAULT;
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2129,6 +3418,9 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->recv_queue_timer, tcp_cleanup_recv_queue);
 	k_work_init_delayable(&conn->persist_timer, tcp_send_zwp);
 	k_work_init_delayable(&conn->ack_timer, tcp_send_ack);
+#if defined(CONFIG_NET_TCP_PACING)
+	k_work_init_delayable(&conn->pacing_timer, tcp_pacing_timeout);
+#endif
 	k_work_init(&conn->conn_release, tcp_conn_release);
 	keep_alive_timer_init(conn);
 
@@ -2785,12 +4077,16 @@ static void tcp_check_sock_options(struct tcp *conn)
 		k_mutex_unlock(&conn->lock);
 	}
 
+	if (rcvbuf_opt > 0) {
+		rcvbuf_opt = MIN((uint32_t)rcvbuf_opt, TCP_RECV_WIN_LIMIT);
+	}
+
 	if (rcvbuf_opt > 0 && rcvbuf_opt != conn->recv_win_max) {
 		int diff;
 
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
-		diff = rcvbuf_opt - conn->recv_win_max;
+		diff = rcvbuf_opt - (int)conn->recv_win_max;
 		conn->recv_win_max = rcvbuf_opt;
 		tcp_update_recv_wnd(conn, diff);
 
@@ -2897,8 +4193,13 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	/* SACK blocks are only valid for the segment carrying them */
+	conn->recv_options.sack_cnt = 0;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len, th_flags(th) & SYN)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		net_tcp_reply_rst(pkt);
 		do_close = true;
@@ -2906,6 +4207,11 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	if (((conn->state == TCP_LISTEN) || (conn->state == TCP_SYN_SENT)) &&
+	    (th_flags(th) & SYN)) {
+		tcp_syn_options_negotiate(conn, tcp_options_len > 0);
+	}
+
 	if ((conn->state != TCP_LISTEN) && (conn->state != TCP_SYN_SENT) && FL(&fl, &, SYN)) {
 		/* According to RFC 793, ch 3.9 Event Processing, receiving SYN
 		 * once the connection has been established is an error
@@ -2956,7 +4262,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	/* Both the seqnum and the acknum are valid, then do processing. */
-	conn->send_win = ntohs(th_win(th));
+	conn->send_win = tcp_peer_win(conn, th);
 	if (conn->send_win > conn->send_win_max) {
 		NET_DBG("Lowering send window from %u to %u", conn->send_win, conn->send_win_max);
 		conn->send_win = conn->send_win_max;
@@ -2981,11 +4287,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
-			/* Make sure our MSS is also sent in the ACK */
-			conn->send_options.mss_found = true;
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
-			tcp_out(conn, SYN | ACK);
-			conn->send_options.mss_found = false;
+			/* Make sure our MSS is also sent in the ACK */
+			(void)tcp_out_syn(conn, SYN | ACK, conn->seq + conn->unacked_len);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 
@@ -3011,6 +4315,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+				conn->ca_ops = conn->accepted_conn->ca_ops;
+#endif
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3188,8 +4495,10 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				conn->dup_ack_cnt = 0;
 			}
 
-			/* Only do fast retransmit when not already in a resend state */
-			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+			/* Only do fast retransmit when not already in a resend state,
+			 * with SACK the recovery is handled by tcp_sack_process().
+			 */
+			if ((conn->data_mode == TCP_DATA_MODE_SEND) && !tcp_sack_enabled(conn) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
 				/* Apply a fast retransmit */
 				int temp_unacked_len = conn->unacked_len;
@@ -3298,6 +4607,10 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			}
 		}
 
+#if defined(CONFIG_NET_TCP_SACK)
+		tcp_sack_process(conn);
+#endif
+
 		if (th_seq(th) == conn->ack) {
 			if (len > 0) {
 				bool psh;
@@ -3671,6 +4984,30 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	return ret;
 }
 
+/* Account for data appended to the send queue and try to send it */
+static int tcp_queue_commit(struct tcp *conn, size_t queued_len)
+{
+	int ret;
+
+	conn->send_data_total += queued_len;
+
+	/* Successfully queued data for transmission. Even if there's a transmit
+	 * failure now (out-of-buf case), it can be ignored for now, retransmit
+	 * timer will take care of queued data retransmission.
+	 */
+	ret = tcp_send_queued_data(conn);
+	if (ret < 0 && ret != -ENOBUFS) {
+		tcp_conn_close(conn, ret);
+		return ret;
+	}
+
+	if (tcp_window_full(conn)) {
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+	}
+
+	return queued_len;
+}
+
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		  const struct msghdr *msg)
 {
@@ -3739,25 +5076,69 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		queued_len = len;
 	}
 
-	conn->send_data_total += queued_len;
+	ret = tcp_queue_commit(conn, queued_len);
+out:
+	k_mutex_unlock(&conn->lock);
 
-	/* Successfully queued data for transmission. Even if there's a transmit
-	 * failure now (out-of-buf case), it can be ignored for now, retransmit
-	 * timer will take care of queued data retransmission.
+	return ret;
+}
+
+int net_tcp_queue_fill(struct net_context *context, size_t len,
+		       net_tcp_fill_cb_t cb, void *user_data)
+{
+	struct tcp *conn = context->tcp;
+	struct net_pkt *pkt;
+	int ret = 0;
+
+	if (!conn || conn->state != TCP_ESTABLISHED) {
+		return -ENOTCONN;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (tcp_window_full(conn)) {
+		k_mutex_unlock(&conn->lock);
+		return -EAGAIN;
+	}
+
+	len = MIN(conn->send_win - conn->send_data_total, len);
+
+	k_mutex_unlock(&conn->lock);
+
+	/* The callback may be slow, e.g. reading from flash, so it fills
+	 * buffers of its own without the connection locked. Incoming
+	 * segments and the retransmit timer are not held up meanwhile.
 	 */
-	ret = tcp_send_queued_data(conn);
-	if (ret < 0 && ret != -ENOBUFS) {
-		tcp_conn_close(conn, ret);
+	pkt = tcp_pkt_alloc(conn, 0);
+	if (pkt == NULL) {
+		return -ENOBUFS;
+	}
+
+	ret = tcp_pkt_append_fill(pkt, len, cb, user_data);
+	if (ret <= 0) {
 		goto out;
 	}
 
-	if (tcp_window_full(conn)) {
-		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state != TCP_ESTABLISHED) {
+		k_mutex_unlock(&conn->lock);
+		ret = -ENOTCONN;
+		goto out;
 	}
 
-	ret = queued_len;
-out:
+	/* Another sender may have used some of the window meanwhile. The data
+	 * cannot be given back to the callback, so it is queued anyway, it is
+	 * never sent beyond the window.
+	 */
+	net_pkt_append_buffer(conn->send_data, pkt->buffer);
+	pkt->buffer = NULL;
+
+	ret = tcp_queue_commit(conn, ret);
+
 	k_mutex_unlock(&conn->lock);
+out:
+	tcp_pkt_unref(pkt);
 
 	return ret;
 }
@@ -3780,15 +5161,16 @@ static int tcp_start_handshake(struct tcp *conn)
 	/* Start the connection handshake */
 	k_mutex_lock(&conn->lock, K_FOREVER);
 	tcp_check_sock_options(conn);
-	conn->send_options.mss_found = true;
-	ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	conn->rcv_wscale = tcp_window_scale_get(conn);
+#endif
+	ret = tcp_out_syn(conn, SYN, conn->seq);
 	if (ret < 0) {
 		k_mutex_unlock(&conn->lock);
 		return ret;
 	}
 	tcp_setup_retransmission(conn);
 
-	conn->send_options.mss_found = false;
 	conn_seq(conn, + 1);
 	conn_state(conn, TCP_SYN_SENT);
 	tcp_conn_ref(conn);
@@ -4082,7 +5464,9 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
+	/* Segments of a GSO packet get their own checksum once split */
+	if ((net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) &&
+	    net_pkt_gso_size(pkt) == 0U) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -4090,6 +5474,170 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* New packet with the headers of pkt and len bytes of its data at offset */
+static struct net_pkt *tcp_gso_segment_alloc(struct net_pkt *pkt,
+					     size_t hdr_len, size_t offset,
+					     size_t len)
+{
+	struct net_pkt *seg;
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+					AF_UNSPEC, 0, TCP_PKT_ALLOC_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		net_pkt_unref(seg);
+		return NULL;
+	}
+
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+
+	return seg;
+}
+
+/* Set the IPv4 ID, sequence number and flags of the segment number idx,
+ * and its checksums
+ */
+static int tcp_gso_segment_finalize(struct net_pkt *seg, size_t ip_len,
+				    uint16_t idx, uint32_t seq, uint8_t flags)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+	int ret;
+
+	net_pkt_set_overwrite(seg, true);
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		struct net_ipv4_hdr *ipv4_hdr;
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(seg, &ipv4_access);
+		if (!ipv4_hdr) {
+			return -ENOBUFS;
+		}
+
+		/* Each segment is a datagram of its own, numbered on from the
+		 * ID of the original packet. The copied checksum would be
+		 * summed up in the new one.
+		 */
+		sys_put_be16(sys_get_be16(ipv4_hdr->id) + idx, ipv4_hdr->id);
+		ipv4_hdr->chksum = 0U;
+	}
+
+	if (net_pkt_skip(seg, ip_len)) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	sys_put_be32(seq, tcp_hdr->seq);
+	tcp_hdr->flags = flags;
+
+	ret = net_pkt_set_data(seg, &tcp_access);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = tcp_finalize_pkt(seg);
+
+	net_pkt_set_overwrite(seg, false);
+	net_pkt_cursor_init(seg);
+
+	return ret;
+}
+
+int net_tcp_gso_segment(struct net_pkt *pkt, net_tcp_gso_cb_t cb,
+			void *user_data)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	uint16_t mss = net_pkt_gso_size(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t hdr_len, data_len;
+	uint32_t seq;
+	uint8_t flags;
+	int ret;
+
+	if (mss == 0U) {
+		return -EINVAL;
+	}
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_len + (tcp_hdr->offset >> 4) * 4U;
+	seq = sys_get_be32(tcp_hdr->seq);
+	flags = tcp_hdr->flags;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (size_t offset = 0; offset < data_len; offset += mss) {
+		size_t len = MIN(mss, data_len - offset);
+		bool last = (offset + len == data_len);
+		struct net_pkt *seg;
+
+		seg = tcp_gso_segment_alloc(pkt, hdr_len, offset, len);
+		if (!seg) {
+			return -ENOBUFS;
+		}
+
+		/* Only the last segment pushes or closes */
+		ret = tcp_gso_segment_finalize(seg, ip_len, offset / mss, seq + offset,
+					       last ? flags : (flags & ~(PSH | FIN)));
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			return ret;
+		}
+
+		if (last) {
+			net_pkt_set_context(seg, net_pkt_context(pkt));
+		}
+
+		ret = cb(seg, user_data);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 				  struct net_pkt_data_access *tcp_access)
 {
@@ -4097,7 +5645,9 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 	enum net_if_checksum_type type = net_pkt_family(pkt) == AF_INET6 ?
 		NET_IF_CHECKSUM_IPV6_TCP : NET_IF_CHECKSUM_IPV4_TCP;
 
+	/* Coalesced segments had their checksum verified one by one */
 	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
+	    !net_pkt_is_gro_chksum_ok(pkt) &&
 	    (net_if_need_calc_rx_checksum(net_pkt_iface(pkt), type) ||
 	     net_pkt_is_ip_reassembled(pkt)) &&
 	    net_calc_chksum_tcp(pkt) != 0U) {
@@ -4548,6 +6098,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4585,6 +6138,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -104,6 +104,46 @@ void net_tcp_init(void);
 int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta);
 int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum);
 
+/**
+ * @typedef net_tcp_gso_cb_t
+ * @brief Callback receiving the segments of a GSO packet
+ *
+ * @param seg Segment, owned by the callback
+ * @param user_data User data given to net_tcp_gso_segment()
+ *
+ * @return 0 to continue with the next segment, <0 to stop
+ */
+typedef int (*net_tcp_gso_cb_t)(struct net_pkt *seg, void *user_data);
+
+/**
+ * @brief Split a TCP packet covering several segments
+ *
+ * The packet carries net_pkt_gso_size() bytes of data per segment. Each
+ * segment gets a copy of the IP and TCP headers, with the sequence
+ * number, lengths and checksums updated. PSH and FIN are only kept in
+ * the last segment. The packet itself is left untouched.
+ *
+ * @param pkt TCP packet with a non-zero GSO size
+ * @param cb Callback called for each segment, in order
+ * @param user_data User data passed to the callback
+ *
+ * @return 0 if all segments were given to the callback, <0 otherwise.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_segment(struct net_pkt *pkt, net_tcp_gso_cb_t cb,
+			void *user_data);
+#else
+static inline int net_tcp_gso_segment(struct net_pkt *pkt, net_tcp_gso_cb_t cb,
+				      void *user_data)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -ENOTSUP;
+}
+#endif
+
 #if defined(CONFIG_NET_TEST_PROTOCOL)
 /**
  * @brief Handle an incoming TCP packet
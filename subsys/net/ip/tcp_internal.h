@@ -36,6 +36,7 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
 };
 
 /**
@@ -312,6 +313,50 @@ static inline int net_tcp_queue(struct net_context *context, const void *data,
 }
 #endif
 
+/**
+ * @brief Callback writing data to be sent directly into a packet buffer
+ *
+ * @param dst		Where to write the data
+ * @param len		Maximum number of bytes to write
+ * @param user_data	User data given to net_tcp_queue_fill()
+ *
+ * @return Number of bytes written, less than len if there is no more data,
+ *	   < 0 if error
+ */
+typedef int (*net_tcp_fill_cb_t)(void *dst, size_t len, void *user_data);
+
+/**
+ * @brief Enqueue data for transmission, written by a callback
+ *
+ * Same as net_tcp_queue(), except that the data is written by @p cb
+ * directly into the send buffers of the connection, instead of being
+ * copied from a caller buffer. The callback is called without the
+ * connection locked, so it may block.
+ *
+ * @param context	Network context
+ * @param len		Maximum number of bytes
+ * @param cb		Callback writing the data
+ * @param user_data	User data passed to the callback
+ *
+ * @return Number of bytes queued, 0 if the callback had no data,
+ *	   < 0 if error
+ */
+#if defined(CONFIG_NET_NATIVE_TCP)
+int net_tcp_queue_fill(struct net_context *context, size_t len,
+		       net_tcp_fill_cb_t cb, void *user_data);
+#else
+static inline int net_tcp_queue_fill(struct net_context *context, size_t len,
+				     net_tcp_fill_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(len);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -EPROTONOSUPPORT;
+}
+#endif
+
 /**
  * @brief Update TCP receive window
  *
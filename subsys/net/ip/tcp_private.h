@@ -148,7 +148,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -236,23 +236,112 @@ union tcp_endpoint {
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
 
+/* Largest window shift count allowed by RFC 7323 ch 2.3 */
+#define NET_TCP_WINDOW_SCALE_MAX 14
+
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_SACK_PERM_SIZE   2
+#define NET_TCP_SACK_BLOCK_SIZE  8
+
+/* Number of SACK blocks that fit in the TCP option space */
+#define NET_TCP_SACK_MAX_BLOCKS  4
+
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
+
 struct tcp_options {
 	uint16_t mss;
-	uint16_t window;
+	uint8_t window; /* window scale shift count */
+#if defined(CONFIG_NET_TCP_SACK)
+	uint8_t sack_cnt;
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
 };
 
+struct tcp;
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+/* Congestion control algorithm, selected per connection with the
+ * TCP_CONGESTION socket option. Only init is mandatory.
+ */
+struct tcp_ca_ops {
+	const char *name;
+	void (*init)(struct tcp *conn);
+	/* New data acknowledged, called before conn->seq is advanced.
+	 * rtt_ms is a round trip time sample or 0 if there is none.
+	 */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len, uint32_t rtt_ms);
+	void (*dup_ack)(struct tcp *conn);
+	void (*fast_retransmit)(struct tcp *conn);
+	void (*timeout)(struct tcp *conn);
+	/* Bytes per second to pace the transmission at, 0 for no pacing */
+	uint32_t (*pacing_rate)(struct tcp *conn);
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+struct tcp_ca_cubic {
+	uint32_t w_max; /* cwnd before the last reduction */
+	uint32_t w_est; /* estimate of the NewReno window */
+	uint32_t origin; /* window at the plateau of the cubic function */
+	uint32_t k_ms; /* time to reach origin from epoch_start */
+	uint32_t epoch_start; /* 0 when no congestion avoidance epoch is running */
+};
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+#define TCP_BBR_BW_FILTER_LEN 8
+
+enum tcp_bbr_mode {
+	TCP_BBR_STARTUP,
+	TCP_BBR_DRAIN,
+	TCP_BBR_PROBE_BW,
+	TCP_BBR_PROBE_RTT,
+};
+
+struct tcp_ca_bbr {
+	uint32_t bw[TCP_BBR_BW_FILTER_LEN]; /* max delivery rate of recent rounds */
+	uint32_t full_bw;
+	uint32_t min_rtt_ms;
+	uint32_t min_rtt_stamp;
+	uint32_t probe_rtt_done_stamp;
+	uint32_t cycle_stamp;
+	uint32_t round_end_seq;
+	uint32_t round_start;
+	uint32_t round_delivered;
+	uint32_t round_cnt;
+	uint8_t mode; /* enum tcp_bbr_mode */
+	uint8_t cycle_idx;
+	uint8_t full_bw_cnt;
+};
+#endif
+
+struct tcp_congestion {
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+	uint32_t srtt_ms; /* smoothed round trip time, 0 until measured */
+	uint32_t rtt_seq; /* sequence number being timed */
+	uint32_t rtt_start;
+	bool rtt_pending;
+	union {
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+		struct tcp_ca_cubic cubic;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+		struct tcp_ca_bbr bbr;
+#endif
+		uint8_t unused;
+	};
 };
 #endif
 
-struct tcp;
 typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
 
 struct tcp { /* TCP connection */
@@ -284,6 +373,9 @@ struct tcp { /* TCP connection */
 	struct k_work_delayable timewait_timer;
 	struct k_work_delayable persist_timer;
 	struct k_work_delayable ack_timer;
+#if defined(CONFIG_NET_TCP_PACING)
+	struct k_work_delayable pacing_timer;
+#endif
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 	struct k_work_delayable keepalive_timer;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
@@ -315,22 +407,37 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_sent;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
+	uint32_t recv_win_sent;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	const struct tcp_ca_ops *ca_ops;
+	struct tcp_congestion ca;
+#endif
+#if defined(CONFIG_NET_TCP_PACING)
+	int64_t pacing_next_us; /* earliest time of the next paced segment */
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
 #endif
 	uint8_t zwp_retries;
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Data above conn->seq reported by the peer, sorted, no overlaps */
+	struct tcp_sack_block sacked[CONFIG_NET_TCP_SACK_SCOREBOARD_SIZE];
+	uint32_t sack_recovery_point; /* end of sent data when recovery began */
+	uint32_t sack_rexmit_next; /* first seq not yet retransmitted */
+	uint8_t sacked_cnt;
+#endif
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	uint8_t rcv_wscale; /* shift applied to the windows we advertise */
+	uint8_t snd_wscale; /* shift applied to the windows the peer advertises */
+#endif
 	bool in_connect : 1;
 	bool in_close : 1;
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -339,6 +446,13 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	bool wscale_ok : 1; /* peer offered window scaling in its SYN */
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_ok : 1; /* both sides sent SACK permitted */
+	bool sack_recovery : 1; /* SACK based loss recovery in progress */
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -27,6 +27,7 @@ LOG_MODULE_REGISTER(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 #include "net_private.h"
 #include "ipv6.h"
 #include "ipv4.h"
+#include "tcp.h"
 #include "bridge.h"
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
@@ -682,6 +683,98 @@ static void ethernet_update_tx_stats(struct net_if *iface, struct net_pkt *pkt)
 	}
 }
 
+static int ethernet_pass_to_bridge(struct ethernet_context *ctx,
+				   struct net_if *iface, struct net_pkt *pkt)
+{
+	struct net_if *bridge = net_eth_get_bridge(ctx);
+	struct net_pkt *out_pkt;
+
+	out_pkt = net_pkt_clone(pkt, K_NO_WAIT);
+	if (out_pkt == NULL) {
+		return -ENOMEM;
+	}
+
+	net_pkt_set_l2_bridged(out_pkt, true);
+	net_pkt_set_iface(out_pkt, bridge);
+	net_pkt_set_orig_iface(out_pkt, iface);
+
+	NET_DBG("Passing pkt %p (orig %p) to bridge %d from %d",
+		out_pkt, pkt, net_if_get_by_iface(bridge),
+		net_if_get_by_iface(iface));
+
+	(void)net_if_queue_tx(bridge, out_pkt);
+
+	return 0;
+}
+
+#if defined(CONFIG_NET_TCP_GSO)
+struct ethernet_gso_ctx {
+	struct net_if *iface;
+	size_t sent;
+};
+
+static int ethernet_send_gso_segment(struct net_pkt *seg, void *user_data)
+{
+	struct ethernet_gso_ctx *gso = user_data;
+	struct net_if *iface = gso->iface;
+	const struct ethernet_api *api = net_if_get_device(iface)->api;
+	struct ethernet_context *ctx = net_if_l2_data(iface);
+	int ret;
+
+	if (!ethernet_fill_header(ctx, iface, seg,
+				  htons(net_pkt_ll_proto_type(seg)))) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_ETHERNET_BRIDGE) &&
+	    net_eth_iface_is_bridged(ctx)) {
+		ret = ethernet_pass_to_bridge(ctx, iface, seg);
+		if (ret < 0) {
+			goto out;
+		}
+	}
+
+	ret = net_l2_send(api->send, net_if_get_device(iface), iface, seg);
+	if (ret != 0) {
+		eth_stats_update_errors_tx(iface);
+		goto out;
+	}
+
+	ethernet_update_tx_stats(iface, seg);
+	gso->sent += net_pkt_get_len(seg);
+
+out:
+	net_pkt_unref(seg);
+
+	return ret;
+}
+
+/* Split a TCP packet covering several segments for drivers that cannot
+ * do it, once the link layer addresses are known so that the lookups
+ * are done only once for all of them.
+ */
+static int ethernet_send_gso(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct ethernet_gso_ctx gso = {
+		.iface = iface,
+	};
+	int ret;
+
+	ret = net_tcp_gso_segment(pkt, ethernet_send_gso_segment, &gso);
+	if (ret < 0) {
+		NET_DBG("Cannot segment pkt %p (%d)", pkt, ret);
+		return ret;
+	}
+
+	net_pkt_unref(pkt);
+
+	return gso.sent;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	const struct ethernet_api *api = net_if_get_device(iface)->api;
@@ -767,6 +860,13 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 				       sizeof(struct net_eth_addr));
 	}
 
+#if defined(CONFIG_NET_TCP_GSO)
+	if (net_pkt_gso_size(pkt) > 0U &&
+	    !(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO)) {
+		return ethernet_send_gso(iface, pkt);
+	}
+#endif
+
 	/* Then set the ethernet header. Note that the iface parameter tells
 	 * where we are actually sending the packet. The interface in net_pkt
 	 * is used to determine if the VLAN header is added to Ethernet frame.
@@ -781,24 +881,10 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 send:
 	if (IS_ENABLED(CONFIG_NET_ETHERNET_BRIDGE) &&
 	    net_eth_iface_is_bridged(ctx) && !net_pkt_is_l2_bridged(pkt)) {
-		struct net_if *bridge = net_eth_get_bridge(ctx);
-		struct net_pkt *out_pkt;
-
-		out_pkt = net_pkt_clone(pkt, K_NO_WAIT);
-		if (out_pkt == NULL) {
-			ret = -ENOMEM;
+		ret = ethernet_pass_to_bridge(ctx, iface, pkt);
+		if (ret < 0) {
 			goto error;
 		}
-
-		net_pkt_set_l2_bridged(out_pkt, true);
-		net_pkt_set_iface(out_pkt, bridge);
-		net_pkt_set_orig_iface(out_pkt, iface);
-
-		NET_DBG("Passing pkt %p (orig %p) to bridge %d from %d",
-			out_pkt, pkt, net_if_get_by_iface(bridge),
-			net_if_get_by_iface(iface));
-
-		(void)net_if_queue_tx(bridge, out_pkt);
 	}
 
 	ret = net_l2_send(api->send, net_if_get_device(iface), iface, pkt);
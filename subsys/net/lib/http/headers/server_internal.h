@@ -16,6 +16,8 @@
 #include <zephyr/net/http/hpack.h>
 #include <zephyr/net/http/frame.h>
 
+struct fs_file_t;
+
 /* HTTP1/HTTP2 state handling */
 int handle_http_frame_rst_stream(struct http_client_ctx *client);
 int handle_http_frame_goaway(struct http_client_ctx *client);
@@ -31,6 +33,10 @@ int handle_http1_request(struct http_client_ctx *client);
 int handle_http1_to_http2_upgrade(struct http_client_ctx *client);
 int handle_http1_to_websocket_upgrade(struct http_client_ctx *client);
 void http_server_release_client(struct http_client_ctx *client);
+bool http_server_claim_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				struct http_client_ctx *client);
+void http_server_release_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				  struct http_client_ctx *client);
 
 int enter_http1_request(struct http_client_ctx *client);
 int enter_http2_request(struct http_client_ctx *client);
@@ -47,7 +53,10 @@ bool compression_value_is_valid(enum http_compression compression);
 /* Others */
 struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
 						 const char *path, int *len, bool is_ws);
+void http_server_routes_init(void);
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
+int http_server_sendall_file(struct http_client_ctx *client, struct fs_file_t *file, size_t len);
+bool http_server_can_sendfile(struct http_client_ctx *client);
 void http_server_get_content_type_from_extension(char *url, char *content_type,
 						 size_t content_type_size);
 int http_server_find_file(char *fname, size_t fname_size, size_t *file_size,
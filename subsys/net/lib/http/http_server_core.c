@@ -23,6 +23,7 @@
 #include <zephyr/posix/sys/eventfd.h>
 #include <zephyr/posix/fnmatch.h>
 #include <zephyr/sys/util_macro.h>
+#include <zephyr/zvfs/epoll.h>
 
 LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
@@ -41,20 +42,106 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
 #define HTTP_SERVER_MAX_SERVICES CONFIG_HTTP_SERVER_NUM_SERVICES
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
+#define HTTP_SERVER_WORKERS      CONFIG_HTTP_SERVER_WORKERS
+
+#if HTTP_SERVER_WORKERS > 0
+/* The server thread only has the listen sockets, the clients are spread
+ * over the workers.
+ */
+#define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES)
+#define HTTP_SERVER_WORKER_CLIENTS \
+	DIV_ROUND_UP(HTTP_SERVER_MAX_CLIENTS, HTTP_SERVER_WORKERS)
+#define HTTP_SERVER_WORKER_SOCK_COUNT (1 + HTTP_SERVER_WORKER_CLIENTS)
+#else
 #define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
+#endif
 
 struct http_server_ctx {
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
+	int num_fds; /* number of entries in fds */
+	int max_clients; /* number of entries in clients */
 
 	/* First pollfd is eventfd that can be used to stop the server,
 	 * then we have the server listen sockets,
 	 * and then the accepted sockets.
 	 */
-	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
-	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
+	struct zsock_pollfd *fds;
+	struct http_client_ctx *clients;
+
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	/* The fds entries are kept registered, with their index as data */
+	int epfd;
+	struct zvfs_epoll_event *ready;
+#endif
+
+#if HTTP_SERVER_WORKERS > 0
+	/* Set for the contexts of the worker threads */
+	struct http_server_worker *worker;
+#endif
 };
 
-static struct http_server_ctx server_ctx;
+static struct zsock_pollfd server_fds[HTTP_SERVER_SOCK_COUNT];
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+static struct zvfs_epoll_event server_ready[HTTP_SERVER_SOCK_COUNT];
+#endif
+
+#if HTTP_SERVER_WORKERS > 0
+/* Connection accepted by the server thread, waiting for its worker */
+struct http_server_handoff {
+	int fd;
+	const struct http_service_desc *svc;
+};
+
+struct http_server_worker {
+	struct http_server_ctx ctx;
+	struct zsock_pollfd fds[HTTP_SERVER_WORKER_SOCK_COUNT];
+	struct http_client_ctx clients[HTTP_SERVER_WORKER_CLIENTS];
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	struct zvfs_epoll_event ready[HTTP_SERVER_WORKER_SOCK_COUNT];
+#endif
+	struct k_msgq handoff_q;
+	struct http_server_handoff handoff_buf[HTTP_SERVER_WORKER_CLIENTS];
+	struct k_thread thread;
+	struct k_sem start;
+	struct k_sem stopped;
+	/* Clients handed to the worker and not released yet */
+	int active;
+	/* Accepting clients, protected by server_lock */
+	bool running;
+	/* Owned by the server thread */
+	bool started;
+	bool stopping;
+};
+
+static struct http_server_worker workers[HTTP_SERVER_WORKERS];
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, HTTP_SERVER_WORKERS,
+				   CONFIG_HTTP_SERVER_STACK_SIZE);
+
+static struct http_server_ctx server_ctx = {
+	.fds = server_fds,
+	.num_fds = ARRAY_SIZE(server_fds),
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	.ready = server_ready,
+#endif
+};
+#else
+static struct http_client_ctx server_clients[HTTP_SERVER_MAX_CLIENTS];
+
+static struct http_server_ctx server_ctx = {
+	.fds = server_fds,
+	.num_fds = ARRAY_SIZE(server_fds),
+	.clients = server_clients,
+	.max_clients = ARRAY_SIZE(server_clients),
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	.ready = server_ready,
+#endif
+};
+#endif /* HTTP_SERVER_WORKERS > 0 */
+
+/* Protects the client counts and the dynamic resource holders, which are
+ * shared by the worker threads.
+ */
+static K_MUTEX_DEFINE(server_lock);
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
 
@@ -64,6 +151,76 @@ static const char *const alpn_list[] = {"h2", "http/1.1"};
 
 static void close_client_connection(struct http_client_ctx *client);
 
+#if HTTP_SERVER_WORKERS > 0
+static void http_server_workers_stop(void);
+static void http_server_worker_drop_clients(struct http_server_worker *worker);
+#endif
+
+static inline bool http_server_is_worker(struct http_server_ctx *ctx)
+{
+#if HTTP_SERVER_WORKERS > 0
+	return ctx->worker != NULL;
+#else
+	ARG_UNUSED(ctx);
+
+	return false;
+#endif
+}
+
+/* Context whose clients array holds the client */
+static struct http_server_ctx *client_server_ctx(struct http_client_ctx *client)
+{
+#if HTTP_SERVER_WORKERS > 0
+	ARRAY_FOR_EACH_PTR(workers, worker) {
+		if (IS_ARRAY_ELEMENT(worker->clients, client)) {
+			return &worker->ctx;
+		}
+	}
+
+	return NULL;
+#else
+	return IS_ARRAY_ELEMENT(server_clients, client) ? &server_ctx : NULL;
+#endif
+}
+
+/* Reflect a change of the fds entry at index i to the epoll instance */
+static int http_server_fd_ctl(struct http_server_ctx *ctx, int op, int i)
+{
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	struct zvfs_epoll_event ev = {
+		.events = (uint16_t)ctx->fds[i].events,
+		.data.u32 = i,
+	};
+
+	if (ctx->epfd < 0) {
+		return 0;
+	}
+
+	if (zvfs_epoll_ctl(ctx->epfd, op, ctx->fds[i].fd, &ev) < 0) {
+		LOG_DBG("[%d] epoll_ctl %d failed (%d)", ctx->fds[i].fd, op, -errno);
+		return -errno;
+	}
+#else
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(op);
+	ARG_UNUSED(i);
+#endif
+
+	return 0;
+}
+
+/* Index in fds of the n-th socket to look at after a wait */
+static inline int http_server_fd_index(struct http_server_ctx *ctx, int n)
+{
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	return ctx->ready[n].data.u32;
+#else
+	ARG_UNUSED(ctx);
+
+	return n;
+#endif
+}
+
 HTTP_SERVER_CONTENT_TYPE(html, "text/html")
 HTTP_SERVER_CONTENT_TYPE(css, "text/css")
 HTTP_SERVER_CONTENT_TYPE(js, "text/javascript")
@@ -71,13 +228,59 @@ HTTP_SERVER_CONTENT_TYPE(jpg, "image/jpeg")
 HTTP_SERVER_CONTENT_TYPE(png, "image/png")
 HTTP_SERVER_CONTENT_TYPE(svg, "image/svg+xml")
 
+/* Reset the fds and clients of a context, then set up its epoll instance
+ * and the eventfd in fds[0].
+ */
+static int http_server_ctx_open(struct http_server_ctx *ctx)
+{
+	int fd;
+
+	/* Initialize fds */
+	memset(ctx->fds, 0, ctx->num_fds * sizeof(ctx->fds[0]));
+	if (ctx->max_clients > 0) {
+		memset(ctx->clients, 0, ctx->max_clients * sizeof(ctx->clients[0]));
+	}
+
+	for (int i = 0; i < ctx->num_fds; i++) {
+		ctx->fds[i].fd = INVALID_SOCK;
+	}
+
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	ctx->epfd = zvfs_epoll_create(0);
+	if (ctx->epfd < 0) {
+		fd = -errno;
+		LOG_ERR("epoll_create failed (%d)", fd);
+		return fd;
+	}
+#endif
+
+	/* Create an eventfd that can be used to trigger events during polling */
+	fd = eventfd(0, 0);
+	if (fd < 0) {
+		fd = -errno;
+		LOG_ERR("eventfd failed (%d)", fd);
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+		zsock_close(ctx->epfd);
+		ctx->epfd = -1;
+#endif
+		return fd;
+	}
+
+	ctx->fds[0].fd = fd;
+	ctx->fds[0].events = ZSOCK_POLLIN;
+	(void)http_server_fd_ctl(ctx, ZVFS_EPOLL_CTL_ADD, 0);
+	ctx->listen_fds = 1;
+
+	return 0;
+}
+
 int http_server_init(struct http_server_ctx *ctx)
 {
 	int proto;
 	int failed = 0, count = 0;
 	int svc_count;
 	socklen_t len;
-	int fd, af, i;
+	int fd, af;
 	struct sockaddr_storage addr_storage;
 	const union {
 		struct sockaddr *addr;
@@ -89,24 +292,15 @@ int http_server_init(struct http_server_ctx *ctx)
 
 	HTTP_SERVICE_COUNT(&svc_count);
 
-	/* Initialize fds */
-	memset(ctx->fds, 0, sizeof(ctx->fds));
-	memset(ctx->clients, 0, sizeof(ctx->clients));
-
-	for (i = 0; i < ARRAY_SIZE(ctx->fds); i++) {
-		ctx->fds[i].fd = INVALID_SOCK;
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_ROUTE_TABLE)) {
+		http_server_routes_init();
 	}
 
-	/* Create an eventfd that can be used to trigger events during polling */
-	fd = eventfd(0, 0);
+	fd = http_server_ctx_open(ctx);
 	if (fd < 0) {
-		fd = -errno;
-		LOG_ERR("eventfd failed (%d)", fd);
 		return fd;
 	}
 
-	ctx->fds[count].fd = fd;
-	ctx->fds[count].events = ZSOCK_POLLIN;
 	count++;
 
 	HTTP_SERVICE_FOREACH(svc) {
@@ -245,11 +439,23 @@ int http_server_init(struct http_server_ctx *ctx)
 		*svc->fd = fd;
 		ctx->fds[count].fd = fd;
 		ctx->fds[count].events = ZSOCK_POLLIN;
+		if (http_server_fd_ctl(ctx, ZVFS_EPOLL_CTL_ADD, count) < 0) {
+			failed++;
+			zsock_close(fd);
+			ctx->fds[count].fd = INVALID_SOCK;
+			*svc->fd = -1;
+			continue;
+		}
+
 		count++;
 	}
 
 	if (failed >= svc_count) {
 		LOG_ERR("All services failed (%d)", failed);
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+		zsock_close(ctx->epfd);
+		ctx->epfd = -1;
+#endif
 		/* Close eventfd socket */
 		zsock_close(ctx->fds[0].fd);
 		return -ESRCH;
@@ -285,10 +491,29 @@ static int accept_new_client(int server_fd)
 
 static void close_all_sockets(struct http_server_ctx *ctx)
 {
+	bool worker = http_server_is_worker(ctx);
+
+#if HTTP_SERVER_WORKERS > 0
+	if (worker) {
+		/* Stop getting new clients from the server thread */
+		k_mutex_lock(&server_lock, K_FOREVER);
+		ctx->worker->running = false;
+		k_mutex_unlock(&server_lock);
+	} else {
+		http_server_workers_stop();
+	}
+#endif
+
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+	/* Stop monitoring everything before the sockets are closed */
+	zsock_close(ctx->epfd);
+	ctx->epfd = -1;
+#endif
+
 	zsock_close(ctx->fds[0].fd); /* close eventfd */
 	ctx->fds[0].fd = -1;
 
-	for (int i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
+	for (int i = 1; i < ctx->num_fds; i++) {
 		if (ctx->fds[i].fd < 0) {
 			continue;
 		}
@@ -297,7 +522,7 @@ static void close_all_sockets(struct http_server_ctx *ctx)
 			zsock_close(ctx->fds[i].fd);
 		} else {
 			struct http_client_ctx *client =
-				&server_ctx.clients[i - ctx->listen_fds];
+				&ctx->clients[i - ctx->listen_fds];
 
 			close_client_connection(client);
 		}
@@ -305,6 +530,13 @@ static void close_all_sockets(struct http_server_ctx *ctx)
 		ctx->fds[i].fd = -1;
 	}
 
+	if (worker) {
+#if HTTP_SERVER_WORKERS > 0
+		http_server_worker_drop_clients(ctx->worker);
+#endif
+		return;
+	}
+
 	HTTP_SERVICE_FOREACH(svc) {
 		*svc->fd = -1;
 	}
@@ -327,7 +559,10 @@ static void client_release_resources(struct http_client_ctx *client)
 
 			dynamic_detail = (struct http_resource_detail_dynamic *)detail;
 
+			k_mutex_lock(&server_lock, K_FOREVER);
+
 			if (dynamic_detail->holder != client) {
+				k_mutex_unlock(&server_lock);
 				continue;
 			}
 
@@ -337,6 +572,8 @@ static void client_release_resources(struct http_client_ctx *client)
 			 */
 			dynamic_detail->holder = NULL;
 
+			k_mutex_unlock(&server_lock);
+
 			if (dynamic_detail->cb == NULL) {
 				continue;
 			}
@@ -349,27 +586,96 @@ static void client_release_resources(struct http_client_ctx *client)
 	}
 }
 
+bool http_server_claim_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				struct http_client_ctx *client)
+{
+	bool claimed;
+
+	k_mutex_lock(&server_lock, K_FOREVER);
+
+	claimed = dynamic_detail->holder == NULL || dynamic_detail->holder == client;
+	if (claimed) {
+		dynamic_detail->holder = client;
+	}
+
+	k_mutex_unlock(&server_lock);
+
+	return claimed;
+}
+
+void http_server_release_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				  struct http_client_ctx *client)
+{
+	k_mutex_lock(&server_lock, K_FOREVER);
+
+	if (dynamic_detail->holder == client) {
+		dynamic_detail->holder = NULL;
+	}
+
+	k_mutex_unlock(&server_lock);
+}
+
+/* Account for a client of ctx going away. Returns true if its service
+ * was at its concurrency limit before.
+ */
+static bool http_server_client_gone(struct http_server_ctx *ctx,
+				    const struct http_service_desc *svc)
+{
+	bool was_full;
+
+	k_mutex_lock(&server_lock, K_FOREVER);
+
+	was_full = svc->data->num_clients >= svc->concurrent;
+	svc->data->num_clients--;
+
+#if HTTP_SERVER_WORKERS > 0
+	if (ctx->worker != NULL) {
+		ctx->worker->active--;
+	}
+#else
+	ARG_UNUSED(ctx);
+#endif
+
+	k_mutex_unlock(&server_lock);
+
+	return was_full;
+}
+
 void http_server_release_client(struct http_client_ctx *client)
 {
-	int i;
+	struct http_server_ctx *ctx = client_server_ctx(client);
 	struct k_work_sync sync;
+	bool was_full;
+	int i;
 
-	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
+	__ASSERT_NO_MSG(ctx != NULL);
 
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
 
-	client->service->data->num_clients--;
+	was_full = http_server_client_gone(ctx, client->service);
 
-	for (i = 0; i < server_ctx.listen_fds; i++) {
-		if (server_ctx.fds[i].fd == *client->service->fd) {
-			server_ctx.fds[i].events = ZSOCK_POLLIN;
-			break;
+	if (http_server_is_worker(ctx)) {
+		/* The listen socket belongs to the server thread */
+		if (was_full) {
+			(void)eventfd_write(server_ctx.fds[0].fd, 1);
+		}
+	} else {
+		for (i = 0; i < ctx->listen_fds; i++) {
+			if (ctx->fds[i].fd == *client->service->fd) {
+				if (ctx->fds[i].events != ZSOCK_POLLIN) {
+					ctx->fds[i].events = ZSOCK_POLLIN;
+					(void)http_server_fd_ctl(ctx, ZVFS_EPOLL_CTL_MOD, i);
+				}
+				break;
+			}
 		}
 	}
-	for (i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
-		if (server_ctx.fds[i].fd == client->fd) {
-			server_ctx.fds[i].fd = INVALID_SOCK;
+
+	for (i = ctx->listen_fds; i < ctx->num_fds; i++) {
+		if (ctx->fds[i].fd == client->fd) {
+			(void)http_server_fd_ctl(ctx, ZVFS_EPOLL_CTL_DEL, i);
+			ctx->fds[i].fd = INVALID_SOCK;
 			break;
 		}
 	}
@@ -403,7 +709,7 @@ static void client_timeout(struct k_work *work)
 
 void http_client_timer_restart(struct http_client_ctx *client)
 {
-	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
+	__ASSERT_NO_MSG(client_server_ctx(client) != NULL);
 
 	k_work_reschedule(&client->inactivity_timer, INACTIVITY_TIMEOUT);
 }
@@ -548,21 +854,183 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
+/* Put a new connection in a free client slot of ctx */
+static int http_server_add_client(struct http_server_ctx *ctx,
+				  const struct http_service_desc *service,
+				  int new_socket)
+{
+	for (int j = ctx->listen_fds; j < ctx->listen_fds + ctx->max_clients; j++) {
+		if (ctx->fds[j].fd != INVALID_SOCK) {
+			continue;
+		}
+
+		ctx->fds[j].fd = new_socket;
+		ctx->fds[j].events = ZSOCK_POLLIN;
+		ctx->fds[j].revents = 0;
+
+		if (http_server_fd_ctl(ctx, ZVFS_EPOLL_CTL_ADD, j) < 0) {
+			ctx->fds[j].fd = INVALID_SOCK;
+			return -EIO;
+		}
+
+		LOG_DBG("Init client #%d", j - ctx->listen_fds);
+
+		init_client_ctx(&ctx->clients[j - ctx->listen_fds], service, new_socket);
+
+		return 0;
+	}
+
+	return -ENOMEM;
+}
+
+#if HTTP_SERVER_WORKERS > 0
+/* Give a new connection to the least loaded worker */
+static int http_server_handoff(const struct http_service_desc *svc, int fd)
+{
+	struct http_server_handoff handoff = {
+		.fd = fd,
+		.svc = svc,
+	};
+	struct http_server_worker *target = NULL;
+
+	k_mutex_lock(&server_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(workers, worker) {
+		if (!worker->running || worker->active >= HTTP_SERVER_WORKER_CLIENTS) {
+			continue;
+		}
+
+		if (target == NULL || worker->active < target->active) {
+			target = worker;
+		}
+	}
+
+	if (target != NULL) {
+		target->active++;
+		svc->data->num_clients++;
+
+		/* The queue has room for all the clients of the worker */
+		(void)k_msgq_put(&target->handoff_q, &handoff, K_NO_WAIT);
+	}
+
+	k_mutex_unlock(&server_lock);
+
+	if (target == NULL) {
+		return -ENOMEM;
+	}
+
+	(void)eventfd_write(target->ctx.fds[0].fd, 1);
+
+	return 0;
+}
+
+static void http_server_handoff_cancel(struct http_server_worker *worker,
+				       struct http_server_handoff *handoff)
+{
+	if (http_server_client_gone(&worker->ctx, handoff->svc)) {
+		(void)eventfd_write(server_ctx.fds[0].fd, 1);
+	}
+
+	(void)zsock_close(handoff->fd);
+}
+
+static void http_server_worker_take_clients(struct http_server_worker *worker)
+{
+	struct http_server_handoff handoff;
+
+	while (k_msgq_get(&worker->handoff_q, &handoff, K_NO_WAIT) == 0) {
+		if (http_server_add_client(&worker->ctx, handoff.svc, handoff.fd) < 0) {
+			LOG_DBG("No free slot found.");
+			http_server_handoff_cancel(worker, &handoff);
+		}
+	}
+}
+
+/* Close the connections handed to a worker that is going away */
+static void http_server_worker_drop_clients(struct http_server_worker *worker)
+{
+	struct http_server_handoff handoff;
+
+	while (k_msgq_get(&worker->handoff_q, &handoff, K_NO_WAIT) == 0) {
+		http_server_handoff_cancel(worker, &handoff);
+	}
+}
+
+/* Re-enable the listen sockets paused by the concurrency limit */
+static void http_server_resume_accept(struct http_server_ctx *ctx)
+{
+	const struct http_service_desc *service;
+	bool full;
+
+	for (int i = 1; i < ctx->listen_fds; i++) {
+		if (ctx->fds[i].events == ZSOCK_POLLIN) {
+			continue;
+		}
+
+		service = lookup_service(ctx->fds[i].fd);
+		if (service == NULL) {
+			continue;
+		}
+
+		k_mutex_lock(&server_lock, K_FOREVER);
+		full = service->data->num_clients >= service->concurrent;
+		k_mutex_unlock(&server_lock);
+
+		if (!full) {
+			ctx->fds[i].events = ZSOCK_POLLIN;
+			(void)http_server_fd_ctl(ctx, ZVFS_EPOLL_CTL_MOD, i);
+		}
+	}
+}
+#endif /* HTTP_SERVER_WORKERS > 0 */
+
+/* Handle a write to the eventfd of a context. Returns false if the
+ * context has to stop.
+ */
+static bool http_server_wakeup(struct http_server_ctx *ctx)
+{
+#if HTTP_SERVER_WORKERS > 0
+	if (ctx->worker != NULL) {
+		if (ctx->worker->stopping) {
+			return false;
+		}
+
+		http_server_worker_take_clients(ctx->worker);
+		return true;
+	}
+
+	if (server_running) {
+		/* A worker released a client */
+		http_server_resume_accept(ctx);
+		return true;
+	}
+#else
+	ARG_UNUSED(ctx);
+#endif
+
+	return false;
+}
+
 static int http_server_run(struct http_server_ctx *ctx)
 {
 	struct http_client_ctx *client;
 	const struct http_service_desc *service;
 	eventfd_t value;
-	bool found_slot;
+	bool full;
 	int new_socket;
-	int ret, i, j;
+	int ret, i, n;
+	int nready;
 	int sock_error;
 	socklen_t optlen = sizeof(int);
 
 	value = 0;
 
 	while (1) {
-		ret = zsock_poll(ctx->fds, HTTP_SERVER_SOCK_COUNT, -1);
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+		ret = zvfs_epoll_wait(ctx->epfd, ctx->ready, ctx->num_fds, -1);
+#else
+		ret = zsock_poll(ctx->fds, ctx->num_fds, -1);
+#endif
 		if (ret < 0) {
 			ret = -errno;
 			LOG_DBG("poll failed (%d)", ret);
@@ -574,15 +1042,34 @@ static int http_server_run(struct http_server_ctx *ctx)
 			break;
 		}
 
-		if (ret == 1 && ctx->fds[0].revents) {
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+		/* Only the sockets that are ready are looked at */
+		nready = ret;
+
+		for (n = 0; n < nready; n++) {
+			ctx->fds[ctx->ready[n].data.u32].revents = ctx->ready[n].events;
+		}
+#else
+		nready = ctx->num_fds;
+#endif
+
+		/* Workers are also woken up for each new client, which must
+		 * not wait for their other clients to become idle.
+		 */
+		if (ctx->fds[0].revents && (ret == 1 || http_server_is_worker(ctx))) {
 			eventfd_read(ctx->fds[0].fd, &value);
-			LOG_DBG("Received stop event. exiting ..");
-			ret = 0;
-			goto closing;
+
+			if (!http_server_wakeup(ctx)) {
+				LOG_DBG("Received stop event. exiting ..");
+				ret = 0;
+				goto closing;
+			}
 		}
 
-		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
-			if (ctx->fds[i].fd < 0) {
+		for (n = 0; n < nready; n++) {
+			i = http_server_fd_index(ctx, n);
+
+			if (i == 0 || ctx->fds[i].fd < 0) {
 				continue;
 			}
 
@@ -625,8 +1112,13 @@ static int http_server_run(struct http_server_ctx *ctx)
 				service = lookup_service(ctx->fds[i].fd);
 				__ASSERT(NULL != service, "fd not associated with a service");
 
-				if (service->data->num_clients >= service->concurrent) {
+				k_mutex_lock(&server_lock, K_FOREVER);
+				full = service->data->num_clients >= service->concurrent;
+				k_mutex_unlock(&server_lock);
+
+				if (full) {
 					ctx->fds[i].events = 0;
+					(void)http_server_fd_ctl(ctx, ZVFS_EPOLL_CTL_MOD, i);
 					continue;
 				}
 
@@ -637,28 +1129,17 @@ static int http_server_run(struct http_server_ctx *ctx)
 					continue;
 				}
 
-				found_slot = false;
-
-				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
-					if (ctx->fds[j].fd != INVALID_SOCK) {
-						continue;
-					}
-
-					ctx->fds[j].fd = new_socket;
-					ctx->fds[j].events = ZSOCK_POLLIN;
-					ctx->fds[j].revents = 0;
-
+#if HTTP_SERVER_WORKERS > 0
+				ret = http_server_handoff(service, new_socket);
+#else
+				ret = http_server_add_client(ctx, service, new_socket);
+				if (ret == 0) {
+					k_mutex_lock(&server_lock, K_FOREVER);
 					service->data->num_clients++;
-
-					LOG_DBG("Init client #%d", j - ctx->listen_fds);
-
-					init_client_ctx(&ctx->clients[j - ctx->listen_fds], service,
-							new_socket);
-					found_slot = true;
-					break;
+					k_mutex_unlock(&server_lock);
 				}
-
-				if (!found_slot) {
+#endif
+				if (ret < 0) {
 					LOG_DBG("No free slot found.");
 					zsock_close(new_socket);
 				}
@@ -705,6 +1186,12 @@ static int http_server_run(struct http_server_ctx *ctx)
 				close_client_connection(client);
 			}
 		}
+
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+		for (n = 0; n < nready; n++) {
+			ctx->fds[ctx->ready[n].data.u32].revents = 0;
+		}
+#endif
 	}
 
 	return 0;
@@ -764,9 +1251,215 @@ static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
 	return false;
 }
 
-struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
-						 const char *path, int *path_len, bool is_websocket)
+#if defined(CONFIG_HTTP_SERVER_ROUTE_TABLE)
+struct http_route {
+	const char *resource;
+	uint16_t len;
+	/* Position of the resource in the service, lower takes precedence */
+	uint16_t index;
+};
+
+static struct http_route route_pool[CONFIG_HTTP_SERVER_ROUTE_TABLE_SIZE];
+static bool routes_ready;
+
+static bool is_wildcard(const char *resource)
+{
+	return IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) &&
+	       strpbrk(resource, "*?[\\") != NULL;
+}
+
+static int route_cmp(const struct http_route *route, const char *key, size_t len)
+{
+	int ret;
+
+	ret = memcmp(route->resource, key, MIN(route->len, len));
+	if (ret != 0) {
+		return ret;
+	}
+
+	return (int)route->len - (int)len;
+}
+
+static void routes_build(const struct http_service_desc *svc, struct http_route *routes)
+{
+	struct http_service_runtime_data *data = svc->data;
+	size_t count = 0;
+	size_t pos;
+
+	/* Exact resources first, sorted by path. A resource is inserted after the
+	 * ones with the same path, so these stay in precedence order.
+	 */
+	HTTP_SERVICE_FOREACH_RESOURCE(svc, resource) {
+		const char *str = resource->resource;
+		size_t len = strlen(str);
+
+		if (is_wildcard(str)) {
+			continue;
+		}
+
+		for (pos = count; pos > 0 && route_cmp(&routes[pos - 1], str, len) > 0; pos--) {
+			routes[pos] = routes[pos - 1];
+		}
+
+		routes[pos].resource = str;
+		routes[pos].len = len;
+		routes[pos].index = resource - svc->res_begin;
+		count++;
+	}
+
+	data->num_exact = count;
+
+	/* Then the wildcard ones, kept in precedence order */
+	HTTP_SERVICE_FOREACH_RESOURCE(svc, resource) {
+		if (!is_wildcard(resource->resource)) {
+			continue;
+		}
+
+		routes[count].resource = resource->resource;
+		routes[count].len = strlen(resource->resource);
+		routes[count].index = resource - svc->res_begin;
+		count++;
+	}
+
+	data->num_routes = count;
+	data->routes = routes;
+}
+
+void http_server_routes_init(void)
+{
+	size_t used = 0;
+
+	/* Resources are static, the tables only need to be built once */
+	if (routes_ready) {
+		return;
+	}
+
+	HTTP_SERVICE_FOREACH(svc) {
+		size_t count = HTTP_SERVICE_RESOURCE_COUNT(svc);
+
+		if (count == 0) {
+			continue;
+		}
+
+		if (count > ARRAY_SIZE(route_pool) - used) {
+			LOG_WRN("No room for %zu routes of service on port %u, "
+				"increase CONFIG_HTTP_SERVER_ROUTE_TABLE_SIZE",
+				count, *svc->port);
+			continue;
+		}
+
+		routes_build(svc, &route_pool[used]);
+		used += count;
+	}
+
+	routes_ready = true;
+}
+
+/* Return the position of the first resource with the given path which applies to
+ * the request, or UINT16_MAX if there is none.
+ */
+static uint16_t route_find(const struct http_service_desc *service, const char *key,
+			   size_t len, bool is_websocket)
 {
+	const struct http_route *routes = service->data->routes;
+	size_t low = 0;
+	size_t high = service->data->num_exact;
+
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+
+		if (route_cmp(&routes[mid], key, len) < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	for (; low < service->data->num_exact; low++) {
+		if (route_cmp(&routes[low], key, len) != 0) {
+			break;
+		}
+
+		if (!skip_this(&service->res_begin[routes[low].index], is_websocket)) {
+			return routes[low].index;
+		}
+	}
+
+	return UINT16_MAX;
+}
+
+/* Find the same resource as the linear lookup below. Every resource that would match
+ * the path there is a candidate here, and the one with the lowest position wins.
+ */
+static struct http_resource_detail *route_lookup(const struct http_service_desc *service,
+						 const char *path, int *path_len,
+						 bool is_websocket)
+{
+	const struct http_route *routes = service->data->routes;
+	size_t query_len = path_len_without_query(path);
+	uint16_t best;
+
+	/* Path without the query string, as compare_strings() sees it */
+	best = route_find(service, path, query_len, is_websocket);
+
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+		size_t len = strlen(path);
+
+		/* fnmatch() with FNM_LEADING_DIR matches a path without wildcards
+		 * against the whole path, or any leading part of it followed by '/'.
+		 */
+		if (len != query_len) {
+			best = MIN(best, route_find(service, path, len, is_websocket));
+		}
+
+		for (size_t i = 0; i < len; i++) {
+			if (path[i] == '/') {
+				best = MIN(best, route_find(service, path, i, is_websocket));
+			}
+		}
+
+		/* Wildcards only need to be tried until the best match so far */
+		for (size_t i = service->data->num_exact; i < service->data->num_routes; i++) {
+			if (routes[i].index >= best) {
+				break;
+			}
+
+			if (skip_this(&service->res_begin[routes[i].index], is_websocket)) {
+				continue;
+			}
+
+			/* Like in the linear lookup, the pattern may also match literally */
+			if (fnmatch(routes[i].resource, path, (FNM_PATHNAME | FNM_LEADING_DIR)) == 0 ||
+			    compare_strings(path, routes[i].resource) == 0) {
+				best = routes[i].index;
+				break;
+			}
+		}
+	}
+
+	if (best == UINT16_MAX) {
+		return NULL;
+	}
+
+	NET_DBG("Got match for %s", service->res_begin[best].resource);
+
+	/* Both fnmatch() and compare_strings() matches end where the query starts */
+	*path_len = query_len;
+
+	return service->res_begin[best].detail;
+}
+#endif /* CONFIG_HTTP_SERVER_ROUTE_TABLE */
+
+static struct http_resource_detail *find_resource(const struct http_service_desc *service,
+						  const char *path, int *path_len,
+						  bool is_websocket)
+{
+#if defined(CONFIG_HTTP_SERVER_ROUTE_TABLE)
+	if (service->data->routes != NULL) {
+		return route_lookup(service, path, path_len, is_websocket);
+	}
+#endif
+
 	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
 		if (skip_this(resource, is_websocket)) {
 			continue;
@@ -790,6 +1483,19 @@ struct http_resource_detail *get_resource_detail(const struct http_service_desc
 		}
 	}
 
+	return NULL;
+}
+
+struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
+						 const char *path, int *path_len, bool is_websocket)
+{
+	struct http_resource_detail *detail;
+
+	detail = find_resource(service, path, path_len, is_websocket);
+	if (detail != NULL) {
+		return detail;
+	}
+
 	if (service->res_fallback != NULL) {
 		*path_len = path_len_without_query(path);
 		return service->res_fallback;
@@ -901,6 +1607,45 @@ int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t
 	return 0;
 }
 
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+int http_server_sendall_file(struct http_client_ctx *client, struct fs_file_t *file, size_t len)
+{
+	while (len) {
+		ssize_t out_len = zsock_sendfile(client->fd, file, NULL, len);
+
+		if (out_len < 0) {
+			return -errno;
+		}
+
+		if (out_len == 0) {
+			/* The file is shorter than expected */
+			return -EIO;
+		}
+
+		len -= out_len;
+
+		http_client_timer_restart(client);
+	}
+
+	return 0;
+}
+
+/* zsock_sendfile() only has a small copy buffer for TLS sockets, which
+ * would then send the file as many short records. Keep using the
+ * larger response buffers for those.
+ */
+bool http_server_can_sendfile(struct http_client_ctx *client)
+{
+#if defined(CONFIG_NET_SOCKETS_SOCKOPT_TLS)
+	return client->service->sec_tag_list == NULL;
+#else
+	ARG_UNUSED(client);
+
+	return true;
+#endif
+}
+#endif /* CONFIG_NET_SOCKETS_SENDFILE */
+
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status status)
 {
 	if (status != HTTP_SERVER_DATA_FINAL) {
@@ -972,6 +1717,99 @@ int http_server_stop(void)
 	return 0;
 }
 
+#if HTTP_SERVER_WORKERS > 0
+static void http_server_worker_thread(void *p1, void *p2, void *p3)
+{
+	struct http_server_worker *worker = p1;
+	int ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&worker->start, K_FOREVER);
+
+		ret = http_server_run(&worker->ctx);
+		if (ret < 0) {
+			LOG_ERR("Worker %d stopped (%d)",
+				(int)ARRAY_INDEX(workers, worker), ret);
+		}
+
+		k_sem_give(&worker->stopped);
+	}
+}
+
+static void http_server_workers_create(void)
+{
+	ARRAY_FOR_EACH(workers, i) {
+		struct http_server_worker *worker = &workers[i];
+
+		worker->ctx = (struct http_server_ctx) {
+			.num_fds = ARRAY_SIZE(worker->fds),
+			.max_clients = ARRAY_SIZE(worker->clients),
+			.fds = worker->fds,
+			.clients = worker->clients,
+#if defined(CONFIG_HTTP_SERVER_EPOLL)
+			.epfd = -1,
+			.ready = worker->ready,
+#endif
+			.worker = worker,
+		};
+
+		k_msgq_init(&worker->handoff_q, (char *)worker->handoff_buf,
+			    sizeof(worker->handoff_buf[0]), ARRAY_SIZE(worker->handoff_buf));
+		k_sem_init(&worker->start, 0, 1);
+		k_sem_init(&worker->stopped, 0, 1);
+
+		k_thread_create(&worker->thread, worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				http_server_worker_thread, worker, NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&worker->thread, "http_server_worker");
+	}
+}
+
+static int http_server_workers_start(void)
+{
+	int ret;
+
+	ARRAY_FOR_EACH_PTR(workers, worker) {
+		ret = http_server_ctx_open(&worker->ctx);
+		if (ret < 0) {
+			return ret;
+		}
+
+		k_msgq_purge(&worker->handoff_q);
+		worker->stopping = false;
+		worker->started = true;
+
+		k_mutex_lock(&server_lock, K_FOREVER);
+		worker->active = 0;
+		worker->running = true;
+		k_mutex_unlock(&server_lock);
+
+		k_sem_give(&worker->start);
+	}
+
+	return 0;
+}
+
+static void http_server_workers_stop(void)
+{
+	ARRAY_FOR_EACH_PTR(workers, worker) {
+		if (!worker->started) {
+			continue;
+		}
+
+		worker->stopping = true;
+		(void)eventfd_write(worker->ctx.fds[0].fd, 1);
+
+		k_sem_take(&worker->stopped, K_FOREVER);
+		worker->started = false;
+	}
+}
+#endif /* HTTP_SERVER_WORKERS > 0 */
+
 static void http_server_thread(void *p1, void *p2, void *p3)
 {
 	int ret;
@@ -980,6 +1818,10 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
+#if HTTP_SERVER_WORKERS > 0
+	http_server_workers_create();
+#endif
+
 	while (true) {
 		k_sem_take(&server_start, K_FOREVER);
 
@@ -990,6 +1832,15 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 				goto again;
 			}
 
+#if HTTP_SERVER_WORKERS > 0
+			ret = http_server_workers_start();
+			if (ret < 0) {
+				LOG_ERR("Failed to start HTTP server workers");
+				close_all_sockets(&server_ctx);
+				goto again;
+			}
+#endif
+
 			ret = http_server_run(&server_ctx);
 			if (!server_running) {
 				continue;
@@ -370,7 +370,7 @@ static int dynamic_get_del_req(struct http_resource_detail_dynamic *dynamic_deta
 		len = 0;
 	} while (!http_response_is_final(&response_ctx, status));
 
-	dynamic_detail->holder = NULL;
+	http_server_release_resource(dynamic_detail, client);
 
 	ret = http_server_sendall(client, final_chunk,
 				  sizeof(final_chunk) - 1);
@@ -458,7 +458,7 @@ static int dynamic_post_put_req(struct http_resource_detail_dynamic *dynamic_det
 			return ret;
 		}
 
-		dynamic_detail->holder = NULL;
+		http_server_release_resource(dynamic_detail, client);
 	}
 
 	return 0;
@@ -561,8 +561,22 @@ BUILD_ASSERT(CONFIG_HTTP_SERVER_STATIC_FS_RESPONSE_SIZE >= STATIC_FS_RESPONSE_SI
 
 	client->http1_headers_sent = true;
 
-	/* read and send file */
 	remaining = file_size;
+
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+	if (http_server_can_sendfile(client)) {
+		/* the file is read straight into the network buffers */
+		ret = http_server_sendall_file(client, &file, remaining);
+		if (ret < 0) {
+			LOG_ERR("Sending %s failed (%d)", fname, ret);
+			goto close;
+		}
+
+		remaining = 0;
+	}
+#endif
+
+	/* read and send file */
 	while (remaining > 0) {
 		len = fs_read(&file, http_response, sizeof(http_response));
 		if (len < 0) {
@@ -576,6 +590,7 @@ BUILD_ASSERT(CONFIG_HTTP_SERVER_STATIC_FS_RESPONSE_SIZE >= STATIC_FS_RESPONSE_SI
 		}
 		remaining -= len;
 	}
+
 	ret = http_server_sendall(client, "\r\n\r\n", 4);
 
 close:
@@ -603,7 +618,7 @@ static int handle_http1_dynamic_resource(
 		return send_http1_405(client);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_claim_resource(dynamic_detail, client)) {
 		ret = send_http1_409(client);
 		if (ret < 0) {
 			return ret;
@@ -612,8 +627,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
@@ -624,7 +637,7 @@ static int handle_http1_dynamic_resource(
 			}
 
 			client->http1_headers_sent = true;
-			dynamic_detail->holder = NULL;
+			http_server_release_resource(dynamic_detail, client);
 
 			return 0;
 		}
@@ -451,6 +451,9 @@ out:
 }
 
 #if defined(CONFIG_FILE_SYSTEM)
+/* Well below the smallest SETTINGS_MAX_FRAME_SIZE a peer may announce */
+#define STATIC_FS_DATA_FRAME_LEN 1024
+
 static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs *static_fs_detail,
 					   struct http2_frame *frame,
 					   struct http_client_ctx *client)
@@ -528,8 +531,31 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		goto out;
 	}
 
-	/* read and send file */
 	remaining = client->data_len;
+
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+	/* only the frame headers are built here, the file is read straight
+	 * into the network buffers
+	 */
+	while (http_server_can_sendfile(client) && remaining > 0) {
+		len = MIN(remaining, STATIC_FS_DATA_FRAME_LEN);
+
+		remaining -= len;
+		ret = send_data_frame(client, NULL, len, frame->stream_identifier,
+				      (remaining > 0) ? 0 : HTTP2_FLAG_END_STREAM);
+		if (ret < 0) {
+			goto out;
+		}
+
+		ret = http_server_sendall_file(client, &file, len);
+		if (ret < 0) {
+			LOG_DBG("Cannot send file data (%d)", ret);
+			goto out;
+		}
+	}
+#endif
+
+	/* read and send file */
 	while (remaining > 0) {
 		len = fs_read(&file, tmp, sizeof(tmp));
 		if (len < 0) {
@@ -663,7 +689,7 @@ static int dynamic_get_del_req_v2(struct http_resource_detail_dynamic *dynamic_d
 		}
 	}
 
-	dynamic_detail->holder = NULL;
+	http_server_release_resource(dynamic_detail, client);
 
 	return ret;
 }
@@ -759,7 +785,7 @@ static int dynamic_post_put_req_v2(struct http_resource_detail_dynamic *dynamic_
 		}
 
 		client->current_stream->end_stream_sent = true;
-		dynamic_detail->holder = NULL;
+		http_server_release_resource(dynamic_detail, client);
 	}
 
 	return ret;
@@ -782,7 +808,7 @@ static int handle_http2_dynamic_resource(
 		return send_http2_405(client, frame);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_claim_resource(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -791,8 +817,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 	case HTTP_DELETE:
@@ -1495,7 +1519,7 @@ static int handle_http_frame_headers_end_stream(struct http_client_ctx *client)
 		ret = dynamic_detail->cb(client, HTTP_SERVER_DATA_FINAL, &request_ctx,
 					 &response_ctx, dynamic_detail->user_data);
 		if (ret < 0) {
-			dynamic_detail->holder = NULL;
+			http_server_release_resource(dynamic_detail, client);
 			goto out;
 		}
 
@@ -1504,7 +1528,7 @@ static int handle_http_frame_headers_end_stream(struct http_client_ctx *client)
 
 		ret = http2_dynamic_response(client, frame, &response_ctx, HTTP_SERVER_DATA_FINAL,
 					     dynamic_detail);
-		dynamic_detail->holder = NULL;
+		http_server_release_resource(dynamic_detail, client);
 
 		if (ret < 0) {
 			goto out;
@@ -553,6 +553,12 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, tcp.connrst));
 	PR("TCP pkt drop   %u\n", GET_STAT(iface, tcp.drop));
 #endif
+#if defined(CONFIG_NET_STATISTICS_GRO)
+	PR("GRO held       %u\tmerged\t%u\tflushed\t%u\n",
+	   GET_STAT(iface, gro.held),
+	   GET_STAT(iface, gro.merged),
+	   GET_STAT(iface, gro.flushed));
+#endif
 #if defined(CONFIG_NET_STATISTICS_DNS)
 	PR("DNS recv       %u\tsent\t%u\tdrop\t%u\n",
 	   GET_STAT(iface, dns.recv),
@@ -13,8 +13,13 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/net/net_pkt.h>
 #include <zephyr/internal/syscall_handler.h>
 
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+#include <zephyr/fs/fs.h>
+#endif
+
 #include "sockets_internal.h"
 
 #define VTABLE_CALL(fn, sock, ...)			     \
@@ -710,6 +715,336 @@ fail:
 #include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static int sock_mmsg_ioctl(const struct socket_op_vtable *vtable, void *obj,
+			   unsigned long request, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	if (vtable->fd_vtable.ioctl == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	return zvfs_fdtable_call_ioctl((const struct fd_op_vtable *)vtable,
+				       obj, request, msgvec, vlen, flags);
+}
+
+int z_impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	ssize_t len;
+	void *obj;
+	int ret;
+
+	if (msgvec == NULL && vlen > 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = sock_mmsg_ioctl(vtable, obj, ZFD_IOCTL_SENDMMSG, msgvec, vlen,
+			      flags);
+	if (ret < 0 && errno == EOPNOTSUPP && vtable->sendmsg != NULL) {
+		/* Sockets without a batch implementation, like TLS or
+		 * offloaded ones, still get the whole vector sent under
+		 * a single lock.
+		 */
+		for (i = 0; i < vlen; i++) {
+			len = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+			if (len < 0) {
+				break;
+			}
+
+			msgvec[i].msg_len = len;
+		}
+
+		ret = (i > 0 || vlen == 0) ? i : -1;
+	}
+
+	k_mutex_unlock(lock);
+
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		sock_obj_core_update_send_stats(sock, msgvec[i].msg_len);
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int len;
+	unsigned int i;
+	ssize_t ret;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	/* Every message needs its own kernel copy, so go through the single
+	 * message handler. This still saves a system call per message.
+	 */
+	for (i = 0; i < vlen; i++) {
+		ret = z_vrfy_zsock_sendmsg(sock, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		len = ret;
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &len, sizeof(len)));
+	}
+
+	return (i > 0 || vlen == 0) ? i : -1;
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	int msg_flags = flags & ~ZSOCK_MSG_WAITFORONE;
+	unsigned int i;
+	ssize_t len;
+	void *obj;
+	int ret;
+
+	if (msgvec == NULL && vlen > 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = sock_mmsg_ioctl(vtable, obj, ZFD_IOCTL_RECVMMSG, msgvec, vlen,
+			      flags);
+	if (ret < 0 && errno == EOPNOTSUPP && vtable->recvmsg != NULL) {
+		for (i = 0; i < vlen; i++) {
+			len = vtable->recvmsg(obj, &msgvec[i].msg_hdr, msg_flags);
+			if (len < 0) {
+				break;
+			}
+
+			msgvec[i].msg_len = len;
+
+			if (flags & ZSOCK_MSG_WAITFORONE) {
+				msg_flags |= ZSOCK_MSG_DONTWAIT;
+			}
+		}
+
+		ret = (i > 0 || vlen == 0) ? i : -1;
+	}
+
+	k_mutex_unlock(lock);
+
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		sock_obj_core_update_recv_stats(sock, msgvec[i].msg_len);
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	int msg_flags = flags & ~ZSOCK_MSG_WAITFORONE;
+	unsigned int len;
+	unsigned int i;
+	ssize_t ret;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	for (i = 0; i < vlen; i++) {
+		ret = z_vrfy_zsock_recvmsg(sock, &msgvec[i].msg_hdr, msg_flags);
+		if (ret < 0) {
+			break;
+		}
+
+		len = ret;
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &len, sizeof(len)));
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			msg_flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return (i > 0 || vlen == 0) ? i : -1;
+}
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_RX_LOAN)
+ssize_t zsock_recvmsg_loan(int sock, struct msghdr *msg, int flags,
+			   struct zsock_rx_loan *loan)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	ssize_t ret;
+
+	if (msg == NULL || loan == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Releasing the loan is then safe even if nothing was received */
+	loan->pkt = NULL;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	/* Only native sockets know about network buffers, the others
+	 * fail with EOPNOTSUPP.
+	 */
+	ret = zvfs_fdtable_call_ioctl((const struct fd_op_vtable *)vtable,
+				      obj, ZFD_IOCTL_RECV_LOAN, msg, flags, loan);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+void zsock_rx_loan_release(struct zsock_rx_loan *loan)
+{
+	if (loan == NULL || loan->pkt == NULL) {
+		return;
+	}
+
+	net_pkt_unref(loan->pkt);
+	loan->pkt = NULL;
+}
+#endif /* CONFIG_NET_SOCKETS_RX_LOAN */
+
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+/* Sockets that cannot read the file into their own buffers, like TLS or
+ * offloaded ones, get the data through a small intermediate buffer.
+ */
+static ssize_t sock_sendfile_copy(const struct socket_op_vtable *vtable,
+				  void *obj, struct fs_file_t *file,
+				  size_t count)
+{
+	uint8_t buf[128];
+	size_t sent = 0;
+	ssize_t done;
+	ssize_t len;
+	ssize_t out;
+
+	while (sent < count) {
+		len = fs_read(file, buf, MIN(sizeof(buf), count - sent));
+		if (len <= 0) {
+			if (len < 0 && sent == 0) {
+				errno = -len;
+				return -1;
+			}
+
+			break;
+		}
+
+		for (done = 0; done < len; done += out) {
+			out = vtable->sendto(obj, buf + done, len - done, 0,
+					     NULL, 0);
+			if (out < 0) {
+				/* Give the data not sent back to the file */
+				(void)fs_seek(file, done - len, FS_SEEK_CUR);
+				sent += done;
+
+				return sent > 0 ? sent : -1;
+			}
+		}
+
+		sent += len;
+	}
+
+	return sent;
+}
+
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t *offset,
+		       size_t count)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	off_t pos = 0;
+	ssize_t ret;
+	void *obj;
+
+	if (file == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (offset != NULL) {
+		pos = fs_tell(file);
+		if (pos < 0) {
+			errno = -pos;
+			return -1;
+		}
+
+		ret = fs_seek(file, *offset, FS_SEEK_SET);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	if (vtable->fd_vtable.ioctl != NULL) {
+		ret = zvfs_fdtable_call_ioctl((const struct fd_op_vtable *)vtable,
+					      obj, ZFD_IOCTL_SENDFILE, file, count);
+	} else {
+		errno = EOPNOTSUPP;
+		ret = -1;
+	}
+
+	if (ret < 0 && errno == EOPNOTSUPP && vtable->sendto != NULL) {
+		ret = sock_sendfile_copy(vtable, obj, file, count);
+	}
+
+	k_mutex_unlock(lock);
+
+	if (offset != NULL) {
+		if (ret > 0) {
+			*offset += ret;
+		}
+
+		(void)fs_seek(file, pos, FS_SEEK_SET);
+	}
+
+	sock_obj_core_update_send_stats(sock, ret);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_SENDFILE */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -23,6 +23,10 @@ LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/iterable_sections.h>
 
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+#include <zephyr/fs/fs.h>
+#endif
+
 #if defined(CONFIG_SOCKS)
 #include "socks.h"
 #endif
@@ -1077,13 +1081,44 @@ static int update_msg_controllen(struct msghdr *msg)
 	return 0;
 }
 
+/* Point the message iovecs to the data left in the packet buffers */
+static size_t sock_loan_pkt_data(struct net_pkt *pkt, struct msghdr *msg,
+				 size_t len)
+{
+	struct net_buf *buf = pkt->cursor.buf;
+	uint8_t *pos = pkt->cursor.pos;
+	size_t loaned = 0;
+	size_t iovec = 0;
+
+	while (buf != NULL && loaned < len && iovec < msg->msg_iovlen) {
+		size_t frag_len = MIN(len - loaned, buf->len - (pos - buf->data));
+
+		if (frag_len > 0) {
+			msg->msg_iov[iovec].iov_base = pos;
+			msg->msg_iov[iovec].iov_len = frag_len;
+			loaned += frag_len;
+			iovec++;
+		}
+
+		buf = buf->frags;
+		if (buf != NULL) {
+			pos = buf->data;
+		}
+	}
+
+	msg->msg_iovlen = iovec;
+
+	return loaned;
+}
+
 static ssize_t zsock_recv_dgram(struct net_context *ctx,
 				struct msghdr *msg,
 				void *buf,
 				size_t max_len,
 				int flags,
 				struct sockaddr *src_addr,
-				socklen_t *addrlen)
+				socklen_t *addrlen,
+				struct zsock_rx_loan *loan)
 {
 	k_timeout_t timeout = K_FOREVER;
 	size_t recv_len = 0;
@@ -1173,7 +1208,13 @@ static ssize_t zsock_recv_dgram(struct net_context *ctx,
 		}
 
 		recv_len = net_pkt_remaining_data(pkt);
-		tmp_read_len = read_len = MIN(recv_len, max_len);
+
+		if (IS_ENABLED(CONFIG_NET_SOCKETS_RX_LOAN) && loan != NULL) {
+			read_len = sock_loan_pkt_data(pkt, msg, recv_len);
+			tmp_read_len = 0;
+		} else {
+			tmp_read_len = read_len = MIN(recv_len, max_len);
+		}
 
 		while (tmp_read_len > 0) {
 			size_t len;
@@ -1250,8 +1291,17 @@ static ssize_t zsock_recv_dgram(struct net_context *ctx,
 	}
 
 	if (!(flags & ZSOCK_MSG_PEEK)) {
-		net_pkt_unref(pkt);
+		if (loan != NULL) {
+			/* The application now owns the packet */
+			loan->pkt = pkt;
+		} else {
+			net_pkt_unref(pkt);
+		}
 	} else {
+		if (loan != NULL) {
+			loan->pkt = net_pkt_ref(pkt);
+		}
+
 		net_pkt_cursor_restore(pkt, &backup);
 	}
 
@@ -1484,7 +1534,8 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	}
 
 	if (sock_type == SOCK_DGRAM || sock_type == SOCK_RAW) {
-		return zsock_recv_dgram(ctx, NULL, buf, max_len, flags, src_addr, addrlen);
+		return zsock_recv_dgram(ctx, NULL, buf, max_len, flags, src_addr, addrlen,
+					NULL);
 	} else if (sock_type == SOCK_STREAM) {
 		return zsock_recv_stream(ctx, NULL, buf, max_len, flags);
 	}
@@ -1518,7 +1569,7 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 
 	if (sock_type == SOCK_DGRAM || sock_type == SOCK_RAW) {
 		return zsock_recv_dgram(ctx, msg, NULL, max_len, flags,
-					msg->msg_name, &msg->msg_namelen);
+					msg->msg_name, &msg->msg_namelen, NULL);
 	} else if (sock_type == SOCK_STREAM) {
 		return zsock_recv_stream(ctx, msg, NULL, max_len, flags);
 	}
@@ -1530,6 +1581,154 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 	return -1;
 }
 
+#if defined(CONFIG_NET_SOCKETS_RX_LOAN)
+static ssize_t zsock_recvmsg_loan_ctx(struct net_context *ctx,
+				      struct msghdr *msg, int flags,
+				      struct zsock_rx_loan *loan)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+
+	loan->pkt = NULL;
+
+	/* A stream is not consumed packet by packet */
+	if (sock_type != SOCK_DGRAM && sock_type != SOCK_RAW) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (msg->msg_iov == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	return zsock_recv_dgram(ctx, msg, NULL, 0, flags, msg->msg_name,
+				&msg->msg_namelen, loan);
+}
+#endif /* CONFIG_NET_SOCKETS_RX_LOAN */
+
+static int zsock_sendmmsg_ctx(struct net_context *ctx,
+			      struct zsock_mmsghdr *msgvec, unsigned int vlen,
+			      int flags)
+{
+	unsigned int i;
+	ssize_t ret;
+
+	for (i = 0; i < vlen; i++) {
+		ret = zsock_sendmsg_ctx(ctx, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	/* An error is only reported if nothing was sent, the caller
+	 * finds out about it on the next call otherwise.
+	 */
+	return (i > 0 || vlen == 0) ? i : -1;
+}
+
+static int zsock_recvmmsg_ctx(struct net_context *ctx,
+			      struct zsock_mmsghdr *msgvec, unsigned int vlen,
+			      int flags)
+{
+	unsigned int i;
+	ssize_t ret;
+
+	for (i = 0; i < vlen; i++) {
+		ret = zsock_recvmsg_ctx(ctx, &msgvec[i].msg_hdr,
+					flags & ~ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return (i > 0 || vlen == 0) ? i : -1;
+}
+
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+static int sock_sendfile_read(void *dst, size_t len, void *user_data)
+{
+	return fs_read(user_data, dst, len);
+}
+
+static ssize_t zsock_sendfile_ctx(struct net_context *ctx,
+				  struct fs_file_t *file, size_t count)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	size_t sent = 0;
+	int status;
+
+	/* Only native TCP keeps the data in its own buffers, which the file
+	 * can then be read into.
+	 */
+	if (net_context_get_type(ctx) != SOCK_STREAM ||
+	    net_context_get_proto(ctx) != IPPROTO_TCP ||
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+	}
+
+	buf_timeout = sys_timepoint_calc(K_TIMEOUT_EQ(timeout, K_NO_WAIT) ?
+					 K_NO_WAIT : MAX_WAIT_BUFS);
+	end = sys_timepoint_calc(timeout);
+
+	while (sent < count) {
+		status = net_tcp_queue_fill(ctx, count - sent, sock_sendfile_read,
+					    file);
+		if (status == 0) {
+			/* End of the file */
+			break;
+		}
+
+		if (status < 0) {
+			/* Report what was sent so far, unless the send window
+			 * is just full and we may wait for it.
+			 */
+			if (sent > 0 && (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
+					 (status != -EAGAIN && status != -ENOBUFS))) {
+				break;
+			}
+
+			status = send_check_and_wait(ctx, status, buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				return sent > 0 ? sent : status;
+			}
+
+			/* Update the timeout value in case loop is repeated. */
+			timeout = sys_timepoint_timeout(end);
+
+			continue;
+		}
+
+		sent += status;
+
+		/* The waits are limited for each chunk, not for the whole file */
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+			retry_timeout = WAIT_BUFS_INITIAL_MS;
+		}
+	}
+
+	return sent;
+}
+#endif /* CONFIG_NET_SOCKETS_SENDFILE */
+
 static int zsock_poll_prepare_ctx(struct net_context *ctx,
 				  struct zsock_pollfd *pfd,
 				  struct k_poll_event **pev,
@@ -1897,6 +2096,24 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, optval, optlen);
 			return ret;
 
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				size_t len = *optlen;
+
+				ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+							 optval, &len);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				*optlen = len;
+
+				return 0;
+			}
+
+			break;
+
 		case TCP_KEEPIDLE:
 			__fallthrough;
 		case TCP_KEEPINTVL:
@@ -2528,6 +2745,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 						 TCP_OPT_NODELAY, optval, optlen);
 			return ret;
 
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case TCP_KEEPIDLE:
 			__fallthrough;
 		case TCP_KEEPINTVL:
@@ -2999,6 +3230,56 @@ static int sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 		return 0;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_RX_LOAN)
+	case ZFD_IOCTL_RECV_LOAN: {
+		struct msghdr *msg;
+		struct zsock_rx_loan *loan;
+		int flags;
+
+		msg = va_arg(args, struct msghdr *);
+		flags = va_arg(args, int);
+		loan = va_arg(args, struct zsock_rx_loan *);
+
+		return zsock_recvmsg_loan_ctx(obj, msg, flags, loan);
+	}
+#endif
+
+	case ZFD_IOCTL_SENDMMSG: {
+		struct zsock_mmsghdr *msgvec;
+		unsigned int vlen;
+		int flags;
+
+		msgvec = va_arg(args, struct zsock_mmsghdr *);
+		vlen = va_arg(args, unsigned int);
+		flags = va_arg(args, int);
+
+		return zsock_sendmmsg_ctx(obj, msgvec, vlen, flags);
+	}
+
+	case ZFD_IOCTL_RECVMMSG: {
+		struct zsock_mmsghdr *msgvec;
+		unsigned int vlen;
+		int flags;
+
+		msgvec = va_arg(args, struct zsock_mmsghdr *);
+		vlen = va_arg(args, unsigned int);
+		flags = va_arg(args, int);
+
+		return zsock_recvmmsg_ctx(obj, msgvec, vlen, flags);
+	}
+
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+	case ZFD_IOCTL_SENDFILE: {
+		struct fs_file_t *file;
+		size_t count;
+
+		file = va_arg(args, struct fs_file_t *);
+		count = va_arg(args, size_t);
+
+		return zsock_sendfile_ctx(obj, file, count);
+	}
+#endif
+
 	default:
 		errno = EOPNOTSUPP;
 		return -1;
@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_sock_svc, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/net/socket_service.h>
+#include <zephyr/zvfs/epoll.h>
 #include <zephyr/zvfs/eventfd.h>
 
 static int init_socket_service(void);
@@ -28,8 +29,16 @@ static K_CONDVAR_DEFINE(wait_start);
 STRUCT_SECTION_START_EXTERN(net_socket_service_desc);
 STRUCT_SECTION_END_EXTERN(net_socket_service_desc);
 
+/* Number of ready sockets fetched by one epoll wait */
+#define SERVICE_EPOLL_EVENTS 4
+
 static struct service {
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	struct zvfs_epoll_event ready[SERVICE_EPOLL_EVENTS];
+	int epfd;
+#else
 	struct zsock_pollfd events[CONFIG_ZVFS_POLL_MAX];
+#endif
 	int count;
 } ctx;
 
@@ -42,6 +51,52 @@ void net_socket_service_foreach(net_socket_service_cb_t cb, void *user_data)
 	}
 }
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+static void epoll_del_svc_events(const struct net_socket_service_desc *svc)
+{
+	for (int i = 0; i < svc->pev_len; i++) {
+		if (svc->pev[i].event.fd < 0) {
+			continue;
+		}
+
+		(void)zvfs_epoll_ctl(ctx.epfd, ZVFS_EPOLL_CTL_DEL, svc->pev[i].event.fd, NULL);
+	}
+}
+
+static int epoll_add_svc_events(const struct net_socket_service_desc *svc)
+{
+	struct zvfs_epoll_event ev;
+
+	for (int i = 0; i < svc->pev_len; i++) {
+		if (svc->pev[i].event.fd < 0) {
+			continue;
+		}
+
+		ev.events = (uint16_t)svc->pev[i].event.events;
+		ev.data.ptr = &svc->pev[i];
+
+		if (zvfs_epoll_ctl(ctx.epfd, ZVFS_EPOLL_CTL_ADD, svc->pev[i].event.fd,
+				   &ev) < 0) {
+			int ret = -errno;
+
+			NET_DBG("Cannot monitor fd %d (%d)", svc->pev[i].event.fd, ret);
+
+			/* Do not leave the service half registered */
+			for (int j = 0; j < i; j++) {
+				if (svc->pev[j].event.fd >= 0) {
+					(void)zvfs_epoll_ctl(ctx.epfd, ZVFS_EPOLL_CTL_DEL,
+							     svc->pev[j].event.fd, NULL);
+				}
+			}
+
+			return ret;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_SERVICE_EPOLL */
+
 static void cleanup_svc_events(const struct net_socket_service_desc *svc)
 {
 	for (int i = 0; i < svc->pev_len; i++) {
@@ -71,6 +126,10 @@ int z_impl_net_socket_service_register(const struct net_socket_service_desc *svc
 		goto out;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	epoll_del_svc_events(svc);
+#endif
+
 	cleanup_svc_events(svc);
 
 	if (fds != NULL) {
@@ -85,12 +144,23 @@ int z_impl_net_socket_service_register(const struct net_socket_service_desc *svc
 		for (i = 0; i < len; i++) {
 			svc->pev[i].event = fds[i];
 			svc->pev[i].user_data = user_data;
+			svc->pev[i].svc = (struct net_socket_service_desc *)svc;
 		}
 	}
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	/* Only the sockets of this service are updated, the thread
+	 * does not need to restart.
+	 */
+	ret = epoll_add_svc_events(svc);
+	if (ret < 0) {
+		cleanup_svc_events(svc);
+	}
+#else
 	/* Tell the thread to re-read the variables */
 	zvfs_eventfd_write(ctx.events[0].fd, 1);
 	ret = 0;
+#endif
 
 out:
 	k_mutex_unlock(&lock);
@@ -98,6 +168,7 @@ out:
 	return ret;
 }
 
+#if !defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
 static struct net_socket_service_desc *find_svc_and_event(
 	struct zsock_pollfd *pev,
 	struct net_socket_service_event **event)
@@ -113,6 +184,7 @@ static struct net_socket_service_desc *find_svc_and_event(
 
 	return NULL;
 }
+#endif /* !CONFIG_NET_SOCKETS_SERVICE_EPOLL */
 
 /* We do not set the user callback to our work struct because we need to
  * hook into the flow and restore the global poll array so that the next poll
@@ -126,6 +198,7 @@ void net_socket_service_callback(struct net_socket_service_event *pev)
 	ev.callback(&ev);
 }
 
+#if !defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
 static int call_work(struct zsock_pollfd *pev, struct net_socket_service_event *event)
 {
 	int ret = 0;
@@ -164,6 +237,36 @@ static int trigger_work(struct zsock_pollfd *pev)
 
 	return call_work(pev, event);
 }
+#endif /* !CONFIG_NET_SOCKETS_SERVICE_EPOLL */
+
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+static int socket_service_epoll_loop(void)
+{
+	struct net_socket_service_event *event;
+	int ret;
+
+	while (true) {
+		ret = zvfs_epoll_wait(ctx.epfd, ctx.ready, ARRAY_SIZE(ctx.ready), -1);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			event = ctx.ready[i].data.ptr;
+
+			/* An earlier callback may have unregistered the socket */
+			if (event->event.fd < 0) {
+				continue;
+			}
+
+			event->event.revents = (short)ctx.ready[i].events;
+
+			/* Synchronous call */
+			net_socket_service_callback(event);
+		}
+	}
+}
+#endif /* CONFIG_NET_SOCKETS_SERVICE_EPOLL */
 
 static void socket_service_thread(void *p1, void *p2, void *p3)
 {
@@ -171,8 +274,11 @@ static void socket_service_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
-	int ret, i, fd, count = 0;
+	int ret, count = 0;
+#if !defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	int i, fd;
 	zvfs_eventfd_t value;
+#endif
 
 	STRUCT_SECTION_COUNT(net_socket_service_desc, &ret);
 	if (ret == 0) {
@@ -190,6 +296,32 @@ static void socket_service_thread(void *p1, void *p2, void *p3)
 		count += svc->pev_len;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	if (count > CONFIG_ZVFS_EPOLL_MAX_ITEMS) {
+		NET_ERR("You have %d services to monitor but "
+			"%d epoll entries configured.",
+			count, CONFIG_ZVFS_EPOLL_MAX_ITEMS);
+		NET_ERR("Please increase value of %s to at least %d",
+			"CONFIG_ZVFS_EPOLL_MAX_ITEMS", count);
+		goto fail;
+	}
+
+	NET_DBG("Monitoring %d socket entries", count);
+
+	ctx.count = count;
+
+	ctx.epfd = zvfs_epoll_create(0);
+	if (ctx.epfd < 0) {
+		NET_ERR("zvfs_epoll_create failed (%d)", -errno);
+		goto fail;
+	}
+
+	thread_status = SOCKET_SERVICE_THREAD_RUNNING;
+	k_condvar_broadcast(&wait_start);
+
+	ret = socket_service_epoll_loop();
+	NET_ERR("epoll wait failed (%d)", ret);
+#else
 	if ((count + 1) > ARRAY_SIZE(ctx.events)) {
 		NET_ERR("You have %d services to monitor but "
 			"%zd poll entries configured.",
@@ -269,6 +401,7 @@ restart:
 	}
 
 out:
+#endif /* CONFIG_NET_SOCKETS_SERVICE_EPOLL */
 	NET_DBG("Socket service thread stopped");
 	thread_status = SOCKET_SERVICE_THREAD_STOPPED;
 
@@ -1003,6 +1003,27 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'm': {
+			int batch = parse_arg(&i, argc, argv);
+
+			if (!is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "TCP does not support -m option\n");
+				return -ENOEXEC;
+			}
+			if (batch < 1 || batch > CONFIG_NET_ZPERF_UDP_BATCH_MAX) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s, valid range is "
+					      "[1, %d]\n", argv[i],
+					      CONFIG_NET_ZPERF_UDP_BATCH_MAX);
+				return -ENOEXEC;
+			}
+
+			param.options.udp_batch = batch;
+			opt_cnt += 2;
+			break;
+		}
+
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		case 't':
 			param.options.thread_priority = parse_arg(&i, argc, argv);
@@ -1256,6 +1277,27 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'm': {
+			int batch = parse_arg(&i, argc, argv);
+
+			if (!is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "TCP does not support -m option\n");
+				return -ENOEXEC;
+			}
+			if (batch < 1 || batch > CONFIG_NET_ZPERF_UDP_BATCH_MAX) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s, valid range is "
+					      "[1, %d]\n", argv[i],
+					      CONFIG_NET_ZPERF_UDP_BATCH_MAX);
+				return -ENOEXEC;
+			}
+
+			param.options.udp_batch = batch;
+			opt_cnt += 2;
+			break;
+		}
+
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		case 't':
 			param.options.thread_priority = parse_arg(&i, argc, argv);
@@ -1992,6 +2034,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
 		  "-I: Specify host interface name\n"
+		  "-m count: Send count packets per sendmmsg() call\n"
 		  "Example: udp upload 192.0.2.2 1111 1 1K 1M\n"
 		  "Example: udp upload 2001:db8::2\n",
 		  cmd_udp_upload),
@@ -2017,6 +2060,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
 		  "-I: Specify host interface name\n"
+		  "-m count: Send count packets per sendmmsg() call\n"
 		  "Example: udp upload2 v4 1 1K 1M\n"
 		  "Example: udp upload2 v6\n"
 #if defined(CONFIG_NET_IPV6) && defined(MY_IP6ADDR_SET)
@@ -19,6 +19,16 @@ static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
 			     sizeof(struct zperf_client_hdr_v1) +
 			     PACKET_SIZE_MAX];
 
+#define UDP_HEADER_SIZE (sizeof(struct zperf_udp_datagram) + \
+			 sizeof(struct zperf_client_hdr_v1))
+
+/* In batch mode every datagram gets its own header, the payload that
+ * follows it is shared.
+ */
+static uint8_t batch_hdrs[CONFIG_NET_ZPERF_UDP_BATCH_MAX][UDP_HEADER_SIZE];
+static struct iovec batch_iov[CONFIG_NET_ZPERF_UDP_BATCH_MAX][2];
+static struct zsock_mmsghdr batch_msgs[CONFIG_NET_ZPERF_UDP_BATCH_MAX];
+
 #if !defined(CONFIG_ZPERF_SESSION_PER_THREAD)
 static struct zperf_async_upload_context udp_async_upload_ctx;
 #endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
@@ -146,18 +156,65 @@ static inline int zperf_upload_fin(int sock,
 	return 0;
 }
 
+static void udp_fill_header(uint8_t *buf, uint32_t id, uint32_t secs,
+			    uint32_t usecs, int port, uint32_t rate_in_kbps,
+			    uint32_t packet_size)
+{
+	struct zperf_udp_datagram *datagram;
+	struct zperf_client_hdr_v1 *hdr;
+
+	datagram = (struct zperf_udp_datagram *)buf;
+
+	datagram->id = htonl(id);
+	datagram->tv_sec = htonl(secs);
+	datagram->tv_usec = htonl(usecs);
+
+	hdr = (struct zperf_client_hdr_v1 *)(buf + sizeof(*datagram));
+	hdr->flags = 0;
+	hdr->num_of_threads = htonl(1);
+	hdr->port = htonl(port);
+	hdr->buffer_len = sizeof(sample_packet) -
+		sizeof(*datagram) - sizeof(*hdr);
+	hdr->bandwidth = htonl(rate_in_kbps);
+	hdr->num_of_bytes = htonl(packet_size);
+}
+
+static int udp_send_batch(int sock, unsigned int count, uint32_t id,
+			  uint32_t secs, uint32_t usecs, int port,
+			  uint32_t rate_in_kbps, uint32_t packet_size)
+{
+	size_t header_len = MIN(packet_size, UDP_HEADER_SIZE);
+
+	for (unsigned int i = 0; i < count; i++) {
+		udp_fill_header(batch_hdrs[i], id + i, secs, usecs, port,
+				rate_in_kbps, packet_size);
+
+		batch_iov[i][0].iov_base = batch_hdrs[i];
+		batch_iov[i][0].iov_len = header_len;
+		batch_iov[i][1].iov_base = sample_packet + header_len;
+		batch_iov[i][1].iov_len = packet_size - header_len;
+
+		batch_msgs[i].msg_hdr = (struct msghdr) {
+			.msg_iov = batch_iov[i],
+			.msg_iovlen = ARRAY_SIZE(batch_iov[i]),
+		};
+	}
+
+	return zsock_sendmmsg(sock, batch_msgs, count, 0);
+}
+
 static int udp_upload(int sock, int port,
 		      const struct zperf_upload_params *param,
 		      struct zperf_results *results)
 {
-	size_t header_size =
-		sizeof(struct zperf_udp_datagram) + sizeof(struct zperf_client_hdr_v1);
+	size_t header_size = UDP_HEADER_SIZE;
 	uint32_t duration_in_ms = param->duration_ms;
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
 	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps);
-	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
-	uint32_t delay = packet_duration;
+	uint32_t batch = CLAMP(param->options.udp_batch, 1, CONFIG_NET_ZPERF_UDP_BATCH_MAX);
+	uint32_t packet_duration;
+	uint32_t delay;
 	uint64_t data_offset = 0U;
 	uint32_t nb_packets = 0U;
 	uint64_t usecs64;
@@ -175,6 +232,15 @@ static int udp_upload(int sock, int port,
 		packet_size = header_size;
 	}
 
+	if (batch > 1 && param->data_loader != NULL) {
+		NET_WARN("Custom data payload, sending one packet per call");
+		batch = 1;
+	}
+
+	/* Each iteration of the loop sends a whole batch */
+	packet_duration = k_us_to_ticks_ceil32(packet_duration_us * batch);
+	delay = packet_duration;
+
 	/* Start the loop */
 	start_time = k_uptime_ticks();
 	last_loop_time = start_time;
@@ -188,8 +254,6 @@ static int udp_upload(int sock, int port,
 	(void)memset(sample_packet, 'z', sizeof(sample_packet));
 
 	do {
-		struct zperf_udp_datagram *datagram;
-		struct zperf_client_hdr_v1 *hdr;
 		uint32_t secs, usecs;
 		int64_t loop_time;
 		int32_t adjust;
@@ -219,41 +283,40 @@ static int udp_upload(int sock, int port,
 		secs = usecs64 / USEC_PER_SEC;
 		usecs = usecs64 % USEC_PER_SEC;
 
-		/* Fill the packet header */
-		datagram = (struct zperf_udp_datagram *)sample_packet;
-
-		datagram->id = htonl(nb_packets);
-		datagram->tv_sec = htonl(secs);
-		datagram->tv_usec = htonl(usecs);
-
-		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
-						     sizeof(*datagram));
-		hdr->flags = 0;
-		hdr->num_of_threads = htonl(1);
-		hdr->port = htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
-			sizeof(*datagram) - sizeof(*hdr);
-		hdr->bandwidth = htonl(rate_in_kbps);
-		hdr->num_of_bytes = htonl(packet_size);
-
-		/* Load custom data payload if requested */
-		if (param->data_loader != NULL) {
-			ret = param->data_loader(param->data_loader_ctx, data_offset,
-				sample_packet + header_size, packet_size - header_size);
+		if (batch > 1) {
+			/* Send the packets */
+			ret = udp_send_batch(sock, batch, nb_packets, secs, usecs,
+					     port, rate_in_kbps, packet_size);
 			if (ret < 0) {
-				NET_ERR("Failed to load data for offset %llu", data_offset);
-				return ret;
+				NET_ERR("Failed to send the packets (%d)", errno);
+				return -errno;
 			}
-		}
-		data_offset += packet_size - header_size;
 
-		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
-		if (ret < 0) {
-			NET_ERR("Failed to send the packet (%d)", errno);
-			return -errno;
+			nb_packets += ret;
 		} else {
-			nb_packets++;
+			/* Fill the packet header */
+			udp_fill_header(sample_packet, nb_packets, secs, usecs, port,
+					rate_in_kbps, packet_size);
+
+			/* Load custom data payload if requested */
+			if (param->data_loader != NULL) {
+				ret = param->data_loader(param->data_loader_ctx, data_offset,
+					sample_packet + header_size, packet_size - header_size);
+				if (ret < 0) {
+					NET_ERR("Failed to load data for offset %llu", data_offset);
+					return ret;
+				}
+			}
+			data_offset += packet_size - header_size;
+
+			/* Send the packet */
+			ret = zsock_send(sock, sample_packet, packet_size, 0);
+			if (ret < 0) {
+				NET_ERR("Failed to send the packet (%d)", errno);
+				return -errno;
+			} else {
+				nb_packets++;
+			}
 		}
 
 		if (IS_ENABLED(CONFIG_NET_ZPERF_LOG_LEVEL_DBG)) {
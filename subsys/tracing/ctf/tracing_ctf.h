@@ -213,6 +213,9 @@ extern "C" {
 #define sys_port_trace_k_queue_get_enter(queue, timeout)
 #define sys_port_trace_k_queue_get_blocking(queue, timeout)
 #define sys_port_trace_k_queue_get_exit(queue, timeout, ret)
+#define sys_port_trace_k_queue_get_many_enter(queue, timeout)
+#define sys_port_trace_k_queue_get_many_blocking(queue, timeout)
+#define sys_port_trace_k_queue_get_many_exit(queue, timeout, ret)
 #define sys_port_trace_k_queue_remove_enter(queue)
 #define sys_port_trace_k_queue_remove_exit(queue, ret)
 #define sys_port_trace_k_queue_unique_append_enter(queue)
@@ -234,6 +237,8 @@ extern "C" {
 #define sys_port_trace_k_fifo_put_slist_exit(fifo, list)
 #define sys_port_trace_k_fifo_get_enter(fifo, timeout)
 #define sys_port_trace_k_fifo_get_exit(fifo, timeout, ret)
+#define sys_port_trace_k_fifo_get_batch_enter(fifo, timeout)
+#define sys_port_trace_k_fifo_get_batch_exit(fifo, timeout, ret)
 #define sys_port_trace_k_fifo_peek_head_enter(fifo)
 #define sys_port_trace_k_fifo_peek_head_exit(fifo, ret)
 #define sys_port_trace_k_fifo_peek_tail_enter(fifo)
@@ -273,6 +278,10 @@ extern "C" {
 #define sys_port_trace_k_msgq_get_enter(msgq, timeout)
 #define sys_port_trace_k_msgq_get_blocking(msgq, timeout)
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret)
 #define sys_port_trace_k_msgq_purge(msgq)
 
@@ -457,6 +457,16 @@ void sys_trace_k_queue_get_exit(struct k_queue *queue, k_timeout_t timeout, void
 	TRACING_STRING("%s: %p\n", __func__, queue);
 }
 
+void sys_trace_k_queue_get_many_blocking(struct k_queue *queue, k_timeout_t timeout)
+{
+	TRACING_STRING("%s: %p\n", __func__, queue);
+}
+
+void sys_trace_k_queue_get_many_exit(struct k_queue *queue, k_timeout_t timeout, int ret)
+{
+	TRACING_STRING("%s: %p\n", __func__, queue);
+}
+
 void sys_trace_k_queue_peek_head(struct k_queue *queue, void *ret)
 {
 	TRACING_STRING("%s: %p\n", __func__, queue);
@@ -534,6 +544,38 @@ void sys_trace_k_fifo_get_exit(struct k_fifo *fifo, k_timeout_t timeout, void *r
 	TRACING_STRING("%s: %p\n", __func__, fifo);
 }
 
+void sys_trace_k_fifo_get_batch_enter(struct k_fifo *fifo, k_timeout_t timeout)
+{
+	TRACING_STRING("%s: %p\n", __func__, fifo);
+}
+
+void sys_trace_k_fifo_get_batch_exit(struct k_fifo *fifo, k_timeout_t timeout, int ret)
+{
+	TRACING_STRING("%s: %p\n", __func__, fifo);
+}
+
+void sys_trace_k_msgq_put_many_enter(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
+{
+	TRACING_STRING("%s: %p\n", __func__, msgq);
+}
+
+void sys_trace_k_msgq_put_many_exit(struct k_msgq *msgq, const void *data, k_timeout_t timeout,
+				    int ret)
+{
+	TRACING_STRING("%s: %p\n", __func__, msgq);
+}
+
+void sys_trace_k_msgq_get_many_enter(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
+{
+	TRACING_STRING("%s: %p\n", __func__, msgq);
+}
+
+void sys_trace_k_msgq_get_many_exit(struct k_msgq *msgq, const void *data, k_timeout_t timeout,
+				    int ret)
+{
+	TRACING_STRING("%s: %p\n", __func__, msgq);
+}
+
 void sys_trace_syscall_enter(uint32_t syscall_id, const char *syscall_name)
 {
 	TRACING_STRING("%s: %s (%u) enter\n", __func__, syscall_name, syscall_id);
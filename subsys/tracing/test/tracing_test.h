@@ -193,6 +193,11 @@
 	sys_trace_k_queue_get_blocking(queue, timeout)
 #define sys_port_trace_k_queue_get_exit(queue, timeout, ret)                                       \
 	sys_trace_k_queue_get_exit(queue, timeout, ret)
+#define sys_port_trace_k_queue_get_many_enter(queue, timeout)
+#define sys_port_trace_k_queue_get_many_blocking(queue, timeout)                                   \
+	sys_trace_k_queue_get_many_blocking(queue, timeout)
+#define sys_port_trace_k_queue_get_many_exit(queue, timeout, ret)                                  \
+	sys_trace_k_queue_get_many_exit(queue, timeout, ret)
 #define sys_port_trace_k_queue_remove_enter(queue) sys_trace_k_queue_remove_enter(queue, data)
 #define sys_port_trace_k_queue_remove_exit(queue, ret)                                             \
 	sys_trace_k_queue_remove_exit(queue, data, ret)
@@ -239,6 +244,12 @@
 #define sys_port_trace_k_fifo_get_exit(fifo, timeout, ret)                                         \
 	sys_trace_k_fifo_get_exit(fifo, timeout, ret)
 
+#define sys_port_trace_k_fifo_get_batch_enter(fifo, timeout)                                       \
+	sys_trace_k_fifo_get_batch_enter(fifo, timeout)
+
+#define sys_port_trace_k_fifo_get_batch_exit(fifo, timeout, ret)                                   \
+	sys_trace_k_fifo_get_batch_exit(fifo, timeout, ret)
+
 #define sys_port_trace_k_fifo_peek_head_enter(fifo) sys_trace_k_fifo_peek_head_enter(fifo)
 
 #define sys_port_trace_k_fifo_peek_head_exit(fifo, ret) sys_trace_k_fifo_peek_head_exit(fifo, ret)
@@ -326,6 +337,16 @@
 	sys_trace_k_msgq_get_blocking(msgq, data, timeout)
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)                                         \
 	sys_trace_k_msgq_get_exit(msgq, data, timeout, ret)
+
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)                                        \
+	sys_trace_k_msgq_put_many_enter(msgq, data, timeout)
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)                                    \
+	sys_trace_k_msgq_put_many_exit(msgq, data, timeout, ret)
+
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)                                        \
+	sys_trace_k_msgq_get_many_enter(msgq, data, timeout)
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)                                    \
+	sys_trace_k_msgq_get_many_exit(msgq, data, timeout, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret) sys_trace_k_msgq_peek(msgq, data, ret)
 #define sys_port_trace_k_msgq_purge(msgq) sys_trace_k_msgq_purge(msgq)
 
@@ -580,6 +601,8 @@ void sys_trace_k_queue_merge_slist_enter(struct k_queue *queue, sys_slist_t *lis
 void sys_trace_k_queue_merge_slist_exit(struct k_queue *queue, sys_slist_t *list, int ret);
 void sys_trace_k_queue_get_blocking(struct k_queue *queue, k_timeout_t timeout);
 void sys_trace_k_queue_get_exit(struct k_queue *queue, k_timeout_t timeout, void *ret);
+void sys_trace_k_queue_get_many_blocking(struct k_queue *queue, k_timeout_t timeout);
+void sys_trace_k_queue_get_many_exit(struct k_queue *queue, k_timeout_t timeout, int ret);
 void sys_trace_k_queue_remove_enter(struct k_queue *queue, void *data);
 void sys_trace_k_queue_remove_exit(struct k_queue *queue, void *data, bool ret);
 void sys_trace_k_queue_unique_append_enter(struct k_queue *queue, void *data);
@@ -601,6 +624,8 @@ void sys_trace_k_fifo_put_slist_enter(struct k_fifo *fifo, sys_slist_t *list);
 void sys_trace_k_fifo_put_slist_exit(struct k_fifo *fifo, sys_slist_t *list);
 void sys_trace_k_fifo_get_enter(struct k_fifo *fifo, k_timeout_t timeout);
 void sys_trace_k_fifo_get_exit(struct k_fifo *fifo, k_timeout_t timeout, void *ret);
+void sys_trace_k_fifo_get_batch_enter(struct k_fifo *fifo, k_timeout_t timeout);
+void sys_trace_k_fifo_get_batch_exit(struct k_fifo *fifo, k_timeout_t timeout, int ret);
 void sys_trace_k_fifo_peek_head_enter(struct k_fifo *fifo);
 void sys_trace_k_fifo_peek_head_exit(struct k_fifo *fifo, void *ret);
 void sys_trace_k_fifo_peek_tail_enter(struct k_fifo *fifo);
@@ -700,6 +725,12 @@ void sys_trace_k_msgq_put_front_exit(struct k_msgq *msgq, const void *data, k_ti
 void sys_trace_k_msgq_get_enter(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 void sys_trace_k_msgq_get_blocking(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 void sys_trace_k_msgq_get_exit(struct k_msgq *msgq, const void *data, k_timeout_t timeout, int ret);
+void sys_trace_k_msgq_put_many_enter(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
+void sys_trace_k_msgq_put_many_exit(struct k_msgq *msgq, const void *data, k_timeout_t timeout,
+				    int ret);
+void sys_trace_k_msgq_get_many_enter(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
+void sys_trace_k_msgq_get_many_exit(struct k_msgq *msgq, const void *data, k_timeout_t timeout,
+				    int ret);
 void sys_trace_k_msgq_peek(struct k_msgq *msgq, void *data, int ret);
 void sys_trace_k_msgq_purge(struct k_msgq *msgq);
 
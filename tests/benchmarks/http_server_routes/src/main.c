@@ -0,0 +1,141 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the cost of finding the resource for a request path as the
+ * number of resources of an HTTP service grows.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/net/http/service.h>
+
+#include "server_internal.h"
+
+#define WILDCARD_PATH "/static/js/app.js"
+#define UNKNOWN_PATH  "/api/v2/unknown"
+#define QUERY         "?id=42&verbose=1"
+
+static uint16_t service_port = 8080;
+
+static struct http_resource_detail detail = {
+	.type = HTTP_RESOURCE_TYPE_STATIC,
+	.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+};
+
+#define ROUTE_RESOURCE(n, _service)                                                        \
+	HTTP_RESOURCE_DEFINE(_service##_res_##n, _service, "/api/v1/item" #n, &detail)
+
+/* The wildcard resource sorts after the others, so it has the lowest precedence */
+#define ROUTE_SERVICE(_service, _count)                                                    \
+	HTTP_SERVICE_DEFINE(_service, "127.0.0.1", &service_port, 1, 1, NULL, NULL, NULL); \
+	LISTIFY(_count, ROUTE_RESOURCE, (;), _service);                                    \
+	HTTP_RESOURCE_DEFINE(_service##_static, _service, "/static/*", &detail)
+
+ROUTE_SERVICE(routes_8, 8);
+ROUTE_SERVICE(routes_32, 32);
+ROUTE_SERVICE(routes_128, 128);
+ROUTE_SERVICE(routes_256, 256);
+
+static const struct http_service_desc *const services[] = {
+	&routes_8,
+	&routes_32,
+	&routes_128,
+	&routes_256,
+};
+
+static void report(const char *tag, const char *str, unsigned int num_res,
+		   uint64_t cycles, unsigned int count)
+{
+	uint64_t average = cycles / count;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	char full_tag[50];
+
+	snprintk(full_tag, sizeof(full_tag), "%s.%03u", tag, num_res);
+
+	printk("REC: %-40s - %s (%3u resources) : %7llu cycles , %7u ns :\n", full_tag, str,
+	       num_res, average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-40s (%3u resources) : %7llu cycles (%7u nsec)\n", str, num_res,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void measure(const struct http_service_desc *svc, const char *path,
+		    bool expect_match, const char *tag, const char *str)
+{
+	unsigned int num_res = HTTP_SERVICE_RESOURCE_COUNT(svc);
+	struct http_resource_detail *res = NULL;
+	uint64_t cycles = 0ULL;
+	timing_t start;
+	timing_t finish;
+	int path_len;
+	unsigned int i;
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+		res = get_resource_detail(svc, path, &path_len, false);
+		finish = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &finish);
+	}
+
+	if ((res != NULL) != expect_match) {
+		printk("Unexpected lookup result for %s\n", path);
+	}
+
+	report(tag, str, num_res, cycles, CONFIG_BENCHMARK_NUM_ITERATIONS);
+}
+
+static void test_lookup(const struct http_service_desc *svc)
+{
+	/* The wildcard resource is the last one */
+	const char *first = svc->res_begin[0].resource;
+	const char *last = svc->res_end[-2].resource;
+	char query_path[64];
+
+	snprintk(query_path, sizeof(query_path), "%s" QUERY, last);
+
+	measure(svc, first, true, "http.routes.first", "Lookup first resource");
+	measure(svc, last, true, "http.routes.last", "Lookup last resource");
+	measure(svc, query_path, true, "http.routes.query", "Lookup last resource with query");
+	measure(svc, WILDCARD_PATH, true, "http.routes.wildcard", "Lookup wildcard resource");
+	measure(svc, UNKNOWN_PATH, false, "http.routes.unknown", "Lookup unknown path");
+}
+
+int main(void)
+{
+	unsigned int i;
+
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_ROUTE_TABLE)) {
+		/* Normally done when the server is started */
+		http_server_routes_init();
+	}
+
+	timing_init();
+
+	printk("Time Measurements for %s resource lookup\n",
+	       IS_ENABLED(CONFIG_HTTP_SERVER_ROUTE_TABLE) ? "route table" : "linear");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (i = 0; i < ARRAY_SIZE(services); i++) {
+		test_lookup(services[i]);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
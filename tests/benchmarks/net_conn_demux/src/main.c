@@ -0,0 +1,201 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the cost of matching a received packet to its connection
+ * handler as the number of registered handlers grows.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "connection.h"
+#include "udp_internal.h"
+
+#define LISTEN_PORT      4242
+#define LOCAL_PORT_BASE  10000
+#define REMOTE_PORT_BASE 20000
+
+/* One handler is always taken by the listener */
+#define MAX_CONNECTED (CONFIG_NET_MAX_CONN - 1)
+
+static const unsigned int populations[] = {1, 16, 64, 256};
+
+static struct net_conn_handle *handles[CONFIG_NET_MAX_CONN];
+
+static struct in_addr local_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_ipv4_hdr ipv4_hdr;
+static struct net_udp_hdr udp_hdr;
+
+static unsigned int delivered;
+
+static enum net_verdict recv_cb(struct net_conn *conn, struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	/* Keep the packet, it is fed again to net_conn_input() */
+	delivered++;
+
+	return NET_OK;
+}
+
+static void report(const char *tag, const char *str, unsigned int num_conns,
+		   uint64_t cycles, unsigned int count)
+{
+	uint64_t average = cycles / count;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	char full_tag[50];
+
+	snprintk(full_tag, sizeof(full_tag), "%s.%03u", tag, num_conns);
+
+	printk("REC: %-40s - %s (%3u conns) : %7llu cycles , %7u ns :\n", full_tag, str,
+	       num_conns, average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-40s (%3u conns) : %7llu cycles (%7u nsec)\n", str, num_conns,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static int register_handler(unsigned int idx, uint16_t remote_port,
+			    uint16_t local_port)
+{
+	struct sockaddr_in remote = {
+		.sin_family = AF_INET,
+		.sin_addr = peer_addr,
+	};
+	int ret;
+
+	ret = net_udp_register(AF_INET, remote_port ? (struct sockaddr *)&remote : NULL,
+			       NULL, remote_port, local_port, NULL, recv_cb, NULL,
+			       &handles[idx]);
+	if (ret < 0) {
+		printk("Cannot register handler %u (%d)\n", idx, ret);
+	}
+
+	return ret;
+}
+
+static uint64_t measure(struct net_pkt *pkt, unsigned int num_conns,
+			uint16_t local_port, uint16_t remote_port, bool spread)
+{
+	union net_ip_header ip_hdr = { .ipv4 = &ipv4_hdr };
+	union net_proto_header proto_hdr = { .udp = &udp_hdr };
+	uint64_t cycles = 0ULL;
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+	unsigned int n;
+
+	delivered = 0U;
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		n = spread ? (i % num_conns) : 0U;
+
+		udp_hdr.src_port = htons(remote_port + n);
+		udp_hdr.dst_port = htons(local_port + n);
+
+		start = timing_counter_get();
+		(void)net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+		finish = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &finish);
+	}
+
+	if (delivered != CONFIG_BENCHMARK_NUM_ITERATIONS) {
+		printk("Only %u packets out of %u were delivered\n", delivered,
+		       CONFIG_BENCHMARK_NUM_ITERATIONS);
+	}
+
+	return cycles;
+}
+
+static void test_demux(struct net_pkt *pkt, unsigned int num_conns)
+{
+	uint64_t cycles;
+	unsigned int i;
+
+	/* The listener is the oldest handler, the connected ones are
+	 * looked up among all of them.
+	 */
+	if (register_handler(0, 0, LISTEN_PORT) < 0) {
+		return;
+	}
+
+	for (i = 0; i < num_conns; i++) {
+		if (register_handler(i + 1, REMOTE_PORT_BASE + i,
+				     LOCAL_PORT_BASE + i) < 0) {
+			num_conns = i;
+			break;
+		}
+	}
+
+	cycles = measure(pkt, num_conns, LOCAL_PORT_BASE, REMOTE_PORT_BASE, true);
+	report("net.conn.connected", "Demux to connected handler", num_conns,
+	       cycles, CONFIG_BENCHMARK_NUM_ITERATIONS);
+
+	cycles = measure(pkt, num_conns, LISTEN_PORT, REMOTE_PORT_BASE - 1, false);
+	report("net.conn.listener", "Demux to listening handler", num_conns,
+	       cycles, CONFIG_BENCHMARK_NUM_ITERATIONS);
+
+	for (i = 0; i <= num_conns; i++) {
+		net_udp_unregister(handles[i]);
+	}
+}
+
+int main(void)
+{
+	struct net_if *iface = net_if_get_default();
+	struct net_pkt *pkt;
+	unsigned int i;
+
+	pkt = net_pkt_alloc_on_iface(iface, K_FOREVER);
+	net_pkt_set_family(pkt, AF_INET);
+
+	ipv4_hdr.vhl = 0x45;
+	ipv4_hdr.proto = IPPROTO_UDP;
+	net_ipv4_addr_copy_raw(ipv4_hdr.src, (uint8_t *)&peer_addr);
+	net_ipv4_addr_copy_raw(ipv4_hdr.dst, (uint8_t *)&local_addr);
+
+	timing_init();
+
+	printk("Time Measurements for %s connection lookup\n",
+	       IS_ENABLED(CONFIG_NET_CONN_HASH) ? "hashed" : "linear");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (i = 0; i < ARRAY_SIZE(populations); i++) {
+		if (populations[i] > MAX_CONNECTED) {
+			break;
+		}
+
+		test_demux(pkt, populations[i]);
+	}
+
+	timing_stop();
+
+	net_pkt_unref(pkt);
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
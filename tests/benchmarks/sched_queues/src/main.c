@@ -84,6 +84,12 @@ static void start_threads(unsigned int num_threads)
 		k_thread_create(&test_thread[i], test_stack, TEST_STACK_SIZE,
 				test_entry, (void *)(uintptr_t)i, NULL, NULL,
 				i / bucket_size, 0, K_NO_WAIT);
+
+#ifdef CONFIG_SCHED_DEADLINE
+		/* Give the threads of each priority distinct deadlines */
+		k_thread_deadline_set(&test_thread[i],
+				      (int)(((i % bucket_size) + 1) * 1000));
+#endif /* CONFIG_SCHED_DEADLINE */
 	}
 }
 
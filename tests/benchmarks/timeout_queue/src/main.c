@@ -0,0 +1,178 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main testing module that invokes all the tests.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <timeout_q.h>
+
+/* Armed timeouts expire between 10 and 70 seconds in the future */
+#define TIMEOUT_BASE_TICKS k_ms_to_ticks_ceil32(10 * MSEC_PER_SEC)
+#define TIMEOUT_SPAN_TICKS k_ms_to_ticks_ceil32(60 * MSEC_PER_SEC)
+
+static struct _timeout timeouts[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+
+static const unsigned int populations[] = {10, 1000, 10000};
+
+static uint32_t rand_state = 0x12345678;
+
+static volatile unsigned int expired;
+static timing_t expire_start;
+static timing_t expire_finish;
+
+static uint32_t next_rand(void)
+{
+	/* xorshift32, good enough to scatter expiry ticks */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static k_timeout_t random_timeout(void)
+{
+	return K_TICKS(TIMEOUT_BASE_TICKS + (next_rand() % TIMEOUT_SPAN_TICKS));
+}
+
+static void unexpected_cb(struct _timeout *t)
+{
+	printk("Timeout %u unexpectedly expired\n",
+	       (unsigned int)(t - &timeouts[0]));
+}
+
+static void expire_cb(struct _timeout *t)
+{
+	timing_t now = timing_counter_get();
+
+	ARG_UNUSED(t);
+
+	if (expired == 0U) {
+		expire_start = now;
+	}
+	expire_finish = now;
+	expired++;
+}
+
+static void report(const char *tag, const char *str, unsigned int num_timeouts,
+		   uint64_t cycles, unsigned int count)
+{
+	uint64_t average = cycles / count;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	char full_tag[50];
+
+	snprintk(full_tag, sizeof(full_tag), "%s.%05u", tag, num_timeouts);
+
+	printk("REC: %-40s - %s (%5u armed) : %7llu cycles , %7u ns :\n", full_tag, str,
+	       num_timeouts, average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-40s (%5u armed) : %7llu cycles (%7u nsec)\n", str, num_timeouts,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void test_insert_abort(unsigned int num_timeouts)
+{
+	uint64_t add_cycles = 0ULL;
+	uint64_t abort_cycles = 0ULL;
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+	unsigned int idx;
+
+	for (i = 0; i < num_timeouts; i++) {
+		z_init_timeout(&timeouts[i]);
+		z_add_timeout(&timeouts[i], unexpected_cb, random_timeout());
+	}
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		idx = next_rand() % num_timeouts;
+
+		start = timing_counter_get();
+		z_abort_timeout(&timeouts[idx]);
+		finish = timing_counter_get();
+		abort_cycles += timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		z_add_timeout(&timeouts[idx], unexpected_cb, random_timeout());
+		finish = timing_counter_get();
+		add_cycles += timing_cycles_get(&start, &finish);
+	}
+
+	for (i = 0; i < num_timeouts; i++) {
+		z_abort_timeout(&timeouts[i]);
+	}
+
+	report("timeout.add", "Add timeout", num_timeouts,
+	       add_cycles, CONFIG_BENCHMARK_NUM_ITERATIONS);
+	report("timeout.abort", "Abort timeout", num_timeouts,
+	       abort_cycles, CONFIG_BENCHMARK_NUM_ITERATIONS);
+}
+
+static void test_expire(unsigned int num_timeouts)
+{
+	k_timeout_t deadline;
+	unsigned int key;
+	unsigned int i;
+
+	expired = 0U;
+
+	/* Arm everything with interrupts locked so that no timeout can be
+	 * announced before the whole population is in the queue.
+	 */
+	key = irq_lock();
+
+	deadline = K_TIMEOUT_ABS_TICKS(k_uptime_ticks() + 2);
+	for (i = 0; i < num_timeouts; i++) {
+		z_init_timeout(&timeouts[i]);
+		z_add_timeout(&timeouts[i], expire_cb, deadline);
+	}
+
+	irq_unlock(key);
+
+	while (expired < num_timeouts) {
+		k_sleep(K_TICKS(1));
+	}
+
+	report("timeout.expire", "Expire timeout", num_timeouts,
+	       timing_cycles_get(&expire_start, &expire_finish), num_timeouts - 1);
+}
+
+int main(void)
+{
+	unsigned int i;
+
+	timing_init();
+
+	printk("Time Measurements for %s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "wheel" : "simple");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (i = 0; i < ARRAY_SIZE(populations); i++) {
+		if (populations[i] > CONFIG_BENCHMARK_NUM_TIMEOUTS) {
+			break;
+		}
+
+		test_insert_abort(populations[i]);
+		test_expire(populations[i]);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main testing module that invokes all the tests.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define NUM_SUBMITTERS CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE     (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#define SUBMITTER_PRIORITY K_PRIO_PREEMPT(5)
+#define QUEUE_PRIORITY     K_PRIO_PREEMPT(10)
+
+static K_THREAD_STACK_ARRAY_DEFINE(queue_stacks, NUM_SUBMITTERS, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(submitter_stacks, NUM_SUBMITTERS, STACK_SIZE);
+
+static struct k_work_q queues[NUM_SUBMITTERS];
+static struct k_thread submitters[NUM_SUBMITTERS];
+static struct k_work works[NUM_SUBMITTERS][CONFIG_BENCHMARK_NUM_WORK_ITEMS];
+
+static uint64_t submit_cycles[NUM_SUBMITTERS];
+
+static K_SEM_DEFINE(start_sem, 0, NUM_SUBMITTERS);
+
+static void work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+}
+
+static void submitter_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	uint64_t cycles = 0ULL;
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		struct k_work *work = &works[id][i % CONFIG_BENCHMARK_NUM_WORK_ITEMS];
+
+		start = timing_counter_get();
+		(void)k_work_submit_to_queue(&queues[id], work);
+		finish = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &finish);
+	}
+
+	submit_cycles[id] = cycles;
+}
+
+static void report(unsigned int num_submitters, uint64_t cycles, unsigned int count)
+{
+	uint64_t average = cycles / count;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	char tag[50];
+
+	snprintk(tag, sizeof(tag), "workq.submit.%02u", num_submitters);
+
+	printk("REC: %-40s - %s (%2u submitters) : %7llu cycles , %7u ns :\n", tag,
+	       "Submit work", num_submitters, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	printk("%-40s (%2u submitters) : %7llu cycles (%7u nsec)\n", "Submit work",
+	       num_submitters, average, (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void test_submit(unsigned int num_submitters)
+{
+	uint64_t cycles = 0ULL;
+	unsigned int i;
+
+	for (i = 0; i < num_submitters; i++) {
+		k_thread_create(&submitters[i], submitter_stacks[i], STACK_SIZE,
+				submitter_entry, UINT_TO_POINTER(i), NULL, NULL,
+				SUBMITTER_PRIORITY, 0, K_NO_WAIT);
+	}
+
+	/* Release all submitters at once so that they contend */
+	for (i = 0; i < num_submitters; i++) {
+		k_sem_give(&start_sem);
+	}
+
+	for (i = 0; i < num_submitters; i++) {
+		k_thread_join(&submitters[i], K_FOREVER);
+		cycles += submit_cycles[i];
+	}
+
+	for (i = 0; i < num_submitters; i++) {
+		(void)k_work_queue_drain(&queues[i], false);
+	}
+
+	report(num_submitters, cycles, num_submitters * CONFIG_BENCHMARK_NUM_ITERATIONS);
+}
+
+int main(void)
+{
+	unsigned int i;
+	unsigned int j;
+
+	timing_init();
+
+	for (i = 0; i < NUM_SUBMITTERS; i++) {
+		k_work_queue_init(&queues[i]);
+		k_work_queue_start(&queues[i], queue_stacks[i], STACK_SIZE,
+				   QUEUE_PRIORITY, NULL);
+
+		for (j = 0; j < CONFIG_BENCHMARK_NUM_WORK_ITEMS; j++) {
+			k_work_init(&works[i][j], work_handler);
+		}
+	}
+
+	printk("Time Measurements for work queue submission\n");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (i = 1; i <= NUM_SUBMITTERS; i++) {
+		test_submit(i);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_fifo.h"
+
+#define TIMEOUT K_MSEC(100)
+#define LIST_LEN 4
+
+static fdata_t batch_data[LIST_LEN];
+
+/**
+ * @addtogroup kernel_fifo_tests
+ * @{
+ */
+
+/**
+ * @brief Test getting several FIFO elements at once
+ * @see k_fifo_get_batch()
+ */
+ZTEST(fifo_api, test_fifo_get_batch)
+{
+	static struct k_fifo fifo;
+	void *items[LIST_LEN];
+
+	k_fifo_init(&fifo);
+
+	zassert_equal(k_fifo_get_batch(&fifo, items, ARRAY_SIZE(items), K_NO_WAIT), 0);
+	zassert_equal(k_fifo_get_batch(&fifo, items, ARRAY_SIZE(items), TIMEOUT), 0);
+
+	for (int i = 0; i < LIST_LEN; i++) {
+		k_fifo_put(&fifo, &batch_data[i]);
+	}
+
+	/**TESTPOINT: elements come out in order, at most max at a time */
+	zassert_equal(k_fifo_get_batch(&fifo, items, 3, K_NO_WAIT), 3);
+	for (int i = 0; i < 3; i++) {
+		zassert_equal_ptr(items[i], &batch_data[i]);
+	}
+
+	zassert_equal(k_fifo_get_batch(&fifo, items, ARRAY_SIZE(items), K_NO_WAIT), 1);
+	zassert_equal_ptr(items[0], &batch_data[3]);
+	zassert_true(k_fifo_is_empty(&fifo));
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,75 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include "test_mslab.h"
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+
+#define CACHE_BLK_NUM (2 * CONFIG_MEM_SLAB_CPU_CACHE_SIZE)
+
+K_MEM_SLAB_DEFINE_STATIC(cache_slab, BLK_SIZE, CACHE_BLK_NUM, BLK_ALIGN);
+
+/**
+ * @brief Verify that blocks cached per CPU are still available
+ *
+ * @details Blocks freed to the per-CPU cache must be accounted as free,
+ * and must all be allocatable again once the shared free list is empty.
+ */
+ZTEST(mslab_api, test_mslab_cache_all_blocks)
+{
+	void *blocks[CACHE_BLK_NUM];
+	void *extra;
+	int i;
+
+	for (i = 0; i < CACHE_BLK_NUM; i++) {
+		zassert_ok(k_mem_slab_alloc(&cache_slab, &blocks[i], K_NO_WAIT));
+	}
+	zassert_equal(k_mem_slab_num_free_get(&cache_slab), 0);
+
+	for (i = 0; i < CACHE_BLK_NUM; i++) {
+		k_mem_slab_free(&cache_slab, blocks[i]);
+	}
+	zassert_equal(k_mem_slab_num_used_get(&cache_slab), 0);
+	zassert_equal(k_mem_slab_num_free_get(&cache_slab), CACHE_BLK_NUM);
+
+	for (i = 0; i < CACHE_BLK_NUM; i++) {
+		zassert_ok(k_mem_slab_alloc(&cache_slab, &blocks[i], K_NO_WAIT),
+			   "cached block %d not allocatable", i);
+	}
+	zassert_equal(k_mem_slab_alloc(&cache_slab, &extra, K_NO_WAIT), -ENOMEM);
+
+	for (i = 0; i < CACHE_BLK_NUM; i++) {
+		k_mem_slab_free(&cache_slab, blocks[i]);
+	}
+}
+
+#ifdef CONFIG_OBJ_CORE_STATS_MEM_SLAB
+/**
+ * @brief Verify that cache hits are reported in the object core stats
+ */
+ZTEST(mslab_api, test_mslab_cache_stats)
+{
+	struct k_mem_slab_info info;
+	void *block;
+
+	zassert_ok(k_obj_core_stats_reset(K_OBJ_CORE(&cache_slab)));
+
+	for (int i = 0; i < 100; i++) {
+		zassert_ok(k_mem_slab_alloc(&cache_slab, &block, K_NO_WAIT));
+		k_mem_slab_free(&cache_slab, block);
+	}
+
+	zassert_ok(k_obj_core_stats_raw(K_OBJ_CORE(&cache_slab), &info, sizeof(info)));
+	zassert_equal(info.num_used, 0);
+	zassert_true(info.cache_hits > 10U * info.cache_misses,
+		     "poor cache hit ratio (%u hits, %u misses)",
+		     info.cache_hits, info.cache_misses);
+}
+#endif /* CONFIG_OBJ_CORE_STATS_MEM_SLAB */
+
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
@@ -0,0 +1,101 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 4
+
+extern struct k_thread tdata;
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+
+static struct k_msgq batch_msgq;
+static char __aligned(4) batch_buffer[MSG_SIZE * BATCH_LEN];
+static uint32_t batch_send[BATCH_LEN + 2] = { 1, 2, 3, 4, 5, 6 };
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test putting and getting several messages at once
+ *
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api, test_msgq_put_get_many)
+{
+	uint32_t rec[BATCH_LEN + 2];
+	int ret;
+
+	k_msgq_init(&batch_msgq, batch_buffer, MSG_SIZE, BATCH_LEN);
+
+	/* Only as many messages as fit are put */
+	ret = k_msgq_put_many(&batch_msgq, batch_send, ARRAY_SIZE(batch_send), K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN);
+	zassert_equal(k_msgq_num_used_get(&batch_msgq), BATCH_LEN);
+
+	ret = k_msgq_put_many(&batch_msgq, batch_send, 1, K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG);
+	ret = k_msgq_put_many(&batch_msgq, batch_send, 1, TIMEOUT);
+	zassert_equal(ret, -EAGAIN);
+
+	/* Partial get, then get what is left */
+	ret = k_msgq_get_many(&batch_msgq, rec, 3, K_NO_WAIT);
+	zassert_equal(ret, 3);
+	ret = k_msgq_get_many(&batch_msgq, &rec[3], ARRAY_SIZE(rec) - 3, K_NO_WAIT);
+	zassert_equal(ret, 1);
+
+	for (int i = 0; i < BATCH_LEN; i++) {
+		zassert_equal(rec[i], batch_send[i], "message %d out of order", i);
+	}
+
+	ret = k_msgq_get_many(&batch_msgq, rec, ARRAY_SIZE(rec), K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG);
+	ret = k_msgq_get_many(&batch_msgq, rec, ARRAY_SIZE(rec), TIMEOUT);
+	zassert_equal(ret, -EAGAIN);
+}
+
+static void batch_putter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_msleep(TIMEOUT_MS / 2);
+	zassert_equal(k_msgq_put_many(&batch_msgq, batch_send, 3, K_NO_WAIT), 3);
+}
+
+/**
+ * @brief Test that a batch get waits for messages on an empty queue
+ *
+ * @see k_msgq_get_many()
+ */
+ZTEST(msgq_api, test_msgq_get_many_wait)
+{
+	uint32_t rec[BATCH_LEN];
+	int ret;
+
+	k_msgq_init(&batch_msgq, batch_buffer, MSG_SIZE, BATCH_LEN);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, batch_putter, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* The first message is handed over, the others are queued */
+	ret = k_msgq_get_many(&batch_msgq, rec, ARRAY_SIZE(rec), K_FOREVER);
+	zassert_equal(ret, 1);
+	zassert_equal(rec[0], batch_send[0]);
+
+	ret = k_msgq_get_many(&batch_msgq, rec, ARRAY_SIZE(rec), K_NO_WAIT);
+	zassert_equal(ret, 2);
+	zassert_equal(rec[0], batch_send[1]);
+	zassert_equal(rec[1], batch_send[2]);
+
+	k_thread_join(&tdata, K_FOREVER);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,193 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/irq_offload.h>
+
+#define MSGQ_LEN    8
+#define STACK_SIZE  (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_PEERS   2
+#define NUM_MSGS    1000
+
+#define PEER_PRIORITY K_PRIO_PREEMPT(5)
+
+K_MSGQ_DEFINE_LOCKFREE(spsc_msgq, sizeof(uint32_t), MSGQ_LEN, 4, K_MSGQ_FLAG_SPSC);
+K_MSGQ_DEFINE_LOCKFREE(mpmc_msgq, sizeof(uint32_t), MSGQ_LEN, 4, K_MSGQ_FLAG_MPMC);
+
+static struct k_thread producers[NUM_PEERS];
+static struct k_thread consumers[NUM_PEERS];
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, NUM_PEERS, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(consumer_stacks, NUM_PEERS, STACK_SIZE);
+
+static uint32_t consumed_sum[NUM_PEERS];
+
+static void fill_and_drain(struct k_msgq *msgq)
+{
+	uint32_t data;
+	uint32_t i;
+
+	for (i = 0; i < MSGQ_LEN; i++) {
+		zassert_ok(k_msgq_put(msgq, &i, K_NO_WAIT));
+	}
+
+	zassert_equal(k_msgq_num_used_get(msgq), MSGQ_LEN);
+	zassert_equal(k_msgq_num_free_get(msgq), 0);
+	zassert_equal(k_msgq_put(msgq, &i, K_NO_WAIT), -ENOMSG);
+
+	for (i = 0; i < MSGQ_LEN; i++) {
+		zassert_ok(k_msgq_get(msgq, &data, K_NO_WAIT));
+		zassert_equal(data, i, "messages out of order");
+	}
+
+	zassert_equal(k_msgq_num_used_get(msgq), 0);
+	zassert_equal(k_msgq_get(msgq, &data, K_NO_WAIT), -ENOMSG);
+}
+
+/**
+ * @brief Test putting and getting messages without blocking
+ */
+ZTEST(msgq_lockfree, test_put_get)
+{
+	/* Several rounds so that positions wrap around the ring */
+	for (int i = 0; i < 3; i++) {
+		fill_and_drain(&spsc_msgq);
+		fill_and_drain(&mpmc_msgq);
+	}
+}
+
+/**
+ * @brief Test that operations needing the lock are refused
+ */
+ZTEST(msgq_lockfree, test_unsupported)
+{
+	uint32_t data = 0U;
+
+	zassert_equal(k_msgq_put_front(&spsc_msgq, &data, K_NO_WAIT), -ENOTSUP);
+	zassert_equal(k_msgq_peek(&spsc_msgq, &data), -ENOTSUP);
+	zassert_equal(k_msgq_peek_at(&spsc_msgq, &data, 0), -ENOTSUP);
+}
+
+/**
+ * @brief Test purging a lock-free message queue
+ */
+ZTEST(msgq_lockfree, test_purge)
+{
+	uint32_t data = 1U;
+
+	zassert_ok(k_msgq_put(&mpmc_msgq, &data, K_NO_WAIT));
+	zassert_ok(k_msgq_put(&mpmc_msgq, &data, K_NO_WAIT));
+
+	k_msgq_purge(&mpmc_msgq);
+
+	zassert_equal(k_msgq_num_used_get(&mpmc_msgq), 0);
+	zassert_equal(k_msgq_get(&mpmc_msgq, &data, K_NO_WAIT), -ENOMSG);
+}
+
+static void isr_put(const void *param)
+{
+	uint32_t data = POINTER_TO_UINT(param);
+
+	zassert_ok(k_msgq_put(&spsc_msgq, &data, K_NO_WAIT));
+}
+
+/**
+ * @brief Test putting a message from an ISR
+ */
+ZTEST(msgq_lockfree, test_isr_put)
+{
+	uint32_t data;
+
+	irq_offload(isr_put, UINT_TO_POINTER(42));
+
+	zassert_ok(k_msgq_get(&spsc_msgq, &data, K_NO_WAIT));
+	zassert_equal(data, 42);
+}
+
+/**
+ * @brief Test timing out waiting for a message
+ */
+ZTEST(msgq_lockfree, test_get_timeout)
+{
+	uint32_t data;
+
+	zassert_equal(k_msgq_get(&spsc_msgq, &data, K_MSEC(10)), -EAGAIN);
+}
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *msgq = p1;
+	uint32_t i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 1; i <= NUM_MSGS; i++) {
+		zassert_ok(k_msgq_put(msgq, &i, K_FOREVER));
+	}
+}
+
+static void consumer_entry(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *msgq = p1;
+	int id = POINTER_TO_INT(p2);
+	uint32_t data;
+	uint32_t i;
+
+	ARG_UNUSED(p3);
+
+	consumed_sum[id] = 0U;
+	for (i = 0; i < NUM_MSGS; i++) {
+		zassert_ok(k_msgq_get(msgq, &data, K_FOREVER));
+		consumed_sum[id] += data;
+	}
+}
+
+static void run_peers(struct k_msgq *msgq, int num_peers)
+{
+	uint32_t sum = 0U;
+	int i;
+
+	for (i = 0; i < num_peers; i++) {
+		k_thread_create(&consumers[i], consumer_stacks[i], STACK_SIZE,
+				consumer_entry, msgq, INT_TO_POINTER(i), NULL,
+				PEER_PRIORITY, 0, K_NO_WAIT);
+	}
+
+	for (i = 0; i < num_peers; i++) {
+		k_thread_create(&producers[i], producer_stacks[i], STACK_SIZE,
+				producer_entry, msgq, NULL, NULL,
+				PEER_PRIORITY, 0, K_NO_WAIT);
+	}
+
+	for (i = 0; i < num_peers; i++) {
+		k_thread_join(&producers[i], K_FOREVER);
+		k_thread_join(&consumers[i], K_FOREVER);
+		sum += consumed_sum[i];
+	}
+
+	/* Every message was consumed exactly once */
+	zassert_equal(sum, num_peers * (NUM_MSGS * (NUM_MSGS + 1) / 2));
+	zassert_equal(k_msgq_num_used_get(msgq), 0);
+}
+
+/**
+ * @brief Test blocking producer and consumer threads on an SPSC queue
+ */
+ZTEST(msgq_lockfree, test_spsc_threads)
+{
+	run_peers(&spsc_msgq, 1);
+}
+
+/**
+ * @brief Test concurrent producers and consumers on an MPMC queue
+ */
+ZTEST(msgq_lockfree, test_mpmc_threads)
+{
+	run_peers(&mpmc_msgq, NUM_PEERS);
+}
+
+ZTEST_SUITE(msgq_lockfree, NULL, NULL, NULL, NULL, NULL);
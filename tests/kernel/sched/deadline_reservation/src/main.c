@@ -0,0 +1,108 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define NUM_THREADS 3
+#define STACK_SIZE  (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#define WORKER_PRIORITY K_PRIO_PREEMPT(5)
+
+static struct k_thread worker_threads[NUM_THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_THREADS, STACK_SIZE);
+
+static volatile bool stop;
+
+static void busy_worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		k_busy_wait(100);
+	}
+}
+
+static k_tid_t create_worker(int idx)
+{
+	return k_thread_create(&worker_threads[idx], worker_stacks[idx], STACK_SIZE,
+			       busy_worker, NULL, NULL, NULL,
+			       WORKER_PRIORITY, 0, K_FOREVER);
+}
+
+static void stop_workers(int num)
+{
+	stop = true;
+
+	for (int i = 0; i < num; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+	}
+}
+
+/**
+ * @brief Test admission control of CPU time reservations
+ */
+ZTEST(suite_deadline_reservation, test_admission)
+{
+	k_tid_t a = create_worker(0);
+	k_tid_t b = create_worker(1);
+	k_tid_t c = create_worker(2);
+
+	zassert_equal(k_thread_reservation_set(a, 2000, 1000), -EINVAL);
+
+	zassert_ok(k_thread_reservation_set(a, 60000, 100000));
+	zassert_ok(k_thread_reservation_set(b, 40000, 100000));
+	zassert_equal(k_thread_reservation_set(c, 1000, 100000), -EBUSY,
+		      "reservation exceeding the utilization bound was admitted");
+
+	/* Shrinking an existing reservation makes room for another */
+	zassert_ok(k_thread_reservation_set(a, 50000, 100000));
+	zassert_ok(k_thread_reservation_set(c, 10000, 100000));
+
+	/* Releasing reservations, including through an abort */
+	zassert_ok(k_thread_reservation_set(b, 0, 0));
+	k_thread_abort(a);
+	zassert_ok(k_thread_reservation_set(b, 90000, 100000));
+
+	k_thread_abort(b);
+	k_thread_abort(c);
+}
+
+/**
+ * @brief Test that busy reserved threads get CPU time in proportion to
+ * their reservations, and that their overruns are accounted
+ */
+ZTEST(suite_deadline_reservation, test_bandwidth)
+{
+	k_thread_runtime_stats_t small;
+	k_thread_runtime_stats_t large;
+	k_tid_t a = create_worker(0);
+	k_tid_t b = create_worker(1);
+
+	stop = false;
+
+	zassert_ok(k_thread_reservation_set(a, 10000, 50000));
+	zassert_ok(k_thread_reservation_set(b, 30000, 50000));
+
+	k_thread_start(a);
+	k_thread_start(b);
+
+	k_msleep(1000);
+
+	zassert_ok(k_thread_runtime_stats_get(a, &small));
+	zassert_ok(k_thread_runtime_stats_get(b, &large));
+
+	stop_workers(2);
+
+	zassert_true(small.overruns > 1U, "no budget overrun accounted");
+	zassert_true(large.overruns > 1U, "no budget overrun accounted");
+	zassert_true(large.execution_cycles > 2U * small.execution_cycles,
+		      "CPU time not shared according to reservations (%llu vs %llu)",
+		      large.execution_cycles, small.execution_cycles);
+}
+
+ZTEST_SUITE(suite_deadline_reservation, NULL, NULL, NULL, NULL, NULL);
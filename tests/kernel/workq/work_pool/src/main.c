@@ -0,0 +1,175 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define NUM_QUEUES   MAX(2, CONFIG_MP_MAX_NUM_CPUS)
+#define NUM_WORKS    (4 * NUM_QUEUES)
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORK_TIME_MS 20
+
+K_WORK_POOL_DEFINE(test_pool, NUM_QUEUES, STACK_SIZE);
+
+struct test_work {
+	struct k_work work;
+	k_tid_t thread;
+};
+
+static struct test_work works[NUM_WORKS];
+static atomic_t completed;
+static k_tid_t delayed_thread;
+static K_SEM_DEFINE(delayed_sem, 0, 1);
+static K_SEM_DEFINE(block_sem, 0, 1);
+
+static void test_handler(struct k_work *work)
+{
+	struct test_work *tw = CONTAINER_OF(work, struct test_work, work);
+
+	tw->thread = k_current_get();
+	k_msleep(WORK_TIME_MS);
+	atomic_inc(&completed);
+}
+
+static void delayed_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	delayed_thread = k_current_get();
+	atomic_inc(&completed);
+	k_sem_give(&delayed_sem);
+}
+
+static void blocking_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)k_sem_take(&block_sem, K_FOREVER);
+}
+
+static void *pool_setup(void)
+{
+	k_work_pool_start(&test_pool, K_PRIO_PREEMPT(1), NULL);
+
+	return NULL;
+}
+
+static void pool_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	atomic_clear(&completed);
+	k_sem_reset(&delayed_sem);
+	k_sem_reset(&block_sem);
+
+	for (unsigned int i = 0; i < NUM_WORKS; i++) {
+		k_work_init(&works[i].work, test_handler);
+		works[i].thread = NULL;
+	}
+}
+
+static bool is_pool_thread(k_tid_t thread)
+{
+	for (unsigned int i = 0; i < NUM_QUEUES; i++) {
+		if (k_work_queue_thread_get(&test_pool.queues[i]) == thread) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Work submitted from a single thread is spread across the pool */
+ZTEST(work_pool, test_submit_spread)
+{
+	struct k_work_sync sync;
+	unsigned int i;
+	unsigned int j;
+	unsigned int threads = 0U;
+
+	for (i = 0; i < NUM_WORKS; i++) {
+		zassert_equal(k_work_pool_submit(&test_pool, &works[i].work), 1);
+	}
+
+	for (i = 0; i < NUM_WORKS; i++) {
+		(void)k_work_flush(&works[i].work, &sync);
+	}
+
+	zassert_equal(atomic_get(&completed), NUM_WORKS);
+
+	for (i = 0; i < NUM_WORKS; i++) {
+		zassert_true(is_pool_thread(works[i].thread));
+
+		for (j = 0; j < i; j++) {
+			if (works[j].thread == works[i].thread) {
+				break;
+			}
+		}
+		if (j == i) {
+			threads++;
+		}
+	}
+
+	zassert_true(threads > 1U, "work was not stolen");
+}
+
+/* Work submitted to a pool can be cancelled with the regular API */
+ZTEST(work_pool, test_cancel)
+{
+	struct k_work_sync sync;
+	unsigned int i;
+
+	for (i = 0; i < NUM_WORKS; i++) {
+		zassert_equal(k_work_pool_submit(&test_pool, &works[i].work), 1);
+	}
+
+	for (i = 0; i < NUM_WORKS; i++) {
+		(void)k_work_cancel_sync(&works[i].work, &sync);
+		zassert_equal(k_work_busy_get(&works[i].work), 0);
+	}
+
+	zassert_true(atomic_get(&completed) <= NUM_WORKS);
+
+	/* Resubmitting after cancel runs the work again */
+	zassert_equal(k_work_pool_submit(&test_pool, &works[0].work), 1);
+	zassert_true(k_work_flush(&works[0].work, &sync));
+}
+
+/* Delayable work scheduled on a pool runs on a pool thread */
+ZTEST(work_pool, test_schedule)
+{
+	struct k_work_sync sync;
+	struct k_work_delayable dwork;
+
+	k_work_init_delayable(&dwork, delayed_handler);
+	zassert_equal(k_work_pool_schedule(&test_pool, &dwork, K_MSEC(10)), 1);
+	zassert_true(k_work_flush_delayable(&dwork, &sync));
+	zassert_equal(atomic_get(&completed), 1);
+	zassert_true(is_pool_thread(delayed_thread));
+}
+
+/* Delayable work expiring behind a busy pool thread wakes up an idle one */
+ZTEST(work_pool, test_schedule_busy)
+{
+	struct k_work_sync sync;
+	struct k_work_delayable dwork;
+
+	k_work_init(&works[0].work, blocking_handler);
+	zassert_equal(k_work_pool_submit(&test_pool, &works[0].work), 1);
+	k_msleep(WORK_TIME_MS);
+
+	k_work_init_delayable(&dwork, delayed_handler);
+	zassert_equal(k_work_pool_schedule(&test_pool, &dwork, K_MSEC(10)), 1);
+
+	zassert_ok(k_sem_take(&delayed_sem, K_MSEC(500)),
+		   "expired work waited for the busy thread");
+	zassert_true(is_pool_thread(delayed_thread));
+
+	k_sem_give(&block_sem);
+	(void)k_work_flush(&works[0].work, &sync);
+}
+
+ZTEST_SUITE(work_pool, NULL, pool_setup, pool_before, NULL, NULL);
@@ -0,0 +1,151 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/arena.h>
+#include <zephyr/sys/heap_listener.h>
+
+#define BUF_SZ     256
+#define BLOCK_SZ   128
+#define NUM_BLOCKS 4
+
+K_HEAP_DEFINE(test_heap, 2048);
+K_MEM_SLAB_DEFINE_STATIC(test_slab, BLOCK_SZ, NUM_BLOCKS, sizeof(void *));
+
+static uint8_t buf[BUF_SZ] __aligned(sizeof(void *));
+static struct sys_arena arena;
+
+static size_t listener_bytes;
+
+static void arena_alloc_cb(uintptr_t heap_id, void *mem, size_t bytes)
+{
+	ARG_UNUSED(heap_id);
+	ARG_UNUSED(mem);
+
+	listener_bytes += bytes;
+}
+
+static void arena_free_cb(uintptr_t heap_id, void *mem, size_t bytes)
+{
+	ARG_UNUSED(heap_id);
+	ARG_UNUSED(mem);
+
+	listener_bytes -= bytes;
+}
+
+static HEAP_LISTENER_ALLOC_DEFINE(arena_alloc_listener, HEAP_ID_FROM_POINTER(&arena),
+				  arena_alloc_cb);
+static HEAP_LISTENER_FREE_DEFINE(arena_free_listener, HEAP_ID_FROM_POINTER(&arena),
+				 arena_free_cb);
+
+static void *arena_setup(void)
+{
+	heap_listener_register(&arena_alloc_listener);
+	heap_listener_register(&arena_free_listener);
+
+	return NULL;
+}
+
+static void arena_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	sys_arena_release(&arena);
+	zassert_equal(listener_bytes, 0, "arena blocks leaked");
+}
+
+ZTEST(lib_arena, test_buffer)
+{
+	struct sys_arena_mark mark;
+	void *p1, *p2, *p3;
+
+	sys_arena_init(&arena, buf, sizeof(buf));
+
+	p1 = sys_arena_alloc(&arena, 10);
+	zassert_not_null(p1, "alloc failed");
+	zassert_true(IS_ALIGNED(p1, sizeof(uint64_t)), "bad alignment %p", p1);
+
+	p2 = sys_arena_aligned_alloc(&arena, 32, 16);
+	zassert_not_null(p2, "alloc failed");
+	zassert_true(IS_ALIGNED(p2, 32), "bad alignment %p", p2);
+	zassert_true((uint8_t *)p2 >= (uint8_t *)p1 + 10, "overlapping allocations");
+
+	zassert_is_null(sys_arena_alloc(&arena, 0), "zero size alloc succeeded");
+	zassert_is_null(sys_arena_alloc(&arena, BUF_SZ), "static arena grew");
+
+	mark = sys_arena_mark(&arena);
+	p3 = sys_arena_alloc(&arena, 64);
+	zassert_not_null(p3, "alloc failed");
+	sys_arena_restore(&arena, mark);
+	zassert_equal(sys_arena_alloc(&arena, 64), p3, "restore did not roll back");
+
+	sys_arena_reset(&arena);
+	zassert_equal(sys_arena_alloc(&arena, 10), p1, "reset did not roll back");
+
+	zassert_equal(sys_arena_capacity(&arena), sizeof(buf), "wrong capacity");
+	zassert_equal(listener_bytes, 0, "static arena reported blocks");
+}
+
+ZTEST(lib_arena, test_heap)
+{
+	struct sys_arena_mark outer, inner;
+	void *p, *big;
+	size_t capacity;
+
+	sys_arena_init_heap(&arena, &test_heap, BLOCK_SZ);
+	zassert_equal(sys_arena_capacity(&arena), 0, "heap arena allocated eagerly");
+
+	outer = sys_arena_mark(&arena);
+
+	for (int i = 0; i < 10; i++) {
+		zassert_not_null(sys_arena_alloc(&arena, 40), "alloc failed");
+	}
+
+	/* Bigger than a block: gets a block of its own */
+	inner = sys_arena_mark(&arena);
+	big = sys_arena_aligned_alloc(&arena, 64, 4 * BLOCK_SZ);
+	zassert_not_null(big, "big alloc failed");
+	zassert_true(IS_ALIGNED(big, 64), "bad alignment %p", big);
+
+	capacity = sys_arena_capacity(&arena);
+	zassert_equal(listener_bytes, capacity, "listener missed arena growth");
+
+	/* Nested checkpoints roll back without touching the heap */
+	sys_arena_restore(&arena, inner);
+	zassert_equal(sys_arena_aligned_alloc(&arena, 64, 4 * BLOCK_SZ), big,
+		      "restore did not roll back");
+	sys_arena_restore(&arena, outer);
+	zassert_equal(sys_arena_capacity(&arena), capacity, "blocks were dropped");
+
+	/* Trim gives back everything past the first block */
+	p = sys_arena_alloc(&arena, 40);
+	zassert_not_null(p, "alloc failed");
+	sys_arena_trim(&arena);
+	zassert_equal(sys_arena_capacity(&arena), BLOCK_SZ, "trim kept blocks");
+	zassert_equal(listener_bytes, BLOCK_SZ, "listener missed trim");
+}
+
+ZTEST(lib_arena, test_slab)
+{
+	int count = 0;
+
+	sys_arena_init_slab(&arena, &test_slab);
+
+	zassert_is_null(sys_arena_alloc(&arena, BLOCK_SZ), "alloc bigger than a block");
+
+	while (sys_arena_alloc(&arena, 16) != NULL) {
+		count++;
+	}
+
+	zassert_true(count >= NUM_BLOCKS, "too few allocations %d", count);
+	zassert_equal(k_mem_slab_num_free_get(&test_slab), 0, "slab not exhausted");
+	zassert_equal(listener_bytes, NUM_BLOCKS * BLOCK_SZ, "listener missed arena growth");
+
+	sys_arena_release(&arena);
+	zassert_equal(k_mem_slab_num_free_get(&test_slab), NUM_BLOCKS, "blocks leaked");
+}
+
+ZTEST_SUITE(lib_arena, NULL, arena_setup, NULL, arena_after, NULL);
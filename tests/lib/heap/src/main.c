@@ -45,9 +45,18 @@
  * will increase 16 bytes on 64 bit CPU.
  */
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-#define SOLO_FREE_HEADER_HEAP_SZ (80)
+#define SOLO_FREE_HEADER_HEAP_SZ_BASE (80)
 #else
-#define SOLO_FREE_HEADER_HEAP_SZ (64)
+#define SOLO_FREE_HEADER_HEAP_SZ_BASE (64)
+#endif
+
+/* The size class lists of the default 8 classes (plus their hit/miss
+ * counters) take another 64 bytes of struct z_heap on 64 bit CPU.
+ */
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+#define SOLO_FREE_HEADER_HEAP_SZ (SOLO_FREE_HEADER_HEAP_SZ_BASE + 64)
+#else
+#define SOLO_FREE_HEADER_HEAP_SZ SOLO_FREE_HEADER_HEAP_SZ_BASE
 #endif
 
 #define SCRATCH_SZ (sizeof(heapmem) / 2)
@@ -485,4 +494,62 @@ ZTEST(lib_heap, test_heap_listeners)
 #endif /* CONFIG_SYS_HEAP_LISTENER */
 }
 
+ZTEST(lib_heap, test_size_classes)
+{
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	struct sys_heap heap;
+	struct sys_heap_size_class_stats stats;
+	void *blocks[CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH];
+	void *p1, *p2;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	/* A freed small block is handed straight back for the same size */
+	p1 = sys_heap_alloc(&heap, 16);
+	zassert_not_null(p1, "alloc failed");
+	sys_heap_free(&heap, p1);
+	p2 = sys_heap_alloc(&heap, 16);
+	zassert_equal(p1, p2, "size class miss %p != %p", p1, p2);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	zassert_ok(sys_heap_size_class_stats_get(&heap, &stats));
+	zassert_equal(stats.cached_chunks, 0, "unexpected parked chunks");
+	if (IS_ENABLED(CONFIG_SYS_HEAP_RUNTIME_STATS)) {
+		zassert_equal(stats.hits, 1, "wrong hit count %u", stats.hits);
+		zassert_equal(stats.misses, 1, "wrong miss count %u", stats.misses);
+	}
+	sys_heap_free(&heap, p2);
+
+	/* Fill a class, parked bytes count as free */
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		blocks[i] = sys_heap_alloc(&heap, 16);
+		zassert_not_null(blocks[i], "alloc failed");
+	}
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		sys_heap_free(&heap, blocks[i]);
+	}
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	zassert_ok(sys_heap_size_class_stats_get(&heap, &stats));
+	zassert_equal(stats.cached_chunks, ARRAY_SIZE(blocks),
+		      "wrong parked chunk count %u", stats.cached_chunks);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	struct sys_memory_stats mstats;
+
+	/* The parked chunks sit right before the only free chunk left.
+	 * An allocation bigger than that chunk only fits once they are
+	 * returned to the heap and merged with it.
+	 */
+	zassert_ok(sys_heap_runtime_stats_get(&heap, &mstats));
+	p1 = sys_heap_alloc(&heap, mstats.free_bytes - stats.cached_bytes + 64);
+	zassert_not_null(p1, "parked chunks were not returned to the heap");
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	zassert_ok(sys_heap_size_class_stats_get(&heap, &stats));
+	zassert_equal(stats.cached_chunks, 0, "unexpected parked chunks");
+#endif
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(lib_heap, NULL, NULL, NULL, NULL, NULL);
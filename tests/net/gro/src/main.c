@@ -0,0 +1,377 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_CORE_LOG_LEVEL);
+
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_stats.h>
+
+#include "net_private.h"
+#include "connection.h"
+#include "ipv6.h"
+#include "gro.h"
+
+#define TEST_MSS     500
+#define TEST_SEQ     0xfffffe00U /* wraps around within the test data */
+#define TEST_SEGS    4
+#define MAX_RECV     8
+#define LOCAL_PORT   80
+#define REMOTE_PORT  4242
+
+#define TCP_FIN 0x01
+#define TCP_PSH 0x08
+#define TCP_ACK 0x10
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 1, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 1, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static uint8_t test_data[TEST_SEGS * TEST_MSS];
+
+static struct net_if *test_iface;
+static struct net_conn_handle *conn_handle;
+static struct net_gro gro;
+
+/* What the TCP layer got */
+static struct {
+	uint32_t seq;
+	uint16_t port;
+	uint8_t flags;
+	size_t len;
+	bool data_ok;
+} recv[MAX_RECV];
+static int recv_count;
+
+struct net_gro_test_context {
+	uint8_t mac_addr[6];
+};
+
+static struct net_gro_test_context gro_test_ctx;
+
+static int test_dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void test_iface_init(struct net_if *iface)
+{
+	struct net_gro_test_context *ctx = net_if_get_device(iface)->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	ctx->mac_addr[0] = 0x00;
+	ctx->mac_addr[1] = 0x00;
+	ctx->mac_addr[2] = 0x5E;
+	ctx->mac_addr[3] = 0x00;
+	ctx->mac_addr[4] = 0x53;
+	ctx->mac_addr[5] = sys_rand8_get();
+
+	net_if_set_link_addr(iface, ctx->mac_addr, sizeof(ctx->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	test_iface = iface;
+}
+
+static int test_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api test_if_api = {
+	.iface_api.init = test_iface_init,
+	.send = test_send,
+};
+
+NET_DEVICE_INIT(net_gro_test, "net_gro_test", test_dev_init, NULL,
+		&gro_test_ctx, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&test_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static enum net_verdict tcp_recv(struct net_conn *conn, struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr,
+				 union net_proto_header *proto_hdr,
+				 void *user_data)
+{
+	static uint8_t data[sizeof(test_data)];
+	struct net_tcp_hdr *tcp_hdr = proto_hdr->tcp;
+	size_t hdr_len = NET_IPV6H_LEN + (tcp_hdr->offset >> 4) * 4U;
+	size_t offset;
+
+	zassert_true(recv_count < MAX_RECV, "Too many packets");
+
+	recv[recv_count].seq = sys_get_be32(tcp_hdr->seq);
+	recv[recv_count].port = ntohs(tcp_hdr->src_port);
+	recv[recv_count].flags = tcp_hdr->flags;
+	recv[recv_count].len = net_pkt_get_len(pkt) - hdr_len;
+
+	zassert_equal(ntohs(ip_hdr->ipv6->len), net_pkt_get_len(pkt) - NET_IPV6H_LEN,
+		      "IPv6 payload length does not match the packet");
+
+	offset = (uint32_t)(recv[recv_count].seq - TEST_SEQ);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	zassert_ok(net_pkt_skip(pkt, hdr_len));
+	zassert_ok(net_pkt_read(pkt, data, recv[recv_count].len));
+
+	recv[recv_count].data_ok = offset + recv[recv_count].len <= sizeof(test_data) &&
+		memcmp(data, &test_data[offset], recv[recv_count].len) == 0;
+
+	recv_count++;
+
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static struct net_pkt *create_segment(uint16_t port, int seg, uint8_t flags)
+{
+	struct net_tcp_hdr tcp_hdr = {
+		.src_port = htons(port),
+		.dst_port = htons(LOCAL_PORT),
+		.offset = (NET_TCPH_LEN / 4) << 4,
+		.flags = flags,
+	};
+	struct net_pkt *pkt;
+
+	sys_put_be32(TEST_SEQ + seg * TEST_MSS, tcp_hdr.seq);
+	sys_put_be32(1, tcp_hdr.ack);
+	sys_put_be16(8192, tcp_hdr.wnd);
+
+	pkt = net_pkt_rx_alloc_with_buffer(test_iface, NET_IPV6TCPH_LEN + TEST_MSS,
+					   AF_INET6, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	zassert_ok(net_ipv6_create(pkt, &peer_addr, &my_addr));
+	zassert_ok(net_pkt_write(pkt, &tcp_hdr, sizeof(tcp_hdr)));
+	zassert_ok(net_pkt_write(pkt, &test_data[seg * TEST_MSS], TEST_MSS));
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv6_finalize(pkt, IPPROTO_TCP));
+
+	/* The stack sees the packet as received, not as being sent */
+	net_pkt_set_family(pkt, AF_UNSPEC);
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static void receive(struct net_pkt *pkt)
+{
+	net_process_rx_packet_gro(pkt, &gro);
+}
+
+static void get_stats(struct net_stats_gro *stats)
+{
+	zassert_ok(net_mgmt(NET_REQUEST_STATS_GET_GRO, test_iface,
+			    stats, sizeof(*stats)), "Cannot get GRO stats");
+}
+
+static void verify_recv(int idx, uint16_t port, int first_seg, int segs,
+			uint8_t flags)
+{
+	zassert_equal(recv[idx].port, port, "Packet %d port", idx);
+	zassert_equal(recv[idx].seq, (uint32_t)(TEST_SEQ + first_seg * TEST_MSS),
+		      "Packet %d sequence number", idx);
+	zassert_equal(recv[idx].len, segs * TEST_MSS, "Packet %d length (%zu)",
+		      idx, recv[idx].len);
+	zassert_equal(recv[idx].flags, flags, "Packet %d flags 0x%02x", idx,
+		      recv[idx].flags);
+	zassert_true(recv[idx].data_ok, "Packet %d data", idx);
+}
+
+ZTEST(net_gro, test_coalesce)
+{
+	struct net_stats_gro before, after;
+
+	get_stats(&before);
+
+	for (int i = 0; i < TEST_SEGS; i++) {
+		receive(create_segment(REMOTE_PORT, i, TCP_ACK));
+	}
+
+	zassert_equal(recv_count, 0, "Segments were not held");
+
+	net_gro_flush(&gro);
+
+	zassert_equal(recv_count, 1, "Segments were not coalesced (%d)", recv_count);
+	verify_recv(0, REMOTE_PORT, 0, TEST_SEGS, TCP_ACK);
+
+	get_stats(&after);
+	zassert_equal(after.held - before.held, 1, "held");
+	zassert_equal(after.merged - before.merged, TEST_SEGS - 1, "merged");
+	zassert_equal(after.flushed - before.flushed, 1, "flushed");
+}
+
+ZTEST(net_gro, test_push_flushes)
+{
+	receive(create_segment(REMOTE_PORT, 0, TCP_ACK));
+	receive(create_segment(REMOTE_PORT, 1, TCP_ACK | TCP_PSH));
+
+	zassert_equal(recv_count, 1, "PSH did not flush the flow");
+	verify_recv(0, REMOTE_PORT, 0, 2, TCP_ACK | TCP_PSH);
+
+	/* A pushed segment starting a flow is not held */
+	receive(create_segment(REMOTE_PORT, 2, TCP_ACK | TCP_PSH));
+
+	zassert_equal(recv_count, 2, "Pushed segment was held");
+	verify_recv(1, REMOTE_PORT, 2, 1, TCP_ACK | TCP_PSH);
+
+	net_gro_flush(&gro);
+	zassert_equal(recv_count, 2, "Nothing should have been held");
+}
+
+ZTEST(net_gro, test_out_of_order)
+{
+	receive(create_segment(REMOTE_PORT, 0, TCP_ACK));
+	receive(create_segment(REMOTE_PORT, 2, TCP_ACK));
+	receive(create_segment(REMOTE_PORT, 3, TCP_ACK));
+
+	/* The gap flushes the first segment, the others are coalesced */
+	zassert_equal(recv_count, 1, "Gap did not flush the flow");
+	verify_recv(0, REMOTE_PORT, 0, 1, TCP_ACK);
+
+	net_gro_flush(&gro);
+
+	zassert_equal(recv_count, 2, "Unexpected number of packets");
+	verify_recv(1, REMOTE_PORT, 2, 2, TCP_ACK);
+}
+
+ZTEST(net_gro, test_control_segment)
+{
+	receive(create_segment(REMOTE_PORT, 0, TCP_ACK));
+	receive(create_segment(REMOTE_PORT, 1, TCP_ACK));
+	receive(create_segment(REMOTE_PORT, 2, TCP_ACK | TCP_FIN));
+
+	/* The FIN is passed on in order, after the held data */
+	zassert_equal(recv_count, 2, "Unexpected number of packets");
+	verify_recv(0, REMOTE_PORT, 0, 2, TCP_ACK);
+	verify_recv(1, REMOTE_PORT, 2, 1, TCP_ACK | TCP_FIN);
+}
+
+ZTEST(net_gro, test_bad_checksum)
+{
+	struct net_pkt *pkt;
+
+	receive(create_segment(REMOTE_PORT, 0, TCP_ACK));
+
+	pkt = create_segment(REMOTE_PORT, 1, TCP_ACK);
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	zassert_ok(net_pkt_skip(pkt, NET_IPV6TCPH_LEN));
+	zassert_ok(net_pkt_write_u8(pkt, ~test_data[TEST_MSS]));
+	net_pkt_cursor_init(pkt);
+
+	/* The corrupted segment is not merged and is dropped by TCP */
+	receive(pkt);
+
+	zassert_equal(recv_count, 1, "Unexpected number of packets");
+	verify_recv(0, REMOTE_PORT, 0, 1, TCP_ACK);
+
+	net_gro_flush(&gro);
+	zassert_equal(recv_count, 1, "Nothing should have been held");
+}
+
+ZTEST(net_gro, test_flows)
+{
+	receive(create_segment(REMOTE_PORT, 0, TCP_ACK));
+	receive(create_segment(REMOTE_PORT + 1, 0, TCP_ACK));
+	receive(create_segment(REMOTE_PORT, 1, TCP_ACK));
+	receive(create_segment(REMOTE_PORT + 1, 1, TCP_ACK));
+
+	zassert_equal(recv_count, 0, "Segments were not held");
+
+	/* No room for a third flow, the oldest one is passed on */
+	receive(create_segment(REMOTE_PORT + 2, 0, TCP_ACK));
+
+	zassert_equal(recv_count, 1, "Oldest flow was not flushed");
+	verify_recv(0, REMOTE_PORT, 0, 2, TCP_ACK);
+
+	net_gro_flush(&gro);
+
+	zassert_equal(recv_count, 3, "Unexpected number of packets");
+	verify_recv(1, REMOTE_PORT + 1, 0, 2, TCP_ACK);
+	verify_recv(2, REMOTE_PORT + 2, 0, 1, TCP_ACK);
+}
+
+ZTEST(net_gro, test_not_ip)
+{
+	struct net_stats_gro before, after;
+	struct net_pkt *pkt;
+
+	get_stats(&before);
+
+	/* Only L2 knows what the packet is, the first byte is not enough */
+	pkt = create_segment(REMOTE_PORT, 0, TCP_ACK);
+	net_pkt_set_ll_proto_type(pkt, NET_ETH_PTYPE_ARP);
+	receive(pkt);
+
+	zassert_equal(recv_count, 1, "Non-IP frame was held");
+
+	pkt = create_segment(REMOTE_PORT, 1, TCP_ACK);
+	net_pkt_set_family(pkt, AF_PACKET);
+	receive(pkt);
+
+	net_gro_flush(&gro);
+
+	get_stats(&after);
+	zassert_equal(after.held, before.held, "Frames were held");
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	net_gro_init(&gro);
+	recv_count = 0;
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	net_gro_flush(&gro);
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in6 local = {
+		.sin6_family = AF_INET6,
+	};
+
+	for (int i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = i;
+	}
+
+	zassert_not_null(test_iface, "No test interface");
+	zassert_not_null(net_if_ipv6_addr_add(test_iface, &my_addr,
+					      NET_ADDR_MANUAL, 0),
+			 "Cannot add address");
+
+	net_ipaddr_copy(&local.sin6_addr, &my_addr);
+
+	zassert_ok(net_conn_register(IPPROTO_TCP, SOCK_STREAM, AF_INET6, NULL,
+				     (struct sockaddr *)&local, 0, LOCAL_PORT,
+				     NULL, tcp_recv, NULL, &conn_handle),
+		   "Cannot register TCP handler");
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_gro, NULL, setup, before, after, NULL);
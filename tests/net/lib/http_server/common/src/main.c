@@ -396,6 +396,31 @@ ZTEST(http_service, test_HTTP_RESOURCE_WILDCARD)
 	zassert_equal(res, RES(3), "Resource mismatch");
 }
 
+ZTEST(http_service, test_HTTP_RESOURCE_LEADING_DIR)
+{
+	struct http_resource_detail *res;
+	int len;
+
+	/* A resource also matches the paths below it */
+	res = CHECK_PATH(service_A, "/index.html/extra", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, strlen("/index.html/extra"), "Length incorrect");
+	zassert_equal(res, RES(1), "Resource mismatch");
+
+	res = CHECK_PATH(service_A, "/index.html?param=/value", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, strlen("/index.html"), "Length incorrect");
+	zassert_equal(res, RES(1), "Resource mismatch");
+
+	res = CHECK_PATH(service_A, "/index.htm", &len);
+	zassert_is_null(res, "Resource found");
+	zassert_equal(len, 0, "Length set");
+
+	res = CHECK_PATH(service_A, "/fs", &len);
+	zassert_is_null(res, "Resource found");
+	zassert_equal(len, 0, "Length set");
+}
+
 ZTEST(http_service, test_HTTP_RESOURCE_DEFAULT)
 {
 #define NON_EXISTING_PATH "/this_path_is_not_registered"
@@ -480,4 +505,16 @@ ZTEST(http_service, test_HTTP_SERVER_CONTENT_TYPE)
 	zassert_str_equal(content_type, "video/mpeg");
 }
 
-ZTEST_SUITE(http_service, NULL, NULL, NULL, NULL, NULL);
+extern void http_server_routes_init(void);
+
+static void *http_service_setup(void)
+{
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_ROUTE_TABLE)) {
+		/* Normally done when the server is started */
+		http_server_routes_init();
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(http_service, NULL, http_service_setup, NULL, NULL, NULL);
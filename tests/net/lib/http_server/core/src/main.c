@@ -18,6 +18,7 @@
 #define BUFFER_SIZE                    1024
 #define SERVER_IPV4_ADDR               "127.0.0.1"
 #define SERVER_PORT                    8080
+#define WORKER_SERVER_PORT             8081
 #define TIMEOUT_S                      1
 
 #define UPGRADE_STREAM_ID              1
@@ -27,6 +28,7 @@
 #define TEST_DYNAMIC_POST_PAYLOAD "Test dynamic POST"
 #define TEST_DYNAMIC_GET_PAYLOAD "Test dynamic GET"
 #define TEST_STATIC_PAYLOAD "Hello, World!"
+#define TEST_BLOCKING_PAYLOAD "Test blocking GET"
 #define TEST_STATIC_FS_PAYLOAD "Hello, World from static file!"
 
 /* Random base64 encoded data */
@@ -321,6 +323,53 @@ struct http_resource_detail_dynamic dynamic_detail = {
 HTTP_RESOURCE_DEFINE(dynamic_resource, test_http_service, "/dynamic",
 		     &dynamic_detail);
 
+#if CONFIG_HTTP_SERVER_WORKERS > 0
+/* Service for two clients, one of them stuck in a slow resource */
+static uint16_t test_worker_service_port = WORKER_SERVER_PORT;
+HTTP_SERVICE_DEFINE(test_worker_service, SERVER_IPV4_ADDR,
+		    &test_worker_service_port, 2, 10, NULL, NULL, NULL);
+
+HTTP_RESOURCE_DEFINE(worker_static_resource, test_worker_service, "/",
+		     &static_resource_detail);
+
+static K_SEM_DEFINE(blocking_started, 0, 1);
+static K_SEM_DEFINE(blocking_release, 0, 1);
+
+static int blocking_cb(struct http_client_ctx *client, enum http_data_status status,
+		       const struct http_request_ctx *request_ctx,
+		       struct http_response_ctx *response_ctx, void *user_data)
+{
+	static const uint8_t payload[] = TEST_BLOCKING_PAYLOAD;
+
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		return 0;
+	}
+
+	/* Stall the worker thread until the test lets it go */
+	k_sem_give(&blocking_started);
+	(void)k_sem_take(&blocking_release, K_SECONDS(5));
+
+	response_ctx->body = payload;
+	response_ctx->body_len = sizeof(payload) - 1;
+	response_ctx->final_chunk = true;
+
+	return 0;
+}
+
+static struct http_resource_detail_dynamic blocking_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.content_type = "text/plain",
+	},
+	.cb = blocking_cb,
+	.user_data = NULL,
+};
+
+HTTP_RESOURCE_DEFINE(blocking_resource, test_worker_service, "/blocking",
+		     &blocking_detail);
+#endif /* CONFIG_HTTP_SERVER_WORKERS > 0 */
+
 struct test_headers_clone {
 	uint8_t buffer[CONFIG_HTTP_SERVER_CAPTURE_HEADER_BUFFER_SIZE];
 	struct http_header headers[CONFIG_HTTP_SERVER_CAPTURE_HEADER_COUNT];
@@ -542,6 +591,8 @@ HTTP_RESOURCE_DEFINE(dynamic_response_headers_resource, test_http_service, "/res
 		     &dynamic_response_headers_detail);
 
 static int client_fd = -1;
+/* Further clients of the tests that need several connections */
+static int extra_client_fds[2] = { -1, -1 };
 static uint8_t buf[BUFFER_SIZE];
 
 /* This function ensures that there's at least as much data as requested in
@@ -2781,6 +2832,152 @@ ZTEST(server_function_tests, test_http1_static_fs_compression)
 }
 #endif /* DT_HAS_COMPAT_STATUS_OKAY(zephyr_ram_disk) */
 
+static const char test_static_request[] =
+	"GET / HTTP/1.1\r\n"
+	"Host: 127.0.0.1:8080\r\n"
+	"\r\n";
+static const char test_static_response[] =
+	"HTTP/1.1 200 OK\r\n"
+	"Content-Type: text/html\r\n"
+	"Content-Length: 13\r\n"
+	"\r\n"
+	TEST_STATIC_PAYLOAD;
+
+static int test_connect(uint16_t port)
+{
+	struct sockaddr_in sa = { 0 };
+	struct timeval optval = {
+		.tv_sec = TIMEOUT_S,
+		.tv_usec = 0,
+	};
+	int fd;
+	int ret;
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_not_equal(fd, -1, "failed to create client socket (%d)", errno);
+
+	ret = zsock_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &optval, sizeof(optval));
+	zassert_ok(ret, "failed to set timeout (%d)", errno);
+
+	sa.sin_family = AF_INET;
+	sa.sin_port = htons(port);
+
+	ret = zsock_inet_pton(AF_INET, SERVER_IPV4_ADDR, &sa.sin_addr.s_addr);
+	zassert_equal(1, ret, "inet_pton() failed to convert %s", SERVER_IPV4_ADDR);
+
+	zassert_ok(zsock_connect(fd, (struct sockaddr *)&sa, sizeof(sa)),
+		   "failed to connect to the server (%d)", errno);
+
+	return fd;
+}
+
+static void test_send_request(int fd, const char *request)
+{
+	int ret;
+
+	ret = zsock_send(fd, request, strlen(request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+}
+
+static void test_expect_response(int fd, const char *expected)
+{
+	size_t len = strlen(expected);
+	size_t offset = 0;
+	int ret;
+
+	memset(buf, 0, sizeof(buf));
+
+	while (offset < len) {
+		ret = zsock_recv(fd, buf + offset, sizeof(buf) - offset, 0);
+		zassert_true(ret > 0, "No response (%d)", ret < 0 ? errno : 0);
+		offset += ret;
+	}
+
+	zassert_mem_equal(buf, expected, len, "Received data doesn't match expected response");
+}
+
+static void test_expect_no_response(int fd)
+{
+	struct zsock_pollfd pfd = {
+		.fd = fd,
+		.events = ZSOCK_POLLIN,
+	};
+
+	zassert_equal(zsock_poll(&pfd, 1, 200), 0, "Unexpected response");
+}
+
+/* The service allows a single client. A second connection must wait until
+ * the first one goes away, then be accepted and served. With workers, the
+ * worker that releases the first client wakes up the server thread, which
+ * owns the listen socket.
+ */
+ZTEST(server_function_tests, test_concurrency_limit_resume)
+{
+	/* The first client takes the only slot */
+	test_send_request(client_fd, test_static_request);
+	test_expect_response(client_fd, test_static_response);
+
+	extra_client_fds[0] = test_connect(SERVER_PORT);
+	test_send_request(extra_client_fds[0], test_static_request);
+	test_expect_no_response(extra_client_fds[0]);
+
+	zassert_ok(zsock_close(client_fd), "close() failed on the client fd (%d)", errno);
+	client_fd = -1;
+
+	test_expect_response(extra_client_fds[0], test_static_response);
+}
+
+/* A dynamic resource blocks the worker serving one client, a client of
+ * another worker must still be served meanwhile.
+ */
+ZTEST(server_function_tests, test_workers_blocking_resource)
+{
+#if CONFIG_HTTP_SERVER_WORKERS > 0
+	static const char blocking_request[] =
+		"GET /blocking HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8081\r\n"
+		"\r\n";
+	static const char blocking_response[] =
+		"HTTP/1.1 200\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"Content-Type: text/plain\r\n"
+		"\r\n"
+		"11\r\n" TEST_BLOCKING_PAYLOAD "\r\n"
+		"0\r\n\r\n";
+	int slow_fd;
+	int fast_fd;
+
+	k_sem_reset(&blocking_started);
+	k_sem_reset(&blocking_release);
+
+	/* Keep the workers for the clients of this test, and let the worker
+	 * of the default client release it.
+	 */
+	zassert_ok(zsock_close(client_fd), "close() failed on the client fd (%d)", errno);
+	client_fd = -1;
+	k_msleep(100);
+
+	slow_fd = test_connect(WORKER_SERVER_PORT);
+	extra_client_fds[0] = slow_fd;
+	test_send_request(slow_fd, blocking_request);
+	zassert_ok(k_sem_take(&blocking_started, K_SECONDS(TIMEOUT_S)),
+		   "Blocking resource not called");
+
+	/* Handed to the least loaded worker, the one not blocked */
+	fast_fd = test_connect(WORKER_SERVER_PORT);
+	extra_client_fds[1] = fast_fd;
+	test_send_request(fast_fd, test_static_request);
+	test_expect_response(fast_fd, test_static_response);
+
+	test_expect_no_response(slow_fd);
+
+	k_sem_give(&blocking_release);
+	test_expect_response(slow_fd, blocking_response);
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void http_server_tests_before(void *fixture)
 {
 	struct sockaddr_in sa;
@@ -2843,6 +3040,13 @@ static void http_server_tests_after(void *fixture)
 		client_fd = -1;
 	}
 
+	ARRAY_FOR_EACH(extra_client_fds, i) {
+		if (extra_client_fds[i] >= 0) {
+			(void)zsock_close(extra_client_fds[i]);
+			extra_client_fds[i] = -1;
+		}
+	}
+
 	(void)http_server_stop();
 
 	k_yield();
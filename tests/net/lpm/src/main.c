@@ -0,0 +1,181 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_ip.h>
+
+#include "lpm.h"
+
+#define MAX_PREFIXES 8
+
+NET_LPM_DEFINE(lpm4, MAX_PREFIXES, 32);
+NET_LPM_DEFINE(lpm6, MAX_PREFIXES, 128);
+
+struct entry {
+	sys_snode_t node;
+	const char *prefix;
+	uint8_t len;
+	struct net_lpm_node *lpm;
+};
+
+static void entry_add(struct net_lpm *lpm, struct entry *entry, sa_family_t family)
+{
+	uint8_t prefix[NET_LPM_MAX_KEY_LEN];
+
+	zassert_equal(net_addr_pton(family, entry->prefix, prefix), 0,
+		      "cannot parse %s", entry->prefix);
+
+	entry->lpm = net_lpm_get(lpm, prefix, entry->len);
+	zassert_not_null(entry->lpm, "cannot add %s/%u", entry->prefix, entry->len);
+
+	sys_slist_append(&entry->lpm->entries, &entry->node);
+}
+
+static void entry_del(struct net_lpm *lpm, struct entry *entry)
+{
+	zassert_true(sys_slist_find_and_remove(&entry->lpm->entries, &entry->node));
+	net_lpm_put(lpm, entry->lpm);
+	entry->lpm = NULL;
+}
+
+static struct entry *lookup(struct net_lpm *lpm, sa_family_t family, const char *addr)
+{
+	uint8_t key[NET_LPM_MAX_KEY_LEN];
+	struct net_lpm_node *node;
+
+	zassert_equal(net_addr_pton(family, addr, key), 0, "cannot parse %s", addr);
+
+	node = net_lpm_lookup(lpm, key);
+	if (node == NULL) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(sys_slist_peek_head(&node->entries), struct entry, node);
+}
+
+ZTEST(net_lpm, test_ipv4)
+{
+	struct entry entries[] = {
+		{ .prefix = "0.0.0.0", .len = 0 },
+		{ .prefix = "10.0.0.0", .len = 8 },
+		{ .prefix = "10.1.0.0", .len = 16 },
+		{ .prefix = "10.1.2.0", .len = 24 },
+		{ .prefix = "10.1.2.3", .len = 32 },
+		{ .prefix = "192.168.0.0", .len = 16 },
+		{ .prefix = "192.168.128.0", .len = 17 },
+	};
+
+	net_lpm_init(&lpm4);
+
+	zassert_is_null(lookup(&lpm4, AF_INET, "10.1.2.3"), "empty table matched");
+
+	ARRAY_FOR_EACH_PTR(entries, entry) {
+		entry_add(&lpm4, entry, AF_INET);
+	}
+
+	zassert_equal_ptr(lookup(&lpm4, AF_INET, "10.1.2.3"), &entries[4]);
+	zassert_equal_ptr(lookup(&lpm4, AF_INET, "10.1.2.4"), &entries[3]);
+	zassert_equal_ptr(lookup(&lpm4, AF_INET, "10.1.3.1"), &entries[2]);
+	zassert_equal_ptr(lookup(&lpm4, AF_INET, "10.2.0.1"), &entries[1]);
+	zassert_equal_ptr(lookup(&lpm4, AF_INET, "192.168.127.1"), &entries[5]);
+	zassert_equal_ptr(lookup(&lpm4, AF_INET, "192.168.128.1"), &entries[6]);
+	zassert_equal_ptr(lookup(&lpm4, AF_INET, "172.16.0.1"), &entries[0]);
+
+	/* Removing a prefix makes the next shorter one match */
+	entry_del(&lpm4, &entries[3]);
+	zassert_equal_ptr(lookup(&lpm4, AF_INET, "10.1.2.4"), &entries[2]);
+	zassert_equal_ptr(lookup(&lpm4, AF_INET, "10.1.2.3"), &entries[4]);
+
+	entry_del(&lpm4, &entries[0]);
+	zassert_is_null(lookup(&lpm4, AF_INET, "172.16.0.1"), "default route matched");
+
+	ARRAY_FOR_EACH_PTR(entries, entry) {
+		if (entry->lpm != NULL) {
+			entry_del(&lpm4, entry);
+		}
+	}
+
+	zassert_is_null(lpm4.root, "nodes left in an empty table");
+}
+
+ZTEST(net_lpm, test_ipv6)
+{
+	struct entry entries[] = {
+		{ .prefix = "2001:db8::", .len = 32 },
+		{ .prefix = "2001:db8:0:1::", .len = 64 },
+		{ .prefix = "2001:db8:0:2::", .len = 64 },
+		{ .prefix = "2001:db8:0:1::1", .len = 128 },
+		{ .prefix = "fd00::", .len = 8 },
+	};
+	struct entry other = { .prefix = "2001:db8:0:1::", .len = 64 };
+	struct net_lpm_node *node;
+	uint8_t key[NET_LPM_MAX_KEY_LEN];
+
+	net_lpm_init(&lpm6);
+
+	ARRAY_FOR_EACH_PTR(entries, entry) {
+		entry_add(&lpm6, entry, AF_INET6);
+	}
+
+	zassert_equal_ptr(lookup(&lpm6, AF_INET6, "2001:db8:0:1::1"), &entries[3]);
+	zassert_equal_ptr(lookup(&lpm6, AF_INET6, "2001:db8:0:1::2"), &entries[1]);
+	zassert_equal_ptr(lookup(&lpm6, AF_INET6, "2001:db8:0:2::1"), &entries[2]);
+	zassert_equal_ptr(lookup(&lpm6, AF_INET6, "2001:db8:0:3::1"), &entries[0]);
+	zassert_equal_ptr(lookup(&lpm6, AF_INET6, "fdab::1"), &entries[4]);
+	zassert_is_null(lookup(&lpm6, AF_INET6, "fe80::1"), "unrelated address matched");
+
+	/* Entries of the same prefix share their node */
+	entry_add(&lpm6, &other, AF_INET6);
+	zassert_equal_ptr(other.lpm, entries[1].lpm);
+
+	/* Walk all the matching prefixes, longest first */
+	zassert_equal(net_addr_pton(AF_INET6, "2001:db8:0:1::1", key), 0);
+	node = net_lpm_lookup(&lpm6, key);
+	zassert_equal_ptr(node, entries[3].lpm);
+	node = net_lpm_lookup_next(node);
+	zassert_equal_ptr(node, entries[1].lpm);
+	node = net_lpm_lookup_next(node);
+	zassert_equal_ptr(node, entries[0].lpm);
+	zassert_is_null(net_lpm_lookup_next(node));
+
+	/* The node stays as long as one of its entries does */
+	entry_del(&lpm6, &entries[1]);
+	zassert_equal_ptr(lookup(&lpm6, AF_INET6, "2001:db8:0:1::2"), &other);
+	entry_del(&lpm6, &other);
+	zassert_equal_ptr(lookup(&lpm6, AF_INET6, "2001:db8:0:1::2"), &entries[0]);
+
+	ARRAY_FOR_EACH_PTR(entries, entry) {
+		if (entry->lpm != NULL) {
+			entry_del(&lpm6, entry);
+		}
+	}
+
+	zassert_is_null(lpm6.root, "nodes left in an empty table");
+}
+
+ZTEST(net_lpm, test_pool_size)
+{
+	struct entry entries[MAX_PREFIXES];
+	uint8_t prefix[NET_LPM_MAX_KEY_LEN] = { 0 };
+
+	net_lpm_init(&lpm4);
+
+	/* Host routes that all diverge need a branch node each */
+	ARRAY_FOR_EACH(entries, i) {
+		prefix[3] = i * 0x20;
+		entries[i].lpm = net_lpm_get(&lpm4, prefix, 32);
+		zassert_not_null(entries[i].lpm, "pool exhausted at %zu", i);
+		sys_slist_append(&entries[i].lpm->entries, &entries[i].node);
+	}
+
+	ARRAY_FOR_EACH_PTR(entries, entry) {
+		entry_del(&lpm4, entry);
+	}
+
+	zassert_is_null(lpm4.root, "nodes left in an empty table");
+}
+
+ZTEST_SUITE(net_lpm, NULL, NULL, NULL, NULL, NULL);
@@ -544,6 +544,50 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_longest_prefix(void)
+{
+	struct net_route_entry *prefix_route, *host_route, *entry;
+	struct in6_addr host_addr, other_addr;
+
+	net_ipaddr_copy(&host_addr, &generic_addr);
+	host_addr.s6_addr[15] = 0x01;
+	net_ipaddr_copy(&other_addr, &generic_addr);
+	other_addr.s6_addr[15] = 0x02;
+
+	/* Adding a route replaces the one its address already matches, so
+	 * the more specific route goes first.
+	 */
+	host_route = net_route_add(my_iface, &host_addr, 128, &peer_addr,
+				   NET_IPV6_ND_INFINITE_LIFETIME,
+				   NET_ROUTE_PREFERENCE_MEDIUM);
+	zassert_not_null(host_route, "Host route add failed");
+
+	prefix_route = net_route_add(my_iface, &generic_addr, 64, &peer_addr,
+				     NET_IPV6_ND_INFINITE_LIFETIME,
+				     NET_ROUTE_PREFERENCE_MEDIUM);
+	zassert_not_null(prefix_route, "Prefix route add failed");
+	zassert_not_equal(host_route, prefix_route, "Prefix route replaced host route");
+
+	entry = net_route_lookup(my_iface, &host_addr);
+	zassert_equal_ptr(entry, host_route, "Longest prefix not selected");
+
+	entry = net_route_lookup(my_iface, &other_addr);
+	zassert_equal_ptr(entry, prefix_route, "Prefix route not selected");
+
+	entry = net_route_lookup(peer_iface, &host_addr);
+	zassert_is_null(entry, "Route found on wrong interface");
+
+	/* A cached result must not survive the removal of the route */
+	zassert_ok(net_route_del(host_route), "Host route del failed");
+
+	entry = net_route_lookup(my_iface, &host_addr);
+	zassert_equal_ptr(entry, prefix_route, "Removed route still selected");
+
+	zassert_ok(net_route_del(prefix_route), "Prefix route del failed");
+
+	entry = net_route_lookup(my_iface, &other_addr);
+	zassert_is_null(entry, "Removed prefix route still selected");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +610,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
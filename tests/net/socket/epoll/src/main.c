@@ -0,0 +1,256 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/zvfs/epoll.h>
+#include <zephyr/zvfs/eventfd.h>
+
+#include "../../socket_helpers.h"
+
+#define MY_IPV4_ADDR "127.0.0.1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+#define WAIT_MS 1000
+#define MAX_EVENTS 4
+
+#define SERVER_DATA 1
+#define EVENTFD_DATA 2
+
+static int server_sock = -1;
+static int client_sock = -1;
+static struct sockaddr_in server_addr;
+static struct sockaddr_in client_addr;
+
+static int epfd = -1;
+static int efd = -1;
+
+static struct zvfs_epoll_event events[MAX_EVENTS];
+
+static void send_datagram(void)
+{
+	static const char data[] = "epoll";
+	ssize_t ret;
+
+	ret = zsock_sendto(client_sock, data, sizeof(data), 0,
+			   (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(ret, sizeof(data), "sendto failed (%d)", errno);
+}
+
+static void recv_datagram(void)
+{
+	char buf[16];
+	ssize_t ret;
+
+	ret = zsock_recv(server_sock, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT);
+	zassert_true(ret > 0, "recv failed (%d)", errno);
+}
+
+static void add_fd(int fd, uint32_t flags, uint32_t data)
+{
+	struct zvfs_epoll_event ev = {
+		.events = flags,
+		.data.u32 = data,
+	};
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, fd, &ev),
+		   "epoll_ctl ADD failed (%d)", errno);
+}
+
+static void expect_events(int timeout, int count, uint32_t data)
+{
+	int ret;
+
+	ret = zvfs_epoll_wait(epfd, events, ARRAY_SIZE(events), timeout);
+	zassert_equal(ret, count, "Unexpected number of events (%d)", ret);
+
+	if (count > 0) {
+		zassert_equal(events[0].data.u32, data, "Wrong data");
+		zassert_true(events[0].events & ZVFS_EPOLLIN, "POLLIN not reported");
+	}
+}
+
+ZTEST(net_socket_epoll, test_socket_level_triggered)
+{
+	add_fd(server_sock, ZVFS_EPOLLIN, SERVER_DATA);
+
+	expect_events(0, 0, 0);
+
+	send_datagram();
+	expect_events(WAIT_MS, 1, SERVER_DATA);
+
+	/* Still reported as long as the data is not read */
+	expect_events(0, 1, SERVER_DATA);
+
+	recv_datagram();
+	expect_events(0, 0, 0);
+
+	/* And reported again once new data arrives */
+	send_datagram();
+	expect_events(WAIT_MS, 1, SERVER_DATA);
+	recv_datagram();
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, server_sock, NULL));
+}
+
+ZTEST(net_socket_epoll, test_socket_oneshot)
+{
+	struct zvfs_epoll_event ev = {
+		.events = ZVFS_EPOLLIN | ZVFS_EPOLLONESHOT,
+		.data.u32 = SERVER_DATA,
+	};
+
+	add_fd(server_sock, ev.events, SERVER_DATA);
+
+	send_datagram();
+	expect_events(WAIT_MS, 1, SERVER_DATA);
+
+	/* Disabled after the first report, even with pending data */
+	expect_events(0, 0, 0);
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_MOD, server_sock, &ev));
+	expect_events(0, 1, SERVER_DATA);
+
+	recv_datagram();
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, server_sock, NULL));
+}
+
+static void eventfd_writer(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	zassert_ok(zvfs_eventfd_write(efd, 1));
+}
+
+static K_WORK_DELAYABLE_DEFINE(eventfd_work, eventfd_writer);
+
+ZTEST(net_socket_epoll, test_eventfd_wakeup)
+{
+	zvfs_eventfd_t value;
+
+	add_fd(efd, ZVFS_EPOLLIN, EVENTFD_DATA);
+
+	expect_events(0, 0, 0);
+
+	/* The waiter is woken up by a write from another thread */
+	k_work_schedule(&eventfd_work, K_MSEC(50));
+	expect_events(WAIT_MS, 1, EVENTFD_DATA);
+
+	zassert_ok(zvfs_eventfd_read(efd, &value));
+	zassert_equal(value, 1, "Wrong eventfd value");
+
+	expect_events(0, 0, 0);
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, efd, NULL));
+}
+
+ZTEST(net_socket_epoll, test_only_ready_reported)
+{
+	add_fd(server_sock, ZVFS_EPOLLIN, SERVER_DATA);
+	add_fd(efd, ZVFS_EPOLLIN, EVENTFD_DATA);
+
+	zassert_ok(zvfs_eventfd_write(efd, 1));
+	expect_events(WAIT_MS, 1, EVENTFD_DATA);
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, efd, NULL));
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, server_sock, NULL));
+
+	/* Consume the counter for the next tests */
+	zassert_ok(zvfs_eventfd_read(efd, &(zvfs_eventfd_t){0}));
+}
+
+ZTEST(net_socket_epoll, test_poll_epoll_fd)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = epfd,
+		.events = ZVFS_POLLIN,
+	};
+
+	add_fd(server_sock, ZVFS_EPOLLIN, SERVER_DATA);
+
+	zassert_equal(zvfs_poll(&pfd, 1, 0), 0, "epoll fd should not be ready");
+
+	send_datagram();
+	zassert_equal(zvfs_poll(&pfd, 1, WAIT_MS), 1, "epoll fd should be ready");
+	zassert_true(pfd.revents & ZVFS_POLLIN, "POLLIN not reported");
+
+	expect_events(0, 1, SERVER_DATA);
+	recv_datagram();
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, server_sock, NULL));
+}
+
+ZTEST(net_socket_epoll, test_ctl_errors)
+{
+	struct zvfs_epoll_event ev = {
+		.events = ZVFS_EPOLLIN,
+	};
+
+	add_fd(server_sock, ZVFS_EPOLLIN, SERVER_DATA);
+
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, server_sock, &ev), -1);
+	zassert_equal(errno, EEXIST, "Unexpected errno (%d)", errno);
+
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_MOD, client_sock, &ev), -1);
+	zassert_equal(errno, ENOENT, "Unexpected errno (%d)", errno);
+
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, epfd, &ev), -1);
+	zassert_equal(errno, EINVAL, "Unexpected errno (%d)", errno);
+
+	/* Edge-triggered mode is not supported */
+	ev.events = ZVFS_EPOLLIN | BIT(31);
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, client_sock, &ev), -1);
+	zassert_equal(errno, EINVAL, "Unexpected errno (%d)", errno);
+
+	zassert_equal(zvfs_epoll_ctl(server_sock, ZVFS_EPOLL_CTL_ADD, client_sock, &ev), -1);
+	zassert_equal(errno, EINVAL, "Unexpected errno (%d)", errno);
+
+	zassert_equal(zvfs_epoll_wait(epfd, events, 0, 0), -1);
+	zassert_equal(errno, EINVAL, "Unexpected errno (%d)", errno);
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, server_sock, NULL));
+
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, server_sock, NULL), -1);
+	zassert_equal(errno, ENOENT, "Unexpected errno (%d)", errno);
+}
+
+static void *setup(void)
+{
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	zassert_ok(zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			      sizeof(server_addr)), "bind failed");
+	zassert_ok(zsock_bind(client_sock, (struct sockaddr *)&client_addr,
+			      sizeof(client_addr)), "bind failed");
+
+	epfd = zvfs_epoll_create(0);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	efd = zvfs_eventfd(0, 0);
+	zassert_true(efd >= 0, "eventfd failed (%d)", errno);
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)zsock_close(epfd);
+	(void)zsock_close(efd);
+	(void)zsock_close(server_sock);
+	(void)zsock_close(client_sock);
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,221 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+
+#include "../../socket_helpers.h"
+
+#define MY_IPV4_ADDR "127.0.0.1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+#define MSG_COUNT 3
+#define MSG_LEN   32
+#define WAIT_MS   100
+
+static int server_sock = -1;
+static int client_sock = -1;
+static struct sockaddr_in server_addr;
+static struct sockaddr_in client_addr;
+
+static uint8_t tx_buf[MSG_COUNT][MSG_LEN];
+static uint8_t rx_buf[MSG_COUNT][MSG_LEN];
+static struct iovec tx_iov[MSG_COUNT];
+static struct iovec rx_iov[MSG_COUNT];
+static struct sockaddr_in rx_addr[MSG_COUNT];
+static struct zsock_mmsghdr tx_msgs[MSG_COUNT];
+static struct zsock_mmsghdr rx_msgs[MSG_COUNT];
+
+static void prepare_tx(struct sockaddr_in *dest)
+{
+	for (int i = 0; i < MSG_COUNT; i++) {
+		/* Different length and content for each message */
+		memset(tx_buf[i], 'a' + i, sizeof(tx_buf[i]));
+
+		tx_iov[i].iov_base = tx_buf[i];
+		tx_iov[i].iov_len = MSG_LEN - i;
+
+		memset(&tx_msgs[i], 0, sizeof(tx_msgs[i]));
+		tx_msgs[i].msg_hdr.msg_name = dest;
+		tx_msgs[i].msg_hdr.msg_namelen = dest != NULL ? sizeof(*dest) : 0;
+		tx_msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+}
+
+static void prepare_rx(void)
+{
+	memset(rx_buf, 0, sizeof(rx_buf));
+
+	for (int i = 0; i < MSG_COUNT; i++) {
+		rx_iov[i].iov_base = rx_buf[i];
+		rx_iov[i].iov_len = sizeof(rx_buf[i]);
+
+		memset(&rx_msgs[i], 0, sizeof(rx_msgs[i]));
+		rx_msgs[i].msg_hdr.msg_name = &rx_addr[i];
+		rx_msgs[i].msg_hdr.msg_namelen = sizeof(rx_addr[i]);
+		rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+}
+
+static void verify_rx(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_equal(rx_msgs[i].msg_len, MSG_LEN - i,
+			      "Wrong length for message %d", i);
+		zassert_mem_equal(rx_buf[i], tx_buf[i], MSG_LEN - i,
+				  "Data mismatch in message %d", i);
+		zassert_equal(rx_addr[i].sin_port, client_addr.sin_port,
+			      "Wrong source port for message %d", i);
+	}
+}
+
+ZTEST(net_socket_mmsg, test_sendmmsg_recvmmsg)
+{
+	int ret;
+
+	prepare_tx(&server_addr);
+
+	ret = zsock_sendmmsg(client_sock, tx_msgs, MSG_COUNT, 0);
+	zassert_equal(ret, MSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MSG_COUNT; i++) {
+		zassert_equal(tx_msgs[i].msg_len, MSG_LEN - i,
+			      "Wrong sent length for message %d", i);
+	}
+
+	k_msleep(WAIT_MS);
+
+	prepare_rx();
+
+	ret = zsock_recvmmsg(server_sock, rx_msgs, MSG_COUNT, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, MSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	verify_rx(MSG_COUNT);
+}
+
+ZTEST(net_socket_mmsg, test_recvmmsg_waitforone)
+{
+	int ret;
+
+	prepare_tx(&server_addr);
+
+	ret = zsock_sendmmsg(client_sock, tx_msgs, 1, 0);
+	zassert_equal(ret, 1, "sendmmsg failed (%d)", errno);
+
+	prepare_rx();
+
+	/* Returns as soon as the first message is there */
+	ret = zsock_recvmmsg(server_sock, rx_msgs, MSG_COUNT, ZSOCK_MSG_WAITFORONE);
+	zassert_equal(ret, 1, "recvmmsg failed (%d)", errno);
+
+	verify_rx(1);
+}
+
+ZTEST(net_socket_mmsg, test_recvmmsg_empty)
+{
+	int ret;
+
+	prepare_rx();
+
+	ret = zsock_recvmmsg(server_sock, rx_msgs, MSG_COUNT, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, -1, "recvmmsg should fail");
+	zassert_equal(errno, EAGAIN, "Unexpected errno (%d)", errno);
+}
+
+ZTEST(net_socket_mmsg, test_sendmmsg_partial)
+{
+	int ret;
+
+	prepare_tx(&server_addr);
+
+	/* The socket is not connected, so a message without a destination
+	 * cannot be sent and ends the batch.
+	 */
+	tx_msgs[1].msg_hdr.msg_name = NULL;
+	tx_msgs[1].msg_hdr.msg_namelen = 0;
+
+	ret = zsock_sendmmsg(client_sock, tx_msgs, MSG_COUNT, 0);
+	zassert_equal(ret, 1, "Only the first message should be sent");
+
+	ret = zsock_sendmmsg(client_sock, &tx_msgs[1], MSG_COUNT - 1, 0);
+	zassert_equal(ret, -1, "sendmmsg should fail");
+
+	k_msleep(WAIT_MS);
+
+	prepare_rx();
+
+	ret = zsock_recvmmsg(server_sock, rx_msgs, MSG_COUNT, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, 1, "recvmmsg failed (%d)", errno);
+
+	verify_rx(1);
+}
+
+ZTEST(net_socket_mmsg, test_socketpair_fallback)
+{
+	uint8_t buf[2 * MSG_LEN];
+	int sv[2];
+	int ret;
+
+	zassert_ok(zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv),
+		   "socketpair failed (%d)", errno);
+
+	/* Socket pairs have no batch implementation, the messages are
+	 * sent one by one.
+	 */
+	prepare_tx(NULL);
+
+	ret = zsock_sendmmsg(sv[0], tx_msgs, 2, 0);
+	zassert_equal(ret, 2, "sendmmsg failed (%d)", errno);
+	zassert_equal(tx_msgs[1].msg_len, MSG_LEN - 1, "Wrong sent length");
+
+	ret = zsock_recv(sv[1], buf, sizeof(buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, 2 * MSG_LEN - 1, "recv failed (%d)", errno);
+	zassert_mem_equal(buf, tx_buf[0], MSG_LEN, "Data mismatch");
+	zassert_mem_equal(&buf[MSG_LEN], tx_buf[1], MSG_LEN - 1, "Data mismatch");
+
+	(void)zsock_close(sv[0]);
+	(void)zsock_close(sv[1]);
+}
+
+ZTEST(net_socket_mmsg, test_bad_fd)
+{
+	zassert_equal(zsock_sendmmsg(-1, tx_msgs, 1, 0), -1);
+	zassert_equal(errno, EBADF, "Unexpected errno (%d)", errno);
+
+	zassert_equal(zsock_recvmmsg(-1, rx_msgs, 1, 0), -1);
+	zassert_equal(errno, EBADF, "Unexpected errno (%d)", errno);
+}
+
+static void *setup(void)
+{
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	zassert_ok(zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			      sizeof(server_addr)), "bind failed");
+	zassert_ok(zsock_bind(client_sock, (struct sockaddr *)&client_addr,
+			      sizeof(client_addr)), "bind failed");
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)zsock_close(server_sock);
+	(void)zsock_close(client_sock);
+}
+
+ZTEST_SUITE(net_socket_mmsg, NULL, setup, NULL, NULL, teardown);
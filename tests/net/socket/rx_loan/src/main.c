@@ -0,0 +1,225 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+
+#include "../../socket_helpers.h"
+
+#define MY_IPV4_ADDR "127.0.0.1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+/* Spans several network buffers */
+#define TEST_DATA_LEN 600
+#define MAX_IOV       16
+
+static uint8_t test_data[TEST_DATA_LEN];
+static uint8_t rx_buf[TEST_DATA_LEN];
+
+static int server_sock = -1;
+static int client_sock = -1;
+static struct sockaddr_in server_addr;
+static struct sockaddr_in client_addr;
+
+static void send_datagram(void)
+{
+	ssize_t ret;
+
+	ret = zsock_sendto(client_sock, test_data, sizeof(test_data), 0,
+			   (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(ret, sizeof(test_data), "sendto failed (%d)", errno);
+}
+
+/* Check that the loaned iovecs hold the start of the test data */
+static size_t verify_iov(const struct msghdr *msg)
+{
+	size_t offset = 0;
+
+	for (size_t i = 0; i < msg->msg_iovlen; i++) {
+		zassert_not_null(msg->msg_iov[i].iov_base, "Empty iovec %zu", i);
+		zassert_true(offset + msg->msg_iov[i].iov_len <= sizeof(test_data),
+			     "Too much data");
+		zassert_mem_equal(msg->msg_iov[i].iov_base, &test_data[offset],
+				  msg->msg_iov[i].iov_len, "Data mismatch in iovec %zu", i);
+
+		offset += msg->msg_iov[i].iov_len;
+	}
+
+	return offset;
+}
+
+ZTEST(net_socket_rx_loan, test_loan)
+{
+	struct iovec iov[MAX_IOV] = { 0 };
+	struct zsock_rx_loan loan;
+	struct sockaddr_in addr;
+	struct msghdr msg = {
+		.msg_name = &addr,
+		.msg_namelen = sizeof(addr),
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+	ssize_t ret;
+
+	send_datagram();
+
+	ret = zsock_recvmsg_loan(server_sock, &msg, 0, &loan);
+	zassert_equal(ret, sizeof(test_data), "recvmsg_loan failed (%d)", errno);
+	zassert_true(msg.msg_iovlen > 1, "Data should span several buffers");
+	zassert_false(msg.msg_flags & ZSOCK_MSG_TRUNC, "Datagram truncated");
+	zassert_equal(verify_iov(&msg), sizeof(test_data), "Wrong length");
+
+	zassert_equal(msg.msg_namelen, sizeof(addr), "Wrong address length");
+	zassert_equal(addr.sin_family, AF_INET, "Wrong address family");
+	zassert_equal(ntohs(addr.sin_port), CLIENT_PORT, "Wrong source port");
+
+	zsock_rx_loan_release(&loan);
+	zassert_is_null(loan.pkt, "Loan not released");
+}
+
+ZTEST(net_socket_rx_loan, test_loan_trunc)
+{
+	struct iovec iov[1] = { 0 };
+	struct zsock_rx_loan loan;
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+	ssize_t ret;
+
+	send_datagram();
+
+	ret = zsock_recvmsg_loan(server_sock, &msg, 0, &loan);
+	zassert_true(ret > 0 && ret < sizeof(test_data),
+		     "Unexpected length (%d)", (int)ret);
+	zassert_equal(msg.msg_iovlen, 1, "Wrong number of iovecs");
+	zassert_true(msg.msg_flags & ZSOCK_MSG_TRUNC, "Truncation not reported");
+	zassert_equal(verify_iov(&msg), ret, "Wrong length");
+
+	zsock_rx_loan_release(&loan);
+}
+
+ZTEST(net_socket_rx_loan, test_loan_peek)
+{
+	struct iovec iov[MAX_IOV] = { 0 };
+	struct zsock_rx_loan loan;
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+	ssize_t ret;
+
+	send_datagram();
+
+	ret = zsock_recvmsg_loan(server_sock, &msg, ZSOCK_MSG_PEEK, &loan);
+	zassert_equal(ret, sizeof(test_data), "recvmsg_loan failed (%d)", errno);
+	zassert_equal(verify_iov(&msg), sizeof(test_data), "Wrong length");
+
+	/* The datagram is still queued and the loan keeps it readable */
+	ret = zsock_recv(server_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(ret, sizeof(test_data), "recv failed (%d)", errno);
+	zassert_mem_equal(rx_buf, test_data, sizeof(test_data), "Data mismatch");
+	zassert_equal(verify_iov(&msg), sizeof(test_data), "Loaned data changed");
+
+	zsock_rx_loan_release(&loan);
+}
+
+ZTEST(net_socket_rx_loan, test_loan_no_data)
+{
+	struct iovec iov[MAX_IOV] = { 0 };
+	struct zsock_rx_loan loan;
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+	ssize_t ret;
+
+	ret = zsock_recvmsg_loan(server_sock, &msg, ZSOCK_MSG_DONTWAIT, &loan);
+	zassert_equal(ret, -1, "recvmsg_loan should fail");
+	zassert_equal(errno, EAGAIN, "Unexpected errno (%d)", errno);
+	zassert_is_null(loan.pkt, "Nothing should be loaned");
+}
+
+ZTEST(net_socket_rx_loan, test_loan_stream)
+{
+	struct iovec iov[MAX_IOV] = { 0 };
+	struct zsock_rx_loan loan;
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+	ssize_t ret;
+	int sock;
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "socket open failed");
+
+	ret = zsock_recvmsg_loan(sock, &msg, ZSOCK_MSG_DONTWAIT, &loan);
+	zassert_equal(ret, -1, "recvmsg_loan should fail");
+	zassert_equal(errno, EOPNOTSUPP, "Unexpected errno (%d)", errno);
+
+	zassert_ok(zsock_close(sock));
+}
+
+ZTEST(net_socket_rx_loan, test_loan_not_native)
+{
+	struct iovec iov[MAX_IOV] = { 0 };
+	struct zsock_rx_loan loan;
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+	ssize_t ret;
+	int sv[2];
+
+	/* Garbage left in the loan must not be released */
+	memset(&loan, 0xaa, sizeof(loan));
+
+	zassert_ok(zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv), "socketpair failed");
+
+	ret = zsock_recvmsg_loan(sv[0], &msg, ZSOCK_MSG_DONTWAIT, &loan);
+	zassert_equal(ret, -1, "recvmsg_loan should fail");
+	zassert_equal(errno, EOPNOTSUPP, "Unexpected errno (%d)", errno);
+	zassert_is_null(loan.pkt, "Nothing should be loaned");
+
+	zsock_rx_loan_release(&loan);
+
+	zassert_ok(zsock_close(sv[0]));
+	zassert_ok(zsock_close(sv[1]));
+}
+
+static void *setup(void)
+{
+	for (int i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = i;
+	}
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	zassert_ok(zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			      sizeof(server_addr)), "bind failed");
+	zassert_ok(zsock_bind(client_sock, (struct sockaddr *)&client_addr,
+			      sizeof(client_addr)), "bind failed");
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)zsock_close(server_sock);
+	(void)zsock_close(client_sock);
+}
+
+ZTEST_SUITE(net_socket_rx_loan, NULL, setup, NULL, NULL, teardown);
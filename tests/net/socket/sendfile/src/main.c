@@ -0,0 +1,223 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/ztest_assert.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+#include <zephyr/storage/flash_map.h>
+
+#include <zephyr/net/socket.h>
+
+#include "../../socket_helpers.h"
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(storage);
+
+#define TEST_PARTITION    storage_partition
+#define TEST_PARTITION_ID FIXED_PARTITION_ID(TEST_PARTITION)
+
+#define LFS_MNTP  "/littlefs"
+#define TEST_FILE LFS_MNTP "/sendfile.bin"
+
+#define MY_IPV4_ADDR "127.0.0.1"
+#define SERVER_PORT  4242
+
+/* Spans several network buffers */
+#define FILE_LEN 1000
+#define WAIT_MS  100
+
+static struct fs_mount_t littlefs_mnt = {
+	.type = FS_LITTLEFS,
+	.fs_data = &storage,
+	.storage_dev = (void *)TEST_PARTITION_ID,
+	.mnt_point = LFS_MNTP,
+};
+
+static uint8_t file_data[FILE_LEN];
+static uint8_t rx_buf[FILE_LEN];
+static struct fs_file_t file;
+
+static int server_sock = -1;
+static int client_sock = -1;
+static int accepted_sock = -1;
+
+static void recv_all(int sock, uint8_t *buf, size_t len)
+{
+	size_t received = 0;
+	ssize_t ret;
+
+	while (received < len) {
+		ret = zsock_recv(sock, buf + received, len - received, 0);
+		zassert_true(ret > 0, "recv failed (%d)", errno);
+		received += ret;
+	}
+}
+
+static void expect_no_data(int sock)
+{
+	struct zsock_pollfd pfd = {
+		.fd = sock,
+		.events = ZSOCK_POLLIN,
+	};
+
+	zassert_equal(zsock_poll(&pfd, 1, WAIT_MS), 0, "Unexpected data");
+}
+
+static void open_tcp_pair(void)
+{
+	struct sockaddr_in server_addr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &client_sock, &server_addr);
+
+	zassert_ok(zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			      sizeof(server_addr)), "bind failed");
+	zassert_ok(zsock_listen(server_sock, 1), "listen failed");
+	zassert_ok(zsock_connect(client_sock, (struct sockaddr *)&server_addr,
+				 sizeof(server_addr)), "connect failed");
+
+	accepted_sock = zsock_accept(server_sock, &addr, &addrlen);
+	zassert_true(accepted_sock >= 0, "accept failed (%d)", errno);
+}
+
+ZTEST(net_socket_sendfile, test_sendfile_tcp)
+{
+	ssize_t ret;
+
+	open_tcp_pair();
+
+	ret = zsock_sendfile(client_sock, &file, NULL, FILE_LEN);
+	zassert_equal(ret, FILE_LEN, "sendfile failed (%d)", errno);
+	zassert_equal(fs_tell(&file), FILE_LEN, "File position not advanced");
+
+	recv_all(accepted_sock, rx_buf, FILE_LEN);
+	zassert_mem_equal(rx_buf, file_data, FILE_LEN, "Invalid data received");
+
+	/* Nothing more to send at the end of the file */
+	ret = zsock_sendfile(client_sock, &file, NULL, FILE_LEN);
+	zassert_equal(ret, 0, "sendfile past the end of file (%d)", ret);
+	expect_no_data(accepted_sock);
+}
+
+ZTEST(net_socket_sendfile, test_sendfile_tcp_offset)
+{
+	off_t offset = FILE_LEN / 2;
+	ssize_t ret;
+
+	open_tcp_pair();
+
+	/* Past the end of the file, only what is left gets sent */
+	ret = zsock_sendfile(client_sock, &file, &offset, FILE_LEN);
+	zassert_equal(ret, FILE_LEN / 2, "sendfile failed (%d)", errno);
+	zassert_equal(offset, FILE_LEN, "Offset not advanced");
+	zassert_equal(fs_tell(&file), 0, "File position changed");
+
+	recv_all(accepted_sock, rx_buf, FILE_LEN / 2);
+	zassert_mem_equal(rx_buf, file_data + FILE_LEN / 2, FILE_LEN / 2,
+			  "Invalid data received");
+}
+
+ZTEST(net_socket_sendfile, test_sendfile_copy)
+{
+	int sv[2];
+	ssize_t ret;
+
+	/* Socket pairs do not read the file themselves */
+	zassert_ok(zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv), "socketpair failed");
+	client_sock = sv[0];
+	accepted_sock = sv[1];
+
+	ret = zsock_sendfile(client_sock, &file, NULL, FILE_LEN / 4);
+	zassert_equal(ret, FILE_LEN / 4, "sendfile failed (%d)", errno);
+	zassert_equal(fs_tell(&file), FILE_LEN / 4, "File position not advanced");
+
+	ret = zsock_sendfile(client_sock, &file, NULL, FILE_LEN);
+	zassert_equal(ret, FILE_LEN - FILE_LEN / 4, "sendfile failed (%d)", errno);
+
+	recv_all(accepted_sock, rx_buf, FILE_LEN);
+	zassert_mem_equal(rx_buf, file_data, FILE_LEN, "Invalid data received");
+}
+
+ZTEST(net_socket_sendfile, test_sendfile_invalid)
+{
+	zassert_equal(zsock_sendfile(-1, &file, NULL, FILE_LEN), -1);
+	zassert_equal(errno, EBADF, "Unexpected errno (%d)", errno);
+
+	open_tcp_pair();
+
+	zassert_equal(zsock_sendfile(client_sock, NULL, NULL, FILE_LEN), -1);
+	zassert_equal(errno, EINVAL, "Unexpected errno (%d)", errno);
+}
+
+static void *setup(void)
+{
+	const struct flash_area *fap;
+	ssize_t ret;
+
+	for (int i = 0; i < FILE_LEN; i++) {
+		file_data[i] = (uint8_t)(i * 7);
+	}
+
+	zassert_ok(flash_area_open(TEST_PARTITION_ID, &fap), "Opening flash area failed");
+	zassert_ok(flash_area_flatten(fap, 0, fap->fa_size), "Erasing flash area failed");
+	zassert_ok(fs_mount(&littlefs_mnt), "Mounting fs failed");
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, TEST_FILE, FS_O_CREATE | FS_O_RDWR), "fs_open failed");
+	ret = fs_write(&file, file_data, sizeof(file_data));
+	zassert_equal(ret, sizeof(file_data), "fs_write failed (%d)", ret);
+	zassert_ok(fs_close(&file), "fs_close failed");
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(rx_buf, 0, sizeof(rx_buf));
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, TEST_FILE, FS_O_READ), "fs_open failed");
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)fs_close(&file);
+
+	if (accepted_sock >= 0) {
+		(void)zsock_close(accepted_sock);
+		accepted_sock = -1;
+	}
+
+	if (client_sock >= 0) {
+		(void)zsock_close(client_sock);
+		client_sock = -1;
+	}
+
+	if (server_sock >= 0) {
+		(void)zsock_close(server_sock);
+		server_sock = -1;
+	}
+
+	/* Let the connections go away before the port is reused */
+	k_msleep(WAIT_MS);
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)fs_unmount(&littlefs_mnt);
+}
+
+ZTEST_SUITE(net_socket_sendfile, NULL, setup, before, after, teardown);
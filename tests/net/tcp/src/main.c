@@ -31,6 +31,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include "ipv4.h"
 #include "ipv6.h"
 #include "tcp.h"
+#include "tcp_internal.h"
 #include "tcp_private.h"
 #include "net_stats.h"
 
@@ -116,6 +117,8 @@ static enum test_case_no {
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
 	TEST_CLIENT_SEQ_VALIDATION = 19,
 	TEST_SERVER_ACK_VALIDATION = 20,
+	TEST_CLIENT_SACK_IPV4 = 21,
+	TEST_CLIENT_CONGESTION = 22,
 } test_case_no;
 
 static enum test_state t_state;
@@ -123,6 +126,8 @@ static enum test_state t_state;
 static struct k_work_delayable test_server;
 static void test_server_timeout(struct k_work *work);
 
+static struct k_work_delayable cc_link_work;
+
 static int tester_send(const struct device *dev, struct net_pkt *pkt);
 
 static void handle_client_test(sa_family_t af, struct tcphdr *th);
@@ -142,6 +147,9 @@ static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_seq_validation_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_ack_validation_test(struct net_pkt *pkt);
+static void handle_client_sack_test(struct net_pkt *pkt);
+static void handle_client_congestion_test(struct net_pkt *pkt);
+static void cc_link_deliver(struct k_work *work);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -239,6 +247,25 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Options added to non-SYN segments, used to send SACK blocks */
+static uint8_t tcp_ack_options[4 + 2 * 8];
+static size_t tcp_ack_options_len;
+
+/* MSS of the congestion control tests, small so that a window holds
+ * many segments
+ */
+#define CC_MSS 64
+
+static const uint8_t cc_syn_options[] = {
+	0x02, 0x04, 0x00, CC_MSS, /* Max segment */
+};
+
+static bool syn_has_options(uint8_t flags)
+{
+	return (test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4 ||
+		test_case_no == TEST_CLIENT_SACK_IPV4) && (flags & SYN);
+}
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -249,11 +276,18 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
+	const uint8_t *opts = tcp_ack_options;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (syn_has_options(flags)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if (test_case_no == TEST_CLIENT_CONGESTION && (flags & SYN)) {
+		opts = cc_syn_options;
+		opts_len = sizeof(cc_syn_options);
+	} else if (!(flags & SYN)) {
+		opts_len = tcp_ack_options_len;
 	}
 
 	/* Allocate buffer */
@@ -288,11 +322,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
 	th->th_win = htons(NET_IPV6_MTU);
@@ -307,9 +337,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len > 0) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -494,6 +524,12 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_SERVER_ACK_VALIDATION:
 		handle_server_ack_validation_test(pkt);
 		break;
+	case TEST_CLIENT_SACK_IPV4:
+		handle_client_sack_test(pkt);
+		break;
+	case TEST_CLIENT_CONGESTION:
+		handle_client_congestion_test(pkt);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -528,6 +564,7 @@ static void *presetup(void)
 	}
 
 	k_work_init_delayable(&test_server, test_server_timeout);
+	k_work_init_delayable(&cc_link_work, cc_link_deliver);
 	return NULL;
 }
 
@@ -3002,4 +3039,1007 @@ ZTEST(net_tcp, test_server_ack_validation)
 	net_context_put(accepted_ctx);
 }
 
+#define SACK_SEGMENTS 7
+
+static uint32_t sack_data_seq;
+static uint16_t sack_mss;
+static uint8_t sack_tx_count[SACK_SEGMENTS];
+
+static uint32_t sack_seg_start(int idx)
+{
+	return sack_data_seq + idx * sack_mss;
+}
+
+/* Blocks are given as segment index ranges, [first, last) */
+static void sack_set_blocks(int num_blocks, const int (*blocks)[2])
+{
+	uint8_t *p = tcp_ack_options;
+
+	if (num_blocks == 0) {
+		tcp_ack_options_len = 0;
+		return;
+	}
+
+	*p++ = NET_TCP_NOP_OPT;
+	*p++ = NET_TCP_NOP_OPT;
+	*p++ = NET_TCP_SACK_OPT;
+	*p++ = 2 + num_blocks * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (int i = 0; i < num_blocks; i++) {
+		sys_put_be32(sack_seg_start(blocks[i][0]), p);
+		sys_put_be32(sack_seg_start(blocks[i][1]), p + 4);
+		p += NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	tcp_ack_options_len = p - tcp_ack_options;
+}
+
+static void sack_reply_ack(int ack_idx, int num_blocks, const int (*blocks)[2])
+{
+	struct net_pkt *reply;
+	int ret;
+
+	ack = sack_seg_start(ack_idx);
+	sack_set_blocks(num_blocks, blocks);
+
+	reply = prepare_ack_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	tcp_ack_options_len = 0;
+	zassert_not_null(reply, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, reply);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+}
+
+/* Segments 1 and 3 are lost. The peer reports the others in SACK blocks
+ * and expects exactly the two missing segments to be retransmitted.
+ */
+static void sack_handle_data(struct tcphdr *th, size_t len)
+{
+	static const int sack_2[][2] = { { 2, 3 } };
+	static const int sack_4[][2] = { { 4, 5 }, { 2, 3 } };
+	static const int sack_5[][2] = { { 4, 6 }, { 2, 3 } };
+	static const int sack_6[][2] = { { 4, 7 }, { 2, 3 } };
+	static const int sack_done[][2] = { { 4, 7 } };
+	uint32_t offset = ntohl(th->th_seq) - sack_data_seq;
+	int idx = offset / sack_mss;
+
+	zassert_equal(offset % sack_mss, 0, "Unexpected segment start %u", offset);
+	zassert_true(idx < SACK_SEGMENTS, "Unexpected segment %d", idx);
+	zassert_equal(len, sack_mss, "Unexpected segment length %zu", len);
+
+	sack_tx_count[idx]++;
+
+	if (sack_tx_count[idx] == 1) {
+		switch (idx) {
+		case 0:
+			sack_reply_ack(1, 0, NULL);
+			break;
+		case 2:
+			sack_reply_ack(1, ARRAY_SIZE(sack_2), sack_2);
+			break;
+		case 4:
+			sack_reply_ack(1, ARRAY_SIZE(sack_4), sack_4);
+			break;
+		case 5:
+			sack_reply_ack(1, ARRAY_SIZE(sack_5), sack_5);
+			break;
+		case 6:
+			sack_reply_ack(1, ARRAY_SIZE(sack_6), sack_6);
+			break;
+		default:
+			/* Dropped */
+			break;
+		}
+
+		return;
+	}
+
+	zassert_equal(sack_tx_count[idx], 2, "Segment %d sent %d times", idx,
+		      sack_tx_count[idx]);
+
+	if (idx == 1) {
+		sack_reply_ack(3, ARRAY_SIZE(sack_done), sack_done);
+	} else if (idx == 3) {
+		sack_reply_ack(SACK_SEGMENTS, 0, NULL);
+		t_state = T_DATA_ACK;
+		test_sem_give();
+	} else {
+		zassert_true(false, "Segment %d was not lost", idx);
+	}
+}
+
+/* Check the SACK block of a duplicate ACK sent for out-of-order data */
+static void sack_handle_dup_ack(struct net_pkt *pkt, struct tcphdr *th)
+{
+	uint8_t opts[40];
+	size_t opts_len = th->th_off * 4U - sizeof(struct tcphdr);
+	int ret;
+
+	zassert_equal(ntohl(th->th_ack), seq, "Unexpected ACK %u", ntohl(th->th_ack));
+	zassert_equal(opts_len, 12, "Expected a single SACK block (%zu)", opts_len);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			   sizeof(struct tcphdr));
+	zassert_ok(ret, "Cannot skip headers");
+	ret = net_pkt_read(pkt, opts, opts_len);
+	zassert_ok(ret, "Cannot read options");
+
+	zassert_equal(opts[2], NET_TCP_SACK_OPT, "Not a SACK option");
+	zassert_equal(opts[3], 10, "Invalid SACK option length");
+	zassert_equal(sys_get_be32(&opts[4]), seq + 10, "Invalid SACK left edge");
+	zassert_equal(sys_get_be32(&opts[8]), seq + 20, "Invalid SACK right edge");
+
+	t_state = T_CLOSING;
+	test_sem_give();
+}
+
+static void handle_client_sack_test(struct net_pkt *pkt)
+{
+	struct net_pkt *reply;
+	struct tcphdr th;
+	size_t len;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	zassert_ok(ret, "Cannot read TCP header");
+
+	len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+	      net_pkt_ip_opts_len(pkt) - th.th_off * 4U;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(&th, SYN);
+		/* MSS and SACK permitted options, 4 bytes each */
+		zassert_equal(th.th_off, 7 + IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE),
+			      "SYN does not carry MSS and SACK permitted");
+		seq = 0U;
+		ack = ntohl(th.th_seq) + 1U;
+		sack_data_seq = ack;
+		t_state = T_SYN_ACK;
+
+		reply = prepare_syn_ack_packet(AF_INET, htons(MY_PORT), th.th_sport);
+		zassert_not_null(reply, "Cannot create pkt");
+
+		ret = net_recv_data(net_iface, reply);
+		zassert_ok(ret, "recv data failed (%d)", ret);
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(&th, ACK);
+		seq = 1U;
+		t_state = T_DATA;
+		test_sem_give();
+		break;
+	case T_DATA:
+		if (len > 0) {
+			sack_handle_data(&th, len);
+		}
+		break;
+	case T_DATA_ACK:
+		zassert_equal(len, 0, "Unexpected data after recovery");
+		sack_handle_dup_ack(pkt, &th);
+		break;
+	default:
+		/* Connection is being torn down */
+		break;
+	}
+}
+
+/* Test case scenario IPv4
+ *   expect SYN with SACK permitted, send SYN ACK with SACK permitted,
+ *   expect 7 data segments, drop the second and the fourth one and send
+ *   duplicate ACKs with SACK blocks for the others,
+ *   expect only the two dropped segments to be retransmitted,
+ *   send out-of-order data,
+ *   expect a duplicate ACK with a SACK block covering it.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_client_sack_ipv4)
+{
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	int ret;
+
+	/* The whole window must be sent at once, and out-of-order data queued */
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) ||
+	    IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE) ||
+	    CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+	memset(sack_tx_count, 0, sizeof(sack_tx_count));
+
+	t_state = T_SYN;
+	test_case_no = TEST_CLIENT_SACK_IPV4;
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_ok(ret, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in), NULL, K_MSEC(100), NULL);
+	zassert_ok(ret, "Failed to connect to peer");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	sack_mss = conn_mss(ctx->tcp);
+
+	ret = net_context_send(ctx, lorem_ipsum, SACK_SEGMENTS * sack_mss, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_true(ret >= 0, "Failed to send data to peer (%d)", ret);
+
+	/* Released once both lost segments have been retransmitted */
+	test_sem_take(K_MSEC(CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT / 2), __LINE__);
+
+	/* Nothing else may be retransmitted */
+	k_msleep(CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT * 2);
+	zassert_equal(ctx->tcp->send_data_total, 0, "Data left unacknowledged");
+
+	/* Leave a 10 byte hole in the data sent to the device */
+	seq += 10;
+	pkt = prepare_data_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT), lorem_ipsum, 10);
+	seq -= 10;
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	pkt = prepare_rst_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+}
+
+static void check_congestion_option(struct net_context *ctx, const char *expected)
+{
+	char name[16];
+	size_t len = sizeof(name);
+	int ret;
+
+	ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION, name, &len);
+	zassert_ok(ret, "Cannot get congestion control (%d)", ret);
+	zassert_equal(len, strlen(expected) + 1, "Invalid length %zu", len);
+	zassert_str_equal(name, expected, "Unexpected algorithm %s", name);
+}
+
+ZTEST(net_tcp, test_congestion_control_option)
+{
+	const char *default_name = "reno";
+	struct net_context *ctx;
+	char name[16];
+	size_t len;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+		ztest_test_skip();
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)) {
+		default_name = "cubic";
+	} else if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_DEFAULT_BBR)) {
+		default_name = "bbr";
+	}
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_ok(ret, "Failed to get net_context");
+
+	check_congestion_option(ctx, default_name);
+
+	ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION, "vegas", strlen("vegas"));
+	zassert_equal(ret, -ENOENT, "Unknown algorithm accepted (%d)", ret);
+	check_congestion_option(ctx, default_name);
+
+	/* The name does not need to be NUL terminated */
+	ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION, "reno", strlen("reno"));
+	zassert_ok(ret, "Cannot select reno (%d)", ret);
+	check_congestion_option(ctx, "reno");
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC)) {
+		ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION, "cubic", sizeof("cubic"));
+		zassert_ok(ret, "Cannot select cubic (%d)", ret);
+		check_congestion_option(ctx, "cubic");
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_BBR)) {
+		ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION, "bbr", sizeof("bbr"));
+		zassert_ok(ret, "Cannot select bbr (%d)", ret);
+		check_congestion_option(ctx, "bbr");
+	}
+
+	/* A short buffer gets a truncated name */
+	len = 2;
+	ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION, name, &len);
+	zassert_ok(ret, "Cannot get congestion control (%d)", ret);
+	zassert_equal(len, 2, "Invalid length %zu", len);
+
+	net_context_put(ctx);
+}
+
+/* Congestion control tests. The tester is the peer of a client
+ * connection, it records the data segments and acknowledges them, either
+ * from the test itself or through an emulated bottleneck link.
+ */
+#define CC_LINK_QUEUE_LEN 32
+#define CC_PACED_SEGMENTS 6
+
+static uint32_t cc_data_seq;
+static struct k_spinlock cc_lock;
+
+/* End of the data sent so far, relative to cc_data_seq */
+static uint32_t cc_sent_end;
+static int cc_sent_cnt;
+static int cc_resent_cnt;
+static int64_t cc_sent_us[CC_PACED_SEGMENTS];
+
+/* Bottleneck link, enabled when cc_link_ms_per_seg is not 0 */
+static uint32_t cc_link_ms_per_seg;
+static uint32_t cc_link_delay_ms;
+static int64_t cc_link_last_dep;
+static struct {
+	uint32_t end;
+	int64_t due;
+} cc_link[CC_LINK_QUEUE_LEN];
+static int cc_link_head;
+static int cc_link_cnt;
+
+static void cc_send_ack(uint32_t end)
+{
+	struct net_pkt *reply;
+	int ret;
+
+	ack = cc_data_seq + end;
+
+	reply = prepare_ack_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(reply, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, reply);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+static struct net_context *cc_ctx;
+
+/* BBR modes in the order they were entered */
+static uint8_t cc_modes[8];
+static int cc_modes_cnt;
+
+static void cc_note_mode(void)
+{
+	uint8_t mode = cc_ctx->tcp->ca.bbr.mode;
+	k_spinlock_key_t key = k_spin_lock(&cc_lock);
+
+	if ((cc_modes_cnt == 0 || cc_modes[cc_modes_cnt - 1] != mode) &&
+	    cc_modes_cnt < ARRAY_SIZE(cc_modes)) {
+		cc_modes[cc_modes_cnt++] = mode;
+	}
+
+	k_spin_unlock(&cc_lock, key);
+}
+#else
+#define cc_note_mode()
+#endif
+
+/* Segments leave the link one every cc_link_ms_per_seg and are acked
+ * cc_link_delay_ms later. Called with cc_lock held.
+ */
+static bool cc_link_enqueue(uint32_t end)
+{
+	int64_t now = k_uptime_get();
+	int64_t dep = MAX(now, cc_link_last_dep) + cc_link_ms_per_seg;
+	int idx;
+
+	if (cc_link_cnt == CC_LINK_QUEUE_LEN) {
+		return false;
+	}
+
+	idx = (cc_link_head + cc_link_cnt) % CC_LINK_QUEUE_LEN;
+	cc_link[idx].end = end;
+	cc_link[idx].due = dep + cc_link_delay_ms;
+	cc_link_last_dep = dep;
+
+	if (cc_link_cnt++ == 0) {
+		k_work_schedule(&cc_link_work, K_MSEC(cc_link[idx].due - now));
+	}
+
+	return true;
+}
+
+static void cc_link_deliver(struct k_work *work)
+{
+	int64_t now = k_uptime_get();
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		k_spinlock_key_t key = k_spin_lock(&cc_lock);
+		uint32_t end;
+
+		if (cc_link_cnt == 0) {
+			k_spin_unlock(&cc_lock, key);
+			break;
+		}
+
+		if (cc_link[cc_link_head].due > now) {
+			k_work_schedule(&cc_link_work, K_MSEC(cc_link[cc_link_head].due - now));
+			k_spin_unlock(&cc_lock, key);
+			break;
+		}
+
+		end = cc_link[cc_link_head].end;
+		cc_link_head = (cc_link_head + 1) % CC_LINK_QUEUE_LEN;
+		cc_link_cnt--;
+		k_spin_unlock(&cc_lock, key);
+
+		cc_send_ack(end);
+	}
+}
+
+static void cc_handle_data(struct tcphdr *th, size_t len)
+{
+	uint32_t end = ntohl(th->th_seq) - cc_data_seq + len;
+	int64_t now_us = k_ticks_to_us_floor64(k_uptime_ticks());
+	k_spinlock_key_t key;
+	bool queued = true;
+	bool link;
+
+	key = k_spin_lock(&cc_lock);
+
+	link = cc_link_ms_per_seg > 0;
+
+	if (end <= cc_sent_end) {
+		cc_resent_cnt++;
+	} else {
+		if (cc_sent_cnt < ARRAY_SIZE(cc_sent_us)) {
+			cc_sent_us[cc_sent_cnt] = now_us;
+		}
+
+		cc_sent_cnt++;
+		cc_sent_end = end;
+
+		if (link) {
+			queued = cc_link_enqueue(end);
+		}
+	}
+
+	k_spin_unlock(&cc_lock, key);
+
+	zassert_true(queued, "Link queue full");
+
+	if (link) {
+		cc_note_mode();
+	}
+}
+
+static void handle_client_congestion_test(struct net_pkt *pkt)
+{
+	struct net_pkt *reply;
+	struct tcphdr th;
+	size_t len;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	zassert_ok(ret, "Cannot read TCP header");
+
+	len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+	      net_pkt_ip_opts_len(pkt) - th.th_off * 4U;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(&th, SYN);
+		seq = 0U;
+		ack = ntohl(th.th_seq) + 1U;
+		cc_data_seq = ack;
+		t_state = T_SYN_ACK;
+
+		reply = prepare_syn_ack_packet(AF_INET, htons(MY_PORT), th.th_sport);
+		zassert_not_null(reply, "Cannot create pkt");
+
+		ret = net_recv_data(net_iface, reply);
+		zassert_ok(ret, "recv data failed (%d)", ret);
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(&th, ACK);
+		seq = 1U;
+		t_state = T_DATA;
+		test_sem_give();
+		break;
+	case T_DATA:
+		if (len > 0) {
+			cc_handle_data(&th, len);
+		}
+		break;
+	default:
+		/* Connection is being torn down */
+		break;
+	}
+}
+
+#if defined(CONFIG_NET_TCP_PACING) || \
+	(defined(CONFIG_NET_TCP_CONGESTION_CUBIC) && defined(CONFIG_NET_TCP_FAST_RETRANSMIT))
+static struct net_context *cc_connect(const char *algo)
+{
+	struct net_context *ctx;
+	int ret;
+
+	k_sem_reset(&test_sem);
+
+	cc_sent_end = 0;
+	cc_sent_cnt = 0;
+	cc_resent_cnt = 0;
+	cc_link_ms_per_seg = 0;
+	cc_link_last_dep = 0;
+	cc_link_head = 0;
+	cc_link_cnt = 0;
+
+	t_state = T_SYN;
+	test_case_no = TEST_CLIENT_CONGESTION;
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_ok(ret, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+	cc_ctx = ctx;
+	cc_modes_cnt = 0;
+#endif
+
+	ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION, algo, strlen(algo));
+	zassert_ok(ret, "Cannot select %s (%d)", algo, ret);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in), NULL, K_MSEC(100), NULL);
+	zassert_ok(ret, "Failed to connect to peer");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(conn_mss(ctx->tcp), CC_MSS, "MSS option not used");
+
+	return ctx;
+}
+
+static void cc_close(struct net_context *ctx)
+{
+	struct k_work_sync sync;
+	k_spinlock_key_t key;
+	struct net_pkt *pkt;
+	int ret;
+
+	key = k_spin_lock(&cc_lock);
+	cc_link_ms_per_seg = 0;
+	cc_link_cnt = 0;
+	k_spin_unlock(&cc_lock, key);
+
+	(void)k_work_cancel_delayable_sync(&cc_link_work, &sync);
+
+	t_state = T_CLOSING;
+
+	pkt = prepare_rst_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+}
+
+static void cc_queue(struct net_context *ctx, size_t len)
+{
+	int ret;
+
+	ret = net_context_send(ctx, lorem_ipsum, len, NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, len, "Failed to queue data (%d)", ret);
+}
+
+/* Wait until the data up to end has been sent */
+static void cc_wait_sent(uint32_t end, int line)
+{
+	for (int i = 0; i < 100 && cc_sent_end < end; i++) {
+		k_msleep(10);
+	}
+
+	zassert_true(cc_sent_end >= end, "Only %u bytes sent (line %d)", cc_sent_end, line);
+}
+
+static void cc_wait_acked(struct tcp *conn, uint32_t end, int line)
+{
+	for (int i = 0; i < 1000 && conn->seq != cc_data_seq + end; i++) {
+		k_msleep(1);
+	}
+
+	zassert_equal(conn->seq, cc_data_seq + end, "Ack %u not processed (line %d)", end, line);
+}
+
+/* Send the whole segments that fit in the window and wait until they are
+ * acknowledged, one by one by the link if there is one, or else from here.
+ */
+static void cc_send_window(struct net_context *ctx)
+{
+	struct tcp *conn = ctx->tcp;
+	uint32_t start = conn->seq - cc_data_seq;
+	int segs = conn->ca.cwnd / CC_MSS;
+
+	cc_queue(ctx, segs * CC_MSS);
+	cc_wait_sent(start + segs * CC_MSS, __LINE__);
+
+	if (cc_link_ms_per_seg == 0) {
+		for (int i = 1; i <= segs; i++) {
+			cc_send_ack(start + i * CC_MSS);
+		}
+	}
+
+	cc_wait_acked(conn, start + segs * CC_MSS, __LINE__);
+}
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC) && defined(CONFIG_NET_TCP_FAST_RETRANSMIT)
+/* Acknowledge the data up to end and wait until it is processed */
+static void cc_ack(struct tcp *conn, uint32_t end)
+{
+	cc_send_ack(end);
+	cc_wait_acked(conn, end, __LINE__);
+}
+
+/* Window after acked bytes are acknowledged t ms into the epoch, RFC 9438:
+ * the target is W_cubic(t + RTT) = C * (t + RTT - K)^3 + W_max with C in
+ * 1/1000 segments/s^3, bounded to [cwnd, 1.5 * cwnd], and cwnd grows by
+ * (target - cwnd) / cwnd per acked byte.
+ */
+static uint32_t cc_cubic_expected(struct tcp *conn, uint32_t cwnd, uint32_t acked, int64_t t)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	int64_t d = t + conn->ca.srtt_ms - cubic->k_ms;
+	int64_t target;
+
+	target = cubic->w_max +
+		 d * d * d * CONFIG_NET_TCP_CONGESTION_CUBIC_C * CC_MSS / 1000000000000LL;
+	target = CLAMP(target, (int64_t)cwnd, (int64_t)cwnd * 3 / 2);
+
+	return cwnd + (target - cwnd) * acked / cwnd;
+}
+
+/* Send segs segments and check the window after each of their acks */
+static void cc_cubic_probe(struct net_context *ctx, int segs)
+{
+	struct tcp *conn = ctx->tcp;
+	uint32_t start = conn->seq - cc_data_seq;
+
+	cc_queue(ctx, segs * CC_MSS);
+
+	for (int i = 1; i <= segs; i++) {
+		uint32_t cwnd;
+		int64_t t_lo, t_hi;
+		uint32_t lo, hi;
+
+		/* The window may not hold all of them yet */
+		cc_wait_sent(start + i * CC_MSS, __LINE__);
+		cwnd = conn->ca.cwnd;
+
+		t_lo = k_uptime_get_32() - conn->ca.cubic.epoch_start;
+		cc_ack(conn, start + i * CC_MSS);
+		t_hi = k_uptime_get_32() - conn->ca.cubic.epoch_start;
+
+		/* A few bytes of slack for the rounding of the fixed point math */
+		lo = cc_cubic_expected(conn, cwnd, CC_MSS, t_lo) - 2;
+		hi = cc_cubic_expected(conn, cwnd, CC_MSS, t_hi) + 2;
+
+		zassert_between_inclusive(conn->ca.cwnd, lo, hi,
+					  "cwnd %u not on the cubic curve [%u, %u] at %lld ms",
+					  conn->ca.cwnd, lo, hi, (long long)t_lo);
+	}
+}
+
+static void cc_sleep_until(struct tcp *conn, uint32_t t)
+{
+	uint32_t elapsed = k_uptime_get_32() - conn->ca.cubic.epoch_start;
+
+	if (elapsed < t) {
+		k_msleep(t - elapsed);
+	}
+}
+#endif
+
+/* Test case scenario IPv4
+ *   grow the window to four segments with acks,
+ *   lose the first of four segments, detected by three duplicate ACKs,
+ *   expect ssthresh to be 0.7 times the data in flight and W_max the
+ *   window before the loss,
+ *   expect the window to grow in congestion avoidance along the cubic
+ *   function: below W_max before K, concave, and above it after K.
+ *   The testcase raises C, which brings K down to about 150 ms.
+ */
+ZTEST(net_tcp, test_congestion_cubic)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC) && defined(CONFIG_NET_TCP_FAST_RETRANSMIT)
+	struct net_context *ctx;
+	struct tcp_ca_cubic *cubic;
+	struct tcp *conn;
+	uint32_t w_max;
+	uint32_t start;
+	uint64_t diff;
+	uint64_t k;
+
+	ctx = cc_connect("cubic");
+	conn = ctx->tcp;
+	cubic = &conn->ca.cubic;
+
+	/* Slow start up to the initial ssthresh, then congestion avoidance */
+	for (int i = 0; i < 20 && conn->ca.cwnd < 4 * CC_MSS; i++) {
+		cc_send_window(ctx);
+	}
+
+	w_max = conn->ca.cwnd;
+	zassert_true(w_max >= 4 * CC_MSS, "Window did not grow (%u)", w_max);
+
+	start = conn->seq - cc_data_seq;
+	cc_queue(ctx, 4 * CC_MSS);
+	cc_wait_sent(start + 4 * CC_MSS, __LINE__);
+
+	/* The first segment is lost, the peer acks each of the others */
+	for (int i = 0; i < 3; i++) {
+		cc_send_ack(start);
+	}
+
+	for (int i = 0; i < 100 && cc_resent_cnt == 0; i++) {
+		k_msleep(1);
+	}
+
+	zassert_equal(cc_resent_cnt, 1, "No fast retransmission");
+	zassert_equal(conn->ca.ssthresh, 4 * CC_MSS * 7 / 10, "Reduction is not beta 0.7 (%u)",
+		      conn->ca.ssthresh);
+	zassert_equal(cubic->w_max, w_max, "Invalid W_max %u", cubic->w_max);
+	zassert_equal(conn->ca.cwnd, conn->ca.ssthresh + 3 * CC_MSS,
+		      "Invalid cwnd %u in fast recovery", conn->ca.cwnd);
+
+	/* The retransmission fills the hole, recovery ends at ssthresh */
+	cc_ack(conn, start + 4 * CC_MSS);
+	zassert_equal(conn->ca.cwnd, conn->ca.ssthresh, "Invalid cwnd %u after recovery",
+		      conn->ca.cwnd);
+
+	/* The first ack in congestion avoidance starts the epoch */
+	cc_queue(ctx, CC_MSS);
+	cc_wait_sent(start + 5 * CC_MSS, __LINE__);
+	cc_ack(conn, start + 5 * CC_MSS);
+
+	zassert_not_equal(cubic->epoch_start, 0, "No congestion avoidance epoch");
+	zassert_equal(cubic->origin, w_max, "Curve does not plateau at W_max");
+
+	/* K = cbrt((W_max - cwnd) / C) */
+	diff = w_max - conn->ca.ssthresh;
+	k = cubic->k_ms;
+	zassert_true(CONFIG_NET_TCP_CONGESTION_CUBIC_C * k * k * k * CC_MSS <=
+		     diff * 1000000000000ULL &&
+		     diff * 1000000000000ULL <
+		     CONFIG_NET_TCP_CONGESTION_CUBIC_C * (k + 1) * (k + 1) * (k + 1) * CC_MSS,
+		     "Invalid K %u ms", cubic->k_ms);
+
+	/* Concave region, the window approaches W_max */
+	cc_sleep_until(conn, cubic->k_ms / 2);
+	cc_cubic_probe(ctx, 1);
+	zassert_true(conn->ca.cwnd < w_max, "cwnd %u above W_max before K", conn->ca.cwnd);
+
+	cc_sleep_until(conn, cubic->k_ms);
+	cc_cubic_probe(ctx, 1);
+	zassert_true(conn->ca.cwnd < w_max, "cwnd %u above W_max at K", conn->ca.cwnd);
+
+	/* Convex region, probing for more bandwidth */
+	cc_sleep_until(conn, cubic->k_ms * 2);
+	cc_cubic_probe(ctx, 4);
+	zassert_true(conn->ca.cwnd > w_max, "cwnd %u not above W_max after K", conn->ca.cwnd);
+
+	zassert_equal(cc_resent_cnt, 1, "Unexpected retransmission");
+
+	cc_close(ctx);
+#else
+	ztest_test_skip();
+#endif
+}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR) && defined(CONFIG_NET_TCP_PACING)
+/* Upper bound of a round trip through the link and its queue */
+#define CC_BBR_ROUND_MAX_MS 500
+
+/* Keep the send queue full for the given number of round trips, or until
+ * BBR enters mode
+ */
+static void cc_bbr_run(struct net_context *ctx, uint32_t rounds, int mode)
+{
+	struct tcp_ca_bbr *bbr = &ctx->tcp->ca.bbr;
+	uint32_t end = bbr->round_cnt + rounds;
+	int64_t timeout = k_uptime_get() + rounds * CC_BBR_ROUND_MAX_MS;
+
+	while ((int32_t)(bbr->round_cnt - end) < 0) {
+		zassert_true(k_uptime_get() < timeout, "Round trips take too long (%u left)",
+			     end - bbr->round_cnt);
+
+		/* Whole segments only, the link counts segments */
+		while (net_context_send(ctx, lorem_ipsum, CC_MSS, NULL, K_NO_WAIT, NULL) > 0) {
+		}
+
+		cc_note_mode();
+		if (bbr->mode == mode) {
+			break;
+		}
+
+		k_msleep(1);
+	}
+}
+
+/* Check the model against a link of link_bw bytes per second, returns cwnd */
+static uint32_t cc_bbr_check(struct tcp *conn, uint32_t link_bw)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t max_bw = 0;
+	uint32_t target;
+	uint32_t cwnd;
+	uint64_t bdp;
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	ARRAY_FOR_EACH(bbr->bw, i) {
+		max_bw = MAX(max_bw, bbr->bw[i]);
+	}
+
+	/* cwnd_gain of 2, at least 4 segments */
+	bdp = (uint64_t)max_bw * bbr->min_rtt_ms / MSEC_PER_SEC;
+	target = MAX(2 * bdp, 4 * CC_MSS);
+	cwnd = conn->ca.cwnd;
+
+	k_mutex_unlock(&conn->lock);
+
+	zassert_within(max_bw, link_bw, link_bw / 4, "Bandwidth %u, link %u", max_bw, link_bw);
+	/* The window may still be growing by one segment per ack */
+	zassert_between_inclusive(cwnd, target - 2 * CC_MSS, target,
+				  "cwnd %u does not follow the model (%u)", cwnd, target);
+
+	return cwnd;
+}
+#endif
+
+/* Test case scenario IPv4
+ *   send through a link of 12.8 kB/s with a round trip time of 25 ms,
+ *   expect BBR to go from STARTUP to DRAIN to PROBE_BW and to measure
+ *   the link bandwidth and RTT,
+ *   halve the link bandwidth,
+ *   expect the bandwidth estimate and the window to follow once the old
+ *   maximum leaves the filter.
+ */
+ZTEST(net_tcp, test_congestion_bbr)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR) && defined(CONFIG_NET_TCP_PACING)
+	const uint32_t ms_per_seg = 5;
+	const uint32_t delay_ms = 20;
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t cwnd_fast;
+	uint32_t cwnd_slow;
+	k_spinlock_key_t key;
+
+	ctx = cc_connect("bbr");
+	conn = ctx->tcp;
+
+	key = k_spin_lock(&cc_lock);
+	cc_link_ms_per_seg = ms_per_seg;
+	cc_link_delay_ms = delay_ms;
+	k_spin_unlock(&cc_lock, key);
+
+	/* Fill the pipe, then drain the queue built up meanwhile */
+	cc_bbr_run(ctx, 30, TCP_BBR_PROBE_BW);
+	zassert_equal(conn->ca.bbr.mode, TCP_BBR_PROBE_BW, "PROBE_BW not reached");
+
+	/* Let the window settle */
+	cc_bbr_run(ctx, 4, -1);
+
+	zassert_between_inclusive(conn->ca.bbr.min_rtt_ms, ms_per_seg + delay_ms,
+				  ms_per_seg + delay_ms + 10, "Invalid min RTT %u",
+				  conn->ca.bbr.min_rtt_ms);
+	cwnd_fast = cc_bbr_check(conn, CC_MSS * MSEC_PER_SEC / ms_per_seg);
+
+	key = k_spin_lock(&cc_lock);
+	cc_link_ms_per_seg = 2 * ms_per_seg;
+	k_spin_unlock(&cc_lock, key);
+
+	/* The filter holds the old maximum for TCP_BBR_BW_FILTER_LEN rounds */
+	cc_bbr_run(ctx, TCP_BBR_BW_FILTER_LEN + 2, -1);
+
+	cwnd_slow = cc_bbr_check(conn, CC_MSS * MSEC_PER_SEC / (2 * ms_per_seg));
+	zassert_true(cwnd_slow < cwnd_fast, "cwnd did not shrink (%u)", cwnd_slow);
+
+	zassert_equal(cc_modes_cnt, 3, "Unexpected mode changes (%d)", cc_modes_cnt);
+	zassert_equal(cc_modes[0], TCP_BBR_STARTUP, "Not started in STARTUP");
+	zassert_equal(cc_modes[1], TCP_BBR_DRAIN, "STARTUP not followed by DRAIN");
+	zassert_equal(cc_modes[2], TCP_BBR_PROBE_BW, "DRAIN not followed by PROBE_BW");
+
+	zassert_equal(cc_resent_cnt, 0, "Unexpected retransmission");
+
+	cc_close(ctx);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/* Test case scenario IPv4
+ *   send through a link with a round trip time of 50 ms until the window
+ *   holds six segments in congestion avoidance,
+ *   queue a window of data,
+ *   expect the segments to be spaced to send 1.2 windows per RTT
+ *   instead of all at once.
+ */
+ZTEST(net_tcp, test_congestion_pacing)
+{
+#if defined(CONFIG_NET_TCP_PACING)
+	const uint32_t rtt_ms = 50;
+	struct net_context *ctx;
+	struct tcp *conn;
+	k_spinlock_key_t key;
+	uint32_t start;
+	int64_t gap_us;
+	int64_t span_us;
+	uint64_t rate;
+
+	ctx = cc_connect("reno");
+	conn = ctx->tcp;
+
+	key = k_spin_lock(&cc_lock);
+	cc_link_ms_per_seg = 1;
+	cc_link_delay_ms = rtt_ms - 1;
+	k_spin_unlock(&cc_lock, key);
+
+	for (int i = 0; i < 20 && conn->ca.cwnd < CC_PACED_SEGMENTS * CC_MSS; i++) {
+		cc_send_window(ctx);
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	zassert_true(conn->ca.cwnd >= CC_PACED_SEGMENTS * CC_MSS, "Window did not grow (%u)",
+		     conn->ca.cwnd);
+	zassert_true(conn->ca.cwnd >= conn->ca.ssthresh, "Not in congestion avoidance");
+	zassert_true(conn->ca.srtt_ms >= rtt_ms, "Invalid RTT %u", conn->ca.srtt_ms);
+	rate = (uint64_t)conn->ca.cwnd * MSEC_PER_SEC / conn->ca.srtt_ms * 6 / 5;
+	k_mutex_unlock(&conn->lock);
+
+	gap_us = CC_MSS * USEC_PER_SEC / rate;
+
+	/* Time stamp the segments of the window from the first one */
+	key = k_spin_lock(&cc_lock);
+	cc_sent_cnt = 0;
+	k_spin_unlock(&cc_lock, key);
+
+	start = conn->seq - cc_data_seq;
+	cc_queue(ctx, CC_PACED_SEGMENTS * CC_MSS);
+	cc_wait_sent(start + CC_PACED_SEGMENTS * CC_MSS, __LINE__);
+
+	/* The schedule may lag one tick behind, and each timestamp is off
+	 * by up to one tick.
+	 */
+	span_us = cc_sent_us[CC_PACED_SEGMENTS - 1] - cc_sent_us[0];
+	zassert_true(span_us + 2 * (int64_t)k_ticks_to_us_ceil64(1) >=
+		     (CC_PACED_SEGMENTS - 1) * gap_us,
+		     "Segments sent within %lld us, expected a gap of %lld us",
+		     (long long)span_us, (long long)gap_us);
+
+	cc_wait_acked(conn, start + CC_PACED_SEGMENTS * CC_MSS, __LINE__);
+	zassert_equal(cc_resent_cnt, 0, "Unexpected retransmission");
+
+	cc_close(ctx);
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -0,0 +1,349 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
+
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp.h"
+
+#define TEST_MSS      1000
+#define TEST_SEQ      0xfffffc00U /* wraps around within the packet */
+#define TEST_DATA_LEN (3 * TEST_MSS + 123)
+#define TEST_IPV4_ID  0xfffeU /* wraps around within the packet */
+#define MAX_FRAMES    8
+#define FRAME_LEN     (sizeof(struct net_eth_hdr) + NET_IPV6TCPH_LEN + TEST_DATA_LEN)
+
+#define TCP_FIN 0x01
+#define TCP_PSH 0x08
+#define TCP_ACK 0x10
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 1, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 1, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+static struct in_addr my_addr4 = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr4 = { { { 192, 0, 2, 2 } } };
+static uint8_t peer_mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x02 };
+
+static uint8_t test_data[TEST_DATA_LEN];
+
+struct eth_context {
+	uint8_t mac_addr[6];
+};
+
+static struct eth_context eth_ctx;
+static struct net_if *eth_iface;
+static bool hw_tso;
+
+static uint8_t frames[MAX_FRAMES][FRAME_LEN];
+static size_t frame_len[MAX_FRAMES];
+static uint16_t frame_gso_size[MAX_FRAMES];
+static int frame_count;
+
+static void eth_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->data;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	eth_iface = iface;
+
+	ethernet_init(iface);
+}
+
+static int eth_tx(const struct device *dev, struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+
+	zassert_true(frame_count < MAX_FRAMES, "Too many frames");
+	zassert_true(len <= FRAME_LEN, "Frame too long (%zu)", len);
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_read(pkt, frames[frame_count], len), "Cannot read frame");
+
+	frame_len[frame_count] = len;
+	frame_gso_size[frame_count] = net_pkt_gso_size(pkt);
+	frame_count++;
+
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_get_capabilities(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return hw_tso ? ETHERNET_HW_TSO : 0;
+}
+
+static int eth_init(const struct device *dev)
+{
+	struct eth_context *context = dev->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[0] = 0x00;
+	context->mac_addr[1] = 0x00;
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[3] = 0x00;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = sys_rand8_get();
+
+	return 0;
+}
+
+static struct ethernet_api eth_api = {
+	.iface_api.init = eth_iface_init,
+
+	.get_capabilities = eth_get_capabilities,
+	.send = eth_tx,
+};
+
+ETH_NET_DEVICE_INIT(eth_gso_test, "eth_gso_test", eth_init, NULL,
+		    &eth_ctx, NULL, CONFIG_ETH_INIT_PRIORITY, &eth_api,
+		    NET_ETH_MTU);
+
+/* Build a TCP packet carrying the whole test data, to be segmented */
+static struct net_pkt *create_gso_pkt(sa_family_t family, uint8_t flags)
+{
+	struct net_tcp_hdr tcp_hdr = {
+		.src_port = htons(4242),
+		.dst_port = htons(80),
+		.offset = (NET_TCPH_LEN / 4) << 4,
+		.flags = flags,
+	};
+	struct net_pkt *pkt;
+
+	sys_put_be32(TEST_SEQ, tcp_hdr.seq);
+	sys_put_be32(1, tcp_hdr.ack);
+	sys_put_be16(8192, tcp_hdr.wnd);
+
+	pkt = net_pkt_alloc_with_buffer(eth_iface, NET_TCPH_LEN + TEST_DATA_LEN,
+					family, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	if (family == AF_INET) {
+		zassert_ok(net_ipv4_create_full(pkt, &my_addr4, &peer_addr4, 0U,
+						TEST_IPV4_ID, 0U, 0U));
+	} else {
+		zassert_ok(net_ipv6_create(pkt, &my_addr, &peer_addr));
+	}
+
+	zassert_ok(net_pkt_write(pkt, &tcp_hdr, sizeof(tcp_hdr)));
+	zassert_ok(net_pkt_write(pkt, test_data, sizeof(test_data)));
+
+	net_pkt_set_gso_size(pkt, TEST_MSS);
+	net_pkt_cursor_init(pkt);
+
+	if (family == AF_INET) {
+		zassert_ok(net_ipv4_finalize(pkt, IPPROTO_TCP));
+	} else {
+		zassert_ok(net_ipv6_finalize(pkt, IPPROTO_TCP));
+	}
+
+	zassert_ok(net_linkaddr_set(net_pkt_lladdr_src(pkt),
+				    net_if_get_link_addr(eth_iface)->addr,
+				    sizeof(struct net_eth_addr)));
+	zassert_ok(net_linkaddr_set(net_pkt_lladdr_dst(pkt), peer_mac,
+				    sizeof(peer_mac)));
+
+	return pkt;
+}
+
+static int send_pkt(struct net_pkt *pkt)
+{
+	int ret;
+
+	frame_count = 0;
+
+	ret = net_if_l2(eth_iface)->send(eth_iface, pkt);
+	if (ret < 0) {
+		net_pkt_unref(pkt);
+	}
+
+	return ret;
+}
+
+static uint32_t chksum_add(uint32_t sum, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i + 1 < len; i += 2) {
+		sum += sys_get_be16(&data[i]);
+	}
+
+	if (len % 2) {
+		sum += data[len - 1] << 8;
+	}
+
+	return sum;
+}
+
+static bool chksum_ok(uint32_t sum)
+{
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum == 0xffff;
+}
+
+/* Verify a TCP checksum over the IPv4 or IPv6 pseudo header */
+static bool tcp_chksum_ok(sa_family_t family, const uint8_t *ip, size_t tcp_len)
+{
+	uint32_t sum;
+
+	if (family == AF_INET) {
+		const struct net_ipv4_hdr *hdr = (const struct net_ipv4_hdr *)ip;
+
+		sum = chksum_add(0, hdr->src, 2 * sizeof(struct in_addr));
+		sum += tcp_len + IPPROTO_TCP;
+		sum = chksum_add(sum, ip + NET_IPV4H_LEN, tcp_len);
+	} else {
+		const struct net_ipv6_hdr *hdr = (const struct net_ipv6_hdr *)ip;
+
+		sum = chksum_add(0, hdr->src, 2 * sizeof(struct in6_addr));
+		sum += tcp_len + IPPROTO_TCP;
+		sum = chksum_add(sum, ip + NET_IPV6H_LEN, tcp_len);
+	}
+
+	return chksum_ok(sum);
+}
+
+/* Verify the IPv4 header of segment i */
+static void verify_ipv4_hdr(int i, const uint8_t *ip, size_t tcp_len)
+{
+	const struct net_ipv4_hdr *hdr = (const struct net_ipv4_hdr *)ip;
+
+	zassert_equal(ntohs(hdr->len), NET_IPV4H_LEN + tcp_len,
+		      "Frame %d total length", i);
+	zassert_equal(sys_get_be16(hdr->id), (uint16_t)(TEST_IPV4_ID + i),
+		      "Frame %d IP ID 0x%04x", i, sys_get_be16(hdr->id));
+	zassert_true(chksum_ok(chksum_add(0, ip, NET_IPV4H_LEN)),
+		     "Frame %d IP header checksum", i);
+}
+
+static void verify_segments(sa_family_t family, uint8_t flags)
+{
+	size_t ip_len = family == AF_INET ? NET_IPV4H_LEN : NET_IPV6H_LEN;
+	size_t offset = 0;
+
+	zassert_equal(frame_count, DIV_ROUND_UP(TEST_DATA_LEN, TEST_MSS),
+		      "Unexpected number of frames (%d)", frame_count);
+
+	for (int i = 0; i < frame_count; i++) {
+		const uint8_t *ip = frames[i] + sizeof(struct net_eth_hdr);
+		const struct net_tcp_hdr *tcp_hdr =
+			(const struct net_tcp_hdr *)(ip + ip_len);
+		size_t len = MIN(TEST_MSS, TEST_DATA_LEN - offset);
+		bool last = (i == frame_count - 1);
+
+		zassert_equal(frame_len[i], sizeof(struct net_eth_hdr) +
+			      ip_len + NET_TCPH_LEN + len, "Frame %d length", i);
+		zassert_equal(frame_gso_size[i], 0, "Frame %d is not a segment", i);
+		zassert_mem_equal(((const struct net_eth_hdr *)frames[i])->dst.addr,
+				  peer_mac, sizeof(peer_mac), "Frame %d dst", i);
+
+		if (family == AF_INET) {
+			verify_ipv4_hdr(i, ip, NET_TCPH_LEN + len);
+		} else {
+			const struct net_ipv6_hdr *ip_hdr = (const struct net_ipv6_hdr *)ip;
+
+			zassert_equal(ntohs(ip_hdr->len), NET_TCPH_LEN + len,
+				      "Frame %d payload length", i);
+		}
+
+		zassert_equal(sys_get_be32(tcp_hdr->seq), (uint32_t)(TEST_SEQ + offset),
+			      "Frame %d sequence number", i);
+		zassert_equal(tcp_hdr->flags,
+			      last ? flags : (flags & ~(TCP_PSH | TCP_FIN)),
+			      "Frame %d flags 0x%02x", i, tcp_hdr->flags);
+		zassert_true(tcp_chksum_ok(family, ip, NET_TCPH_LEN + len),
+			     "Frame %d checksum", i);
+		zassert_mem_equal(ip + ip_len + NET_TCPH_LEN, &test_data[offset], len,
+				  "Frame %d data", i);
+
+		offset += len;
+	}
+}
+
+ZTEST(net_tcp_gso, test_segmentation)
+{
+	uint8_t flags = TCP_PSH | TCP_ACK;
+	int ret;
+
+	hw_tso = false;
+
+	ret = send_pkt(create_gso_pkt(AF_INET6, flags));
+	zassert_true(ret > 0, "Cannot send pkt (%d)", ret);
+
+	verify_segments(AF_INET6, flags);
+}
+
+ZTEST(net_tcp_gso, test_segmentation_fin)
+{
+	uint8_t flags = TCP_PSH | TCP_ACK | TCP_FIN;
+	int ret;
+
+	hw_tso = false;
+
+	ret = send_pkt(create_gso_pkt(AF_INET6, flags));
+	zassert_true(ret > 0, "Cannot send pkt (%d)", ret);
+
+	verify_segments(AF_INET6, flags);
+}
+
+ZTEST(net_tcp_gso, test_segmentation_ipv4)
+{
+	uint8_t flags = TCP_PSH | TCP_ACK;
+	int ret;
+
+	hw_tso = false;
+
+	ret = send_pkt(create_gso_pkt(AF_INET, flags));
+	zassert_true(ret > 0, "Cannot send pkt (%d)", ret);
+
+	verify_segments(AF_INET, flags);
+}
+
+ZTEST(net_tcp_gso, test_hw_tso)
+{
+	int ret;
+
+	hw_tso = true;
+
+	ret = send_pkt(create_gso_pkt(AF_INET6, TCP_PSH | TCP_ACK));
+	zassert_true(ret > 0, "Cannot send pkt (%d)", ret);
+
+	zassert_equal(frame_count, 1, "The driver should get a single frame");
+	zassert_equal(frame_len[0], FRAME_LEN, "Frame length");
+	zassert_equal(frame_gso_size[0], TEST_MSS, "GSO size not passed to the driver");
+	zassert_mem_equal(frames[0] + sizeof(struct net_eth_hdr) + NET_IPV6TCPH_LEN,
+			  test_data, TEST_DATA_LEN, "Frame data");
+}
+
+static void *setup(void)
+{
+	for (int i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = i;
+	}
+
+	zassert_not_null(eth_iface, "No test interface");
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_tcp_gso, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,104 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure TCP throughput over a loopback link with a simulated delay.
+ * Without window scaling a connection can have at most 64 KiB in
+ * flight, which caps the throughput at 64 KiB per round trip no matter
+ * how large the buffers are.  With window scaling the limit is the
+ * configured window instead.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/loopback.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/zperf.h>
+
+#define SERVER_PORT  5001
+#define DELAY_MS     20
+#define RTT_MS       (2 * DELAY_MS)
+#define DURATION_MS  5000
+#define PACKET_SIZE  1024
+
+/* Upper bound of the throughput of an unscaled connection, bytes/s */
+#define UNSCALED_LIMIT ((uint64_t)UINT16_MAX * MSEC_PER_SEC / RTT_MS)
+
+static K_SEM_DEFINE(server_done, 0, 1);
+static struct zperf_results server_results;
+
+static void server_cb(enum zperf_status status, struct zperf_results *result,
+		      void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (status == ZPERF_SESSION_FINISHED) {
+		server_results = *result;
+		k_sem_give(&server_done);
+	}
+}
+
+static uint64_t throughput(uint64_t bytes, uint64_t time_in_us)
+{
+	zassert_not_equal(time_in_us, 0, "no time elapsed");
+
+	return bytes * USEC_PER_SEC / time_in_us;
+}
+
+ZTEST(tcp_window_scale, test_throughput)
+{
+	struct zperf_download_params download = {
+		.port = SERVER_PORT,
+		.addr.sa_family = AF_INET,
+	};
+	struct zperf_upload_params upload = {
+		.duration_ms = DURATION_MS,
+		.packet_size = PACKET_SIZE,
+	};
+	struct sockaddr_in *peer = (struct sockaddr_in *)&upload.peer_addr;
+	struct zperf_results results = { 0 };
+	uint64_t rate;
+	int ret;
+
+	ret = zperf_tcp_download(&download, server_cb, NULL);
+	zassert_ok(ret, "cannot start zperf server (%d)", ret);
+
+	peer->sin_family = AF_INET;
+	peer->sin_port = htons(SERVER_PORT);
+	ret = zsock_inet_pton(AF_INET, "127.0.0.1", &peer->sin_addr);
+	zassert_equal(ret, 1, "cannot parse peer address");
+
+	zassert_ok(loopback_set_delay(DELAY_MS), "cannot set loopback delay");
+
+	ret = zperf_tcp_upload(&upload, &results);
+	zassert_ok(ret, "upload failed (%d)", ret);
+
+	zassert_ok(k_sem_take(&server_done, K_SECONDS(10)),
+		   "server did not see the end of the session");
+
+	zassert_ok(loopback_set_delay(0));
+	zassert_ok(zperf_tcp_download_stop());
+
+	rate = throughput(server_results.total_len, server_results.time_in_us);
+
+	TC_PRINT("RTT %u ms, window limit %llu B/s, received %llu B in %llu us: %llu B/s\n",
+		 RTT_MS, UNSCALED_LIMIT, server_results.total_len,
+		 server_results.time_in_us, rate);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE)) {
+		/* The bandwidth-delay product is twice the unscaled window,
+		 * leave some margin for the handshake and the first RTTs.
+		 */
+		zassert_true(rate > UNSCALED_LIMIT * 5 / 4,
+			     "window scaling did not raise throughput above %llu B/s",
+			     UNSCALED_LIMIT);
+	} else {
+		zassert_true(rate <= UNSCALED_LIMIT * 11 / 10,
+			     "unscaled throughput above the 64 KiB window limit");
+	}
+}
+
+ZTEST_SUITE(tcp_window_scale, NULL, NULL, NULL, NULL, NULL);